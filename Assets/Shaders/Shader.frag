@@ -42,14 +42,16 @@ void main()
     const vec3 halfDir = normalize(normalize(fragInViewDir) + lightDir.xyz);
     const vec4 diffuleColor = texture(sampler2D(diffuseImage, imageSampler), fragInUV);
     const vec3 emissiveColor = texture(sampler2D(emissiveImage, imageSampler), fragInUV).xyz;
-    const vec3 normalColor = texture(sampler2D(normalImage, imageSampler), fragInUV).xyz;
+    const vec2 normalColor = texture(sampler2D(normalImage, imageSampler), fragInUV).xy;
     
     // Normal map
     const mat3 tangentToLocal = mat3(
         normalize(fragInTangent), 
         normalize(fragInBinormal),
         normalize(fragInNormal));
-    const vec3 normalTangentSpace = normalize(normalColor * 2.0f - 1.0f);
+    // Only XY are stored (BC5), Z is reconstructed knowing the normal points out of the surface.
+    const vec2 normalTangentSpaceXY = normalColor * 2.0f - 1.0f;
+    const vec3 normalTangentSpace = vec3(normalTangentSpaceXY, sqrt(saturate(1.0 - dot(normalTangentSpaceXY, normalTangentSpaceXY))));
     vec3 normal = tangentToLocal * normalTangentSpace;
     normal = normalize(mat3(worldBuffer.inverseTransposeWorldMatrix) * normal);
     
@@ -0,0 +1,50 @@
+#version 450 // Use GLSL 4.5
+
+// Vertex Inputs (VertexCompact)
+layout(location = 0) in vec4 vertexInPosition; // Normalized [0,1] within the mesh bounds
+layout(location = 1) in vec4 vertexInQTangent; // Tangent frame quaternion, sign of w is the binormal handedness
+layout(location = 2) in vec2 vertexInUV;
+
+// Vertex Outputs
+layout(location = 0) out vec2 vertexOutUV;
+layout(location = 1) out vec3 vertexOutNormal;
+layout(location = 2) out vec3 vertexOutTangent;
+layout(location = 3) out vec3 vertexOutBinormal;
+layout(location = 4) out vec3 vertexOutViewDir;
+
+layout(set = 0, binding = 0) uniform ViewProjBuffer
+{
+    mat4 viewMatrix;
+    mat4 projMatrix;
+    vec4 camPos;
+} viewProjBuffer;
+
+// The world matrix includes the transformation from the
+// normalized positions to the mesh bounds.
+layout(push_constant) uniform WorldBuffer
+{
+    mat4 worldMatrix;
+    mat4 inverseTransposeWorldMatrix;
+} worldBuffer;
+
+void main()
+{
+    gl_Position = worldBuffer.worldMatrix * vec4(vertexInPosition.xyz, 1.0);
+    vertexOutViewDir = viewProjBuffer.camPos.xyz - gl_Position.xyz;
+    gl_Position = viewProjBuffer.projMatrix * viewProjBuffer.viewMatrix * gl_Position;
+
+    // Tangent frame from quaternion
+    const vec4 q = normalize(vertexInQTangent);
+    const float handedness = (vertexInQTangent.w < 0.0) ? -1.0 : 1.0;
+    vertexOutTangent = vec3(
+        1.0 - 2.0 * (q.y * q.y + q.z * q.z),
+        2.0 * (q.x * q.y + q.w * q.z),
+        2.0 * (q.x * q.z - q.w * q.y));
+    vertexOutNormal = vec3(
+        2.0 * (q.x * q.z + q.w * q.y),
+        2.0 * (q.y * q.z - q.w * q.x),
+        1.0 - 2.0 * (q.x * q.x + q.y * q.y));
+    vertexOutBinormal = cross(vertexOutNormal, vertexOutTangent) * handedness;
+
+    vertexOutUV = vertexInUV;
+}
@@ -0,0 +1,347 @@
+#include <AssetCooker.h>
+#include <CookDatabase.h>
+
+#include <Assets/AssetManager.h>
+#include <Assets/AssetManifest.h>
+#include <Assets/GltfLoader.h>
+#include <Assets/MeshAsset.h>
+#include <Assets/MeshCache.h>
+#include <Assets/TextureAsset.h>
+#include <Assets/TextureCache.h>
+#include <File/FileUtils.h>
+#include <Log/Log.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr std::array MeshExtensions = { ".fbx", ".gltf", ".glb" };
+        static constexpr std::array TextureExtensions = { ".png", ".jpg", ".jpeg", ".tga", ".bmp" };
+        static constexpr std::array ShaderExtensions = { ".vert", ".frag", ".comp" };
+
+#ifdef _WIN32
+        static constexpr const char* ShaderCompilerExecutable = "glslangValidator.exe";
+#else
+        static constexpr const char* ShaderCompilerExecutable = "glslangValidator";
+#endif
+
+        struct CookItem
+        {
+            std::string m_fileName; // Relative to the assets folder
+            CookAssetKind m_kind = CookAssetKind::Mesh;
+            uint32_t m_settingsFlags = 0;
+        };
+
+        enum class CookResult
+        {
+            UpToDate,
+            Cooked,
+            Failed
+        };
+
+        template<size_t Size>
+        bool HasExtension(const std::filesystem::path& filePath, const std::array<const char*, Size>& extensions)
+        {
+            const std::string extension = filePath.extension().generic_string();
+            for (const char* candidate : extensions)
+            {
+                if (extension == candidate)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::optional<CookAssetKind> GetCookAssetKind(const std::filesystem::path& filePath)
+        {
+            if (HasExtension(filePath, MeshExtensions)) return CookAssetKind::Mesh;
+            if (HasExtension(filePath, TextureExtensions)) return CookAssetKind::Texture;
+            if (HasExtension(filePath, ShaderExtensions)) return CookAssetKind::Shader;
+            return std::nullopt;
+        }
+
+        // Compiled shaders are stored next to their source, where pipelines load them from.
+        std::filesystem::path GetCookOutputPath(const CookItem& item)
+        {
+            const auto sourcePath = GetAssetPath() / item.m_fileName;
+            switch (item.m_kind)
+            {
+            case CookAssetKind::Mesh:
+                return GetCookedMeshPath(sourcePath);
+            case CookAssetKind::Texture:
+                return GetCookedTexturePath(sourcePath);
+            case CookAssetKind::Shader:
+            default:
+            {
+                auto outputPath = sourcePath;
+                outputPath += ".spv";
+                return outputPath;
+            }
+            }
+        }
+
+        // Files the cooked asset is generated from, starting with the source file.
+        std::vector<std::string> GetCookDependencies(const CookItem& item)
+        {
+            std::vector<std::string> dependencies = { item.m_fileName };
+            if (item.m_kind == CookAssetKind::Mesh && IsGltfFile(item.m_fileName))
+            {
+                for (const auto& bufferPath : GetGltfBufferPaths(item.m_fileName))
+                {
+                    dependencies.push_back(bufferPath.lexically_normal().generic_string());
+                }
+            }
+            return dependencies;
+        }
+
+        bool IsUpToDate(const CookItem& item, const CookRecord& newRecord, const CookRecord* oldRecord)
+        {
+            if (!oldRecord ||
+                oldRecord->m_kind != item.m_kind ||
+                oldRecord->m_settingsFlags != item.m_settingsFlags ||
+                oldRecord->m_dependencies.size() != newRecord.m_dependencies.size())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < newRecord.m_dependencies.size(); ++i)
+            {
+                if (oldRecord->m_dependencies[i].m_fileName != newRecord.m_dependencies[i].m_fileName ||
+                    oldRecord->m_dependencies[i].m_hash != newRecord.m_dependencies[i].m_hash)
+                {
+                    return false;
+                }
+            }
+
+            // The cooked file could have been deleted since.
+            return std::filesystem::exists(GetCookOutputPath(item));
+        }
+
+        // Uses the compiler of the Vulkan SDK when available, otherwise it's expected to be in the PATH.
+        std::string FindShaderCompiler()
+        {
+#ifdef _WIN32
+            char* vulkanSdkPath = nullptr;
+            size_t vulkanSdkPathSize = 0;
+            std::string vulkanSdk;
+            if (_dupenv_s(&vulkanSdkPath, &vulkanSdkPathSize, "VULKAN_SDK") == 0 && vulkanSdkPath)
+            {
+                vulkanSdk = vulkanSdkPath;
+                free(vulkanSdkPath);
+            }
+#else
+            const char* vulkanSdkPath = std::getenv("VULKAN_SDK");
+            const std::string vulkanSdk = vulkanSdkPath ? vulkanSdkPath : "";
+#endif
+
+            if (!vulkanSdk.empty())
+            {
+                for (const char* binFolder : { "Bin", "bin" })
+                {
+                    const auto compilerPath = std::filesystem::path(vulkanSdk) / binFolder / ShaderCompilerExecutable;
+                    if (std::filesystem::exists(compilerPath))
+                    {
+                        return compilerPath.generic_string();
+                    }
+                }
+            }
+            return ShaderCompilerExecutable;
+        }
+
+        bool CompileShader(const std::string& compiler, const CookItem& item)
+        {
+            const auto sourcePath = GetAssetPath() / item.m_fileName;
+            const auto outputPath = GetCookOutputPath(item);
+
+            std::string command = "\"" + compiler + "\" -V \"" + sourcePath.generic_string() +
+                "\" -o \"" + outputPath.generic_string() + "\"";
+#ifdef _WIN32
+            // cmd.exe strips the outer quotes when the command starts with one.
+            command = "\"" + command + "\"";
+#endif
+
+            if (const int exitCode = std::system(command.c_str());
+                exitCode != 0)
+            {
+                DX_LOG(Error, "AssetCooker", "Failed to compile shader %s (exit code %d).", item.m_fileName.c_str(), exitCode);
+                return false;
+            }
+            return true;
+        }
+
+        CookResult CookItemIfNeeded(const CookItem& item, const CookRecord* oldRecord, const std::string& shaderCompiler, CookRecord& newRecord,
+            ThreadPool* threadPool)
+        {
+            newRecord.m_kind = item.m_kind;
+            newRecord.m_settingsFlags = item.m_settingsFlags;
+
+            for (const std::string& dependency : GetCookDependencies(item))
+            {
+                auto file = OpenAssetFile(dependency);
+                if (!file)
+                {
+                    DX_LOG(Error, "AssetCooker", "File %s needed by %s not found.", dependency.c_str(), item.m_fileName.c_str());
+                    return CookResult::Failed;
+                }
+                newRecord.m_dependencies.push_back({ dependency, HashBytes(file->GetData().data(), file->GetData().size()) });
+            }
+
+            if (IsUpToDate(item, newRecord, oldRecord))
+            {
+                return CookResult::UpToDate;
+            }
+
+            bool cooked = false;
+            switch (item.m_kind)
+            {
+            case CookAssetKind::Mesh:
+                cooked = MeshAsset::CookMeshAsset(item.m_fileName, MeshImportSettings::FromFlags(item.m_settingsFlags), threadPool);
+                break;
+            case CookAssetKind::Texture:
+                cooked = TextureAsset::CookTextureAsset(item.m_fileName, TextureImportSettings::FromFlags(item.m_settingsFlags), threadPool);
+                break;
+            case CookAssetKind::Shader:
+                cooked = CompileShader(shaderCompiler, item);
+                break;
+            }
+
+            // Importers log the reason when they fail, but they don't fail when the
+            // cooked file can't be written, which would make the asset be cooked every time.
+            if (cooked && !std::filesystem::exists(GetCookOutputPath(item)))
+            {
+                DX_LOG(Error, "AssetCooker", "Cooked file for %s was not written.", item.m_fileName.c_str());
+                cooked = false;
+            }
+
+            return cooked ? CookResult::Cooked : CookResult::Failed;
+        }
+
+        // Import settings each asset was loaded with in the last session.
+        std::unordered_map<std::string, uint32_t> GetManifestSettings(AssetType assetType)
+        {
+            std::unordered_map<std::string, uint32_t> settings;
+            if (const auto manifest = LoadAssetManifest(GetAssetManifestPath()))
+            {
+                for (const AssetManifestEntry& entry : *manifest)
+                {
+                    if (entry.m_assetType == assetType)
+                    {
+                        settings[entry.m_assetId] = entry.m_loadFlags;
+                    }
+                }
+            }
+            return settings;
+        }
+    } // namespace Internal
+
+    AssetCookerStats AssetCooker::CookAssets(bool force)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        const auto assetPath = GetAssetPath();
+
+        const auto meshSettings = Internal::GetManifestSettings(MeshAsset::AssetTypeId);
+        const auto textureSettings = Internal::GetManifestSettings(TextureAsset::AssetTypeId);
+
+        std::vector<Internal::CookItem> items;
+        std::error_code errorCode;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(assetPath, errorCode))
+        {
+            if (!entry.is_regular_file())
+            {
+                continue;
+            }
+
+            const auto kind = Internal::GetCookAssetKind(entry.path());
+            if (!kind.has_value())
+            {
+                continue;
+            }
+
+            Internal::CookItem& item = items.emplace_back();
+            item.m_fileName = entry.path().lexically_relative(assetPath).generic_string();
+            item.m_kind = *kind;
+
+            if (item.m_kind == CookAssetKind::Mesh)
+            {
+                auto it = meshSettings.find(item.m_fileName);
+                item.m_settingsFlags = (it != meshSettings.end()) ? it->second : MeshImportSettings().ToFlags();
+            }
+            else if (item.m_kind == CookAssetKind::Texture)
+            {
+                auto it = textureSettings.find(item.m_fileName);
+                item.m_settingsFlags = (it != textureSettings.end()) ? it->second : TextureImportSettings().ToFlags();
+            }
+        }
+
+        if (errorCode)
+        {
+            DX_LOG(Error, "AssetCooker", "Failed to list assets folder %s.", assetPath.generic_string().c_str());
+            return { .m_failedCount = 1 };
+        }
+
+        const auto databasePath = CookDatabase::GetDefaultPath();
+        CookDatabase database;
+        if (!force)
+        {
+            database.Load(databasePath);
+        }
+
+        const std::string shaderCompiler = Internal::FindShaderCompiler();
+
+        // The database is only read while cooking, records are updated at the end.
+        std::vector<Internal::CookResult> results(items.size(), Internal::CookResult::Failed);
+        std::vector<CookRecord> records(items.size());
+
+        ThreadPool& threadPool = AssetManager::Get().GetThreadPool();
+        threadPool.ParallelFor(static_cast<uint32_t>(items.size()), [&](uint32_t index)
+            {
+                results[index] = Internal::CookItemIfNeeded(
+                    items[index], database.Find(items[index].m_fileName), shaderCompiler, records[index], &threadPool);
+            });
+
+        AssetCookerStats stats;
+        std::unordered_set<std::string> cookedFileNames;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            switch (results[i])
+            {
+            case Internal::CookResult::UpToDate:
+                ++stats.m_upToDateCount;
+                break;
+            case Internal::CookResult::Cooked:
+                ++stats.m_cookedCount;
+                database.Update(items[i].m_fileName, std::move(records[i]));
+                break;
+            case Internal::CookResult::Failed:
+                ++stats.m_failedCount;
+                database.Remove(items[i].m_fileName);
+                break;
+            }
+            cookedFileNames.insert(items[i].m_fileName);
+        }
+
+        // Forget assets deleted from the assets folder.
+        database.RemoveAllExcept(cookedFileNames);
+
+        database.Save(databasePath);
+
+        [[maybe_unused]] const float cookTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        DX_LOG(Info, "AssetCooker", "Cooked %u assets in %.2f ms using %u threads (%u up to date, %u failed).",
+            stats.m_cookedCount, cookTimeMs, threadPool.GetThreadCount() + 1, stats.m_upToDateCount, stats.m_failedCount);
+
+        return stats;
+    }
+} // namespace DX
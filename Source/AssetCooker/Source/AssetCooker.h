@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace DX
+{
+    struct AssetCookerStats
+    {
+        uint32_t m_cookedCount = 0;
+        uint32_t m_upToDateCount = 0;
+        uint32_t m_failedCount = 0;
+    };
+
+    // Cooks the assets folder offline: meshes and textures are imported into the
+    // cooked formats of the cache folder and shaders are compiled to SPIR-V.
+    //
+    // Assets are cooked in parallel using all cores. Cooking is incremental, the
+    // content hashes of the files each asset was cooked from are stored in a database
+    // and only assets whose files or import settings changed are cooked again.
+    //
+    // Meshes and textures are cooked with the import settings recorded in the asset
+    // load manifest of the last session, assets not in the manifest use the default settings.
+    // It doesn't use the GPU.
+    class AssetCooker
+    {
+    public:
+        // When forced all assets are cooked, ignoring the database.
+        AssetCookerStats CookAssets(bool force);
+    };
+} // namespace DX
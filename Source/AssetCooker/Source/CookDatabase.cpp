@@ -0,0 +1,218 @@
+#include <CookDatabase.h>
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Log/Log.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t CookDatabaseMagic = 0x44435844; // 'DXCD'
+
+        // Increment every time the layout of the database or any cooked format changes,
+        // so all assets are cooked again.
+        static constexpr uint32_t CookDatabaseVersion = 2;
+
+        static constexpr const char* CookDatabaseFileName = "AssetCooker.db";
+
+        // Cook database file layout:
+        //   CookDatabaseHeader
+        //   Records one after the other, each one is a CookDatabaseRecord followed by the
+        //   source file name and its dependencies. Each dependency is a CookDatabaseDependency
+        //   followed by the dependency file name.
+        struct CookDatabaseHeader
+        {
+            uint32_t m_magic;
+            uint32_t m_version;
+            uint32_t m_recordCount;
+        };
+
+        struct CookDatabaseRecord
+        {
+            uint32_t m_kind;
+            uint32_t m_settingsFlags;
+            uint32_t m_dependencyCount;
+            uint32_t m_fileNameSize;
+        };
+
+        struct CookDatabaseDependency
+        {
+            HashValue m_hash;
+            uint32_t m_fileNameSize;
+            uint32_t m_padding;
+        };
+
+        // Reads a struct followed by a string of the size it indicates.
+        template<typename T>
+        bool ReadCookDatabaseEntry(const MappedFile& file, size_t& offset, T& entry, std::string& fileName)
+        {
+            if (offset + sizeof(entry) > file.GetSize())
+            {
+                return false;
+            }
+            std::memcpy(&entry, file.GetData() + offset, sizeof(entry));
+            offset += sizeof(entry);
+
+            if (entry.m_fileNameSize == 0 || offset + entry.m_fileNameSize > file.GetSize())
+            {
+                return false;
+            }
+            fileName.assign(reinterpret_cast<const char*>(file.GetData() + offset), entry.m_fileNameSize);
+            offset += entry.m_fileNameSize;
+            return true;
+        }
+    } // namespace Internal
+
+    std::filesystem::path CookDatabase::GetDefaultPath()
+    {
+        return GetAssetCachePath() / Internal::CookDatabaseFileName;
+    }
+
+    void CookDatabase::Load(const std::filesystem::path& databasePath)
+    {
+        m_records.clear();
+
+        if (!std::filesystem::exists(databasePath))
+        {
+            return;
+        }
+
+        MappedFile databaseFile;
+        if (!databaseFile.Open(databasePath))
+        {
+            return;
+        }
+
+        Internal::CookDatabaseHeader header;
+        if (databaseFile.GetSize() < sizeof(header))
+        {
+            DX_LOG(Warning, "CookDatabase", "Cook database %s is corrupted.", databasePath.generic_string().c_str());
+            return;
+        }
+        std::memcpy(&header, databaseFile.GetData(), sizeof(header));
+
+        if (header.m_magic != Internal::CookDatabaseMagic ||
+            header.m_version != Internal::CookDatabaseVersion)
+        {
+            DX_LOG(Info, "CookDatabase", "Cook database %s is from a different version, all assets will be cooked.",
+                databasePath.generic_string().c_str());
+            return;
+        }
+
+        size_t offset = sizeof(header);
+        for (uint32_t recordIndex = 0; recordIndex < header.m_recordCount; ++recordIndex)
+        {
+            Internal::CookDatabaseRecord databaseRecord;
+            std::string sourceFileName;
+            if (!Internal::ReadCookDatabaseEntry(databaseFile, offset, databaseRecord, sourceFileName))
+            {
+                DX_LOG(Warning, "CookDatabase", "Cook database %s is corrupted.", databasePath.generic_string().c_str());
+                m_records.clear();
+                return;
+            }
+
+            CookRecord record;
+            record.m_kind = static_cast<CookAssetKind>(databaseRecord.m_kind);
+            record.m_settingsFlags = databaseRecord.m_settingsFlags;
+            record.m_dependencies.resize(databaseRecord.m_dependencyCount);
+
+            for (CookDependency& dependency : record.m_dependencies)
+            {
+                Internal::CookDatabaseDependency databaseDependency;
+                if (!Internal::ReadCookDatabaseEntry(databaseFile, offset, databaseDependency, dependency.m_fileName))
+                {
+                    DX_LOG(Warning, "CookDatabase", "Cook database %s is corrupted.", databasePath.generic_string().c_str());
+                    m_records.clear();
+                    return;
+                }
+                dependency.m_hash = databaseDependency.m_hash;
+            }
+
+            m_records[sourceFileName] = std::move(record);
+        }
+    }
+
+    bool CookDatabase::Save(const std::filesystem::path& databasePath) const
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(databasePath.parent_path(), errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "CookDatabase", "Failed to create cache folder %s.", databasePath.parent_path().generic_string().c_str());
+            return false;
+        }
+
+        const Internal::CookDatabaseHeader header =
+        {
+            .m_magic = Internal::CookDatabaseMagic,
+            .m_version = Internal::CookDatabaseVersion,
+            .m_recordCount = static_cast<uint32_t>(m_records.size())
+        };
+
+        // Write into a temporary file and rename it at the end, so an
+        // interrupted cook never leaves a partially written database.
+        const bool written = WriteFileAtomically(databasePath, [&](std::ofstream& file)
+            {
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                for (const auto& [sourceFileName, record] : m_records)
+                {
+                    const Internal::CookDatabaseRecord databaseRecord =
+                    {
+                        .m_kind = static_cast<uint32_t>(record.m_kind),
+                        .m_settingsFlags = record.m_settingsFlags,
+                        .m_dependencyCount = static_cast<uint32_t>(record.m_dependencies.size()),
+                        .m_fileNameSize = static_cast<uint32_t>(sourceFileName.size())
+                    };
+                    file.write(reinterpret_cast<const char*>(&databaseRecord), sizeof(databaseRecord));
+                    file.write(sourceFileName.data(), sourceFileName.size());
+
+                    for (const CookDependency& dependency : record.m_dependencies)
+                    {
+                        const Internal::CookDatabaseDependency databaseDependency =
+                        {
+                            .m_hash = dependency.m_hash,
+                            .m_fileNameSize = static_cast<uint32_t>(dependency.m_fileName.size()),
+                            .m_padding = 0
+                        };
+                        file.write(reinterpret_cast<const char*>(&databaseDependency), sizeof(databaseDependency));
+                        file.write(dependency.m_fileName.data(), dependency.m_fileName.size());
+                    }
+                }
+            });
+        if (!written)
+        {
+            DX_LOG(Error, "CookDatabase", "Failed to save cook database %s.", databasePath.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    const CookRecord* CookDatabase::Find(const std::string& sourceFileName) const
+    {
+        auto it = m_records.find(sourceFileName);
+        return (it != m_records.end()) ? &it->second : nullptr;
+    }
+
+    void CookDatabase::Update(const std::string& sourceFileName, CookRecord record)
+    {
+        m_records[sourceFileName] = std::move(record);
+    }
+
+    void CookDatabase::Remove(const std::string& sourceFileName)
+    {
+        m_records.erase(sourceFileName);
+    }
+
+    void CookDatabase::RemoveAllExcept(const std::unordered_set<std::string>& sourceFileNames)
+    {
+        std::erase_if(m_records, [&sourceFileNames](const auto& record)
+            {
+                return !sourceFileNames.contains(record.first);
+            });
+    }
+} // namespace DX
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Hash/Hash.h>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+
+namespace DX
+{
+    enum class CookAssetKind : uint32_t
+    {
+        Mesh,
+        Texture,
+        Shader
+    };
+
+    // File an asset was cooked from, with the hash of its contents at the time.
+    struct CookDependency
+    {
+        std::string m_fileName; // Relative to the assets folder
+        HashValue m_hash = 0;
+    };
+
+    // How an asset was cooked last time. When the settings and the hashes
+    // of all its dependencies are the same, the cooked asset is up to date.
+    struct CookRecord
+    {
+        CookAssetKind m_kind = CookAssetKind::Mesh;
+        uint32_t m_settingsFlags = 0;
+        std::vector<CookDependency> m_dependencies; // The source file is the first one
+    };
+
+    // Database of the cooked assets, stored in the cache folder between cooks.
+    class CookDatabase
+    {
+    public:
+        // Returns the path of the database inside the cache folder.
+        static std::filesystem::path GetDefaultPath();
+
+        // Reads the database. When the file doesn't exist, it's from a different
+        // version or it's corrupted the database is left empty and everything is cooked.
+        void Load(const std::filesystem::path& databasePath);
+
+        // Writes the database, replacing the existing one.
+        bool Save(const std::filesystem::path& databasePath) const;
+
+        // Returns the record of the source file or null if it was never cooked.
+        const CookRecord* Find(const std::string& sourceFileName) const;
+
+        void Update(const std::string& sourceFileName, CookRecord record);
+        void Remove(const std::string& sourceFileName);
+
+        // Removes the records of all source files not in the set.
+        void RemoveAllExcept(const std::unordered_set<std::string>& sourceFileNames);
+
+    private:
+        std::unordered_map<std::string, CookRecord> m_records;
+    };
+} // namespace DX
@@ -0,0 +1,31 @@
+#include <AssetCooker.h>
+#include <Assets/AssetManager.h>
+#include <Log/Log.h>
+
+#include <string_view>
+
+int main(int argc, char* argv[])
+{
+    bool force = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (const std::string_view argument = argv[i];
+            argument == "--force")
+        {
+            force = true;
+        }
+        else
+        {
+            DX_LOG(Error, "Main", "Unknown argument %s. Usage: AssetCooker [--force]", argv[i]);
+            return 1;
+        }
+    }
+
+    const DX::AssetCookerStats stats = DX::AssetCooker().CookAssets(force);
+
+    DX::AssetManager::Get().Shutdown();
+    DX::AssetManager::Destroy();
+
+    DX_LOG(Info, "Main", "Done!");
+    return (stats.m_failedCount > 0) ? 1 : 0;
+}
@@ -31,6 +31,9 @@ namespace DX
 
         virtual AssetType GetAssetType() const = 0;
 
+        // CPU memory owned by the asset's data.
+        virtual size_t GetDataSizeInBytes() const = 0;
+
     protected:
         AssetBase(AssetId assetId)
             : m_assetId(assetId)
@@ -0,0 +1,422 @@
+#include <Assets/AssetManager.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Set while the manifest is being prefetched, so its loads are not recorded again.
+        static thread_local bool IsPrefetchingManifest = false;
+    }
+
+    AssetManager::AssetManager()
+        : m_creationTime(std::chrono::steady_clock::now())
+    {
+        DX_LOG(Info, "Asset Manager", "Initializing Asset Manager...");
+
+        m_threadPool = std::make_unique<ThreadPool>();
+
+        DX_LOG(Info, "Asset Manager", "Using %u worker threads to load assets.", m_threadPool->GetThreadCount());
+    }
+
+    AssetManager::~AssetManager()
+    {
+        // Finish all asynchronous loads before destroying the assets
+        Shutdown();
+
+#ifndef NDEBUG
+        const auto leakedAssets = std::count_if(m_assets.begin(), m_assets.end(),
+            [](const auto& asset)
+            {
+                return asset.second.m_weakAsset.use_count() > (asset.second.m_asset ? 1 : 0);
+            });
+        if (leakedAssets > 0)
+        {
+            DX_LOG(Warning, "Device", "There are %d assets still referenced at the time of destroying asset manager.", static_cast<int>(leakedAssets));
+        }
+#endif
+
+        m_assets.clear();
+
+        DX_LOG(Info, "Asset Manager", "Terminating Asset Manager...");
+    }
+
+    void AssetManager::Shutdown()
+    {
+        std::unique_ptr<ThreadPool> threadPool;
+        {
+            std::lock_guard lock(m_mutex);
+
+            if (!m_threadPool)
+            {
+                return; // Already shut down
+            }
+
+            m_shuttingDown = true;
+            threadPool = std::move(m_threadPool);
+        }
+
+        DX_LOG(Info, "Asset Manager", "Shutting down Asset Manager...");
+
+        // The workers go through the jobs still queued, which are cancelled
+        // as soon as they start, and then the threads are joined.
+        threadPool.reset();
+    }
+
+    void AssetManager::AddAsset(std::shared_ptr<AssetBase> asset)
+    {
+        std::vector<std::shared_ptr<AssetBase>> evictedAssets;
+
+        std::lock_guard lock(m_mutex);
+
+        const AssetId assetId = asset->GetAssetId();
+        m_assets.emplace(assetId, AssetEntry{ asset, asset, ++m_accessCounter });
+
+        EvictOverBudget(evictedAssets);
+    }
+
+    void AssetManager::RemoveAsset(AssetId assetId)
+    {
+        std::shared_ptr<AssetBase> removedAsset;
+
+        std::lock_guard lock(m_mutex);
+
+        // If there are no other references to the asset it'll be destroyed when removed from map.
+        if (auto it = m_assets.find(assetId);
+            it != m_assets.end())
+        {
+            removedAsset = std::move(it->second.m_asset);
+            m_assets.erase(it);
+        }
+    }
+
+    std::shared_ptr<AssetBase> AssetManager::GetAsset(AssetId assetId)
+    {
+        std::lock_guard lock(m_mutex);
+
+        return FindAsset(assetId);
+    }
+
+    void AssetManager::SetResidencyPolicy(AssetType assetType, AssetResidency residency)
+    {
+        std::vector<std::shared_ptr<AssetBase>> evictedAssets;
+
+        std::lock_guard lock(m_mutex);
+
+        m_residencyPolicies[assetType] = residency;
+
+        EvictOverBudget(evictedAssets);
+    }
+
+    AssetResidency AssetManager::GetResidencyPolicy(AssetType assetType)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto it = m_residencyPolicies.find(assetType);
+        return (it != m_residencyPolicies.end()) ? it->second : AssetResidency::Keep;
+    }
+
+    void AssetManager::SetMemoryBudget(size_t budgetBytes)
+    {
+        std::vector<std::shared_ptr<AssetBase>> evictedAssets;
+
+        std::lock_guard lock(m_mutex);
+
+        m_memoryBudget = budgetBytes;
+
+        EvictOverBudget(evictedAssets);
+    }
+
+    size_t AssetManager::GetMemoryBudget()
+    {
+        std::lock_guard lock(m_mutex);
+
+        return m_memoryBudget;
+    }
+
+    void AssetManager::NotifyAssetUploaded(const AssetId& assetId)
+    {
+        std::shared_ptr<AssetBase> evictedAsset;
+
+        std::lock_guard lock(m_mutex);
+
+        if (auto it = m_assets.find(assetId);
+            it != m_assets.end() && it->second.m_asset)
+        {
+            auto policyIt = m_residencyPolicies.find(it->second.m_asset->GetAssetType());
+            if (policyIt != m_residencyPolicies.end() &&
+                policyIt->second == AssetResidency::DropAfterUpload)
+            {
+                DX_LOG(Verbose, "Asset Manager", "Asset %s uploaded, dropping it.", assetId.c_str());
+                evictedAsset = std::move(it->second.m_asset);
+            }
+        }
+    }
+
+    std::unordered_map<AssetType, AssetResidencyStats> AssetManager::GetResidencyStats()
+    {
+        std::lock_guard lock(m_mutex);
+
+        std::unordered_map<AssetType, AssetResidencyStats> stats;
+        for (const auto& [assetId, entry] : m_assets)
+        {
+            if (auto asset = entry.m_weakAsset.lock())
+            {
+                AssetResidencyStats& typeStats = stats[asset->GetAssetType()];
+                typeStats.m_assetCount++;
+                typeStats.m_residentBytes += asset->GetDataSizeInBytes();
+            }
+        }
+        return stats;
+    }
+
+    void AssetManager::SetPrefetchLoader(AssetType assetType, PrefetchLoadFunc prefetchLoadFunc)
+    {
+        std::lock_guard lock(m_mutex);
+
+        m_prefetchLoaders[assetType] = std::move(prefetchLoadFunc);
+    }
+
+    bool AssetManager::PrefetchManifest(const std::filesystem::path& manifestPath)
+    {
+        const auto manifest = LoadAssetManifest(manifestPath);
+        if (!manifest)
+        {
+            DX_LOG(Info, "Asset Manager", "No asset manifest to prefetch at %s.", manifestPath.generic_string().c_str());
+            return false;
+        }
+
+        // Readahead of all files first, it only issues the I/O without waiting for it,
+        // so the disk is busy while the workers go through the loads.
+        for (const AssetManifestEntry& entry : *manifest)
+        {
+            PrefetchAssetFile(entry.m_assetId);
+        }
+
+        std::unordered_map<AssetType, PrefetchLoadFunc> prefetchLoaders;
+        {
+            std::lock_guard lock(m_mutex);
+            prefetchLoaders = m_prefetchLoaders;
+        }
+
+        Internal::IsPrefetchingManifest = true;
+        uint32_t loadCount = 0;
+        for (const AssetManifestEntry& entry : *manifest)
+        {
+            if (auto it = prefetchLoaders.find(entry.m_assetType);
+                it != prefetchLoaders.end() && AssetFileExists(entry.m_assetId))
+            {
+                it->second(entry.m_assetId, entry.m_loadFlags);
+                ++loadCount;
+            }
+        }
+        Internal::IsPrefetchingManifest = false;
+
+        DX_LOG(Info, "Asset Manager", "Prefetching %zu asset files from manifest, %u assets loading in the background.",
+            manifest->size(), loadCount);
+
+        return true;
+    }
+
+    bool AssetManager::SaveManifest(const std::filesystem::path& manifestPath)
+    {
+        std::vector<AssetManifestEntry> manifest;
+        {
+            std::lock_guard lock(m_mutex);
+            manifest = m_manifest;
+        }
+
+        return SaveAssetManifest(manifestPath, manifest);
+    }
+
+    void AssetManager::RecordRequest(const AssetId& assetId, AssetType assetType, uint32_t loadFlags)
+    {
+        if (Internal::IsPrefetchingManifest)
+        {
+            return;
+        }
+
+        const float requestTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_creationTime).count();
+
+        std::lock_guard lock(m_mutex);
+
+        if (m_manifestAssets.insert(assetId).second)
+        {
+            m_manifest.push_back({ assetId, assetType, loadFlags, requestTimeMs });
+        }
+    }
+
+    std::shared_ptr<AssetBase> AssetManager::FindAsset(const AssetId& assetId)
+    {
+        auto it = m_assets.find(assetId);
+        if (it == m_assets.end())
+        {
+            return {};
+        }
+
+        auto asset = it->second.m_weakAsset.lock();
+        if (!asset)
+        {
+            // Evicted and no longer referenced by anyone.
+            m_assets.erase(it);
+            return {};
+        }
+
+        it->second.m_lastAccess = ++m_accessCounter;
+        return asset;
+    }
+
+    void AssetManager::EvictOverBudget(std::vector<std::shared_ptr<AssetBase>>& evictedAssets)
+    {
+        size_t heldBytes = 0;
+        std::vector<AssetEntry*> cachedEntries;
+        for (auto& [assetId, entry] : m_assets)
+        {
+            if (!entry.m_asset)
+            {
+                continue;
+            }
+
+            heldBytes += entry.m_asset->GetDataSizeInBytes();
+
+            auto policyIt = m_residencyPolicies.find(entry.m_asset->GetAssetType());
+            if (policyIt != m_residencyPolicies.end() &&
+                policyIt->second == AssetResidency::Cache)
+            {
+                cachedEntries.push_back(&entry);
+            }
+        }
+
+        if (heldBytes <= m_memoryBudget)
+        {
+            return;
+        }
+
+        std::ranges::sort(cachedEntries, [](const AssetEntry* lhs, const AssetEntry* rhs)
+            {
+                return lhs->m_lastAccess < rhs->m_lastAccess;
+            });
+
+        for (AssetEntry* entry : cachedEntries)
+        {
+            if (heldBytes <= m_memoryBudget)
+            {
+                break;
+            }
+
+            heldBytes -= entry->m_asset->GetDataSizeInBytes();
+
+            DX_LOG(Verbose, "Asset Manager", "Evicting asset %s (%.1f KB) to fit in memory budget.",
+                entry->m_asset->GetAssetId().c_str(), entry->m_asset->GetDataSizeInBytes() / 1024.0f);
+
+            evictedAssets.push_back(std::move(entry->m_asset));
+        }
+
+        if (heldBytes > m_memoryBudget)
+        {
+            DX_LOG(Warning, "Asset Manager", "Assets held use %.1f MB, over the memory budget of %.1f MB.",
+                heldBytes / (1024.0f * 1024.0f), m_memoryBudget / (1024.0f * 1024.0f));
+        }
+    }
+
+    std::optional<AssetFuture> AssetManager::FindOrBeginLoad(const AssetId& assetId, uint32_t loadFlags, AssetFuture newLoad)
+    {
+        std::lock_guard lock(m_mutex);
+
+        // Assets are shared by filename, a request with other import settings gets the asset as it was loaded.
+        const auto warnIfFlagsDiffer = [&assetId, loadFlags](uint32_t existingLoadFlags)
+        {
+            if (existingLoadFlags != loadFlags)
+            {
+                DX_LOG(Warning, "Asset Manager", "Asset %s requested with load flags 0x%x, but it was loaded with 0x%x. Using the loaded one.",
+                    assetId.c_str(), loadFlags, existingLoadFlags);
+            }
+        };
+
+        if (auto asset = FindAsset(assetId))
+        {
+            warnIfFlagsDiffer(m_assets.at(assetId).m_loadFlags);
+
+            std::promise<std::shared_ptr<AssetBase>> promise;
+            promise.set_value(std::move(asset));
+            return promise.get_future().share();
+        }
+
+        if (auto it = m_pendingLoads.find(assetId);
+            it != m_pendingLoads.end())
+        {
+            warnIfFlagsDiffer(it->second.m_loadFlags);
+            return it->second.m_future;
+        }
+
+        m_pendingLoads.emplace(assetId, PendingLoad{ std::move(newLoad), loadFlags });
+        return std::nullopt;
+    }
+
+    std::optional<AssetFuture> AssetManager::FindOrBeginReload(const AssetId& assetId, AssetFuture newLoad)
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (auto it = m_pendingLoads.find(assetId);
+            it != m_pendingLoads.end())
+        {
+            return it->second.m_future;
+        }
+
+        const auto assetIt = m_assets.find(assetId);
+        const uint32_t loadFlags = (assetIt != m_assets.end()) ? assetIt->second.m_loadFlags : 0;
+
+        m_pendingLoads.emplace(assetId, PendingLoad{ std::move(newLoad), loadFlags });
+        return std::nullopt;
+    }
+
+    bool AssetManager::SubmitLoadJob(std::function<void(ThreadPool* threadPool)> loadJob)
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (!m_threadPool)
+        {
+            return false;
+        }
+
+        // The pool outlives its jobs, as it joins the workers when destroyed.
+        m_threadPool->Submit([threadPool = m_threadPool.get(), loadJob = std::move(loadJob)]()
+            {
+                loadJob(threadPool);
+            });
+        return true;
+    }
+
+    ThreadPool* AssetManager::GetLoadThreadPool()
+    {
+        std::lock_guard lock(m_mutex);
+
+        return m_threadPool.get();
+    }
+
+    void AssetManager::EndLoad(const AssetId& assetId, std::shared_ptr<AssetBase> asset)
+    {
+        std::vector<std::shared_ptr<AssetBase>> evictedAssets;
+
+        std::lock_guard lock(m_mutex);
+
+        // Adding the asset and removing the pending load happens atomically,
+        // so other threads will always find either the asset or its load.
+        // A failed reload keeps the previous asset.
+        const auto pendingLoadIt = m_pendingLoads.find(assetId);
+        if (asset)
+        {
+            const uint32_t loadFlags = (pendingLoadIt != m_pendingLoads.end()) ? pendingLoadIt->second.m_loadFlags : 0;
+            m_assets.insert_or_assign(assetId, AssetEntry{ asset, asset, ++m_accessCounter, loadFlags });
+        }
+        if (pendingLoadIt != m_pendingLoads.end())
+        {
+            m_pendingLoads.erase(pendingLoadIt);
+        }
+
+        EvictOverBudget(evictedAssets);
+    }
+} // namespace DX
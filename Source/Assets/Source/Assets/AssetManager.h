@@ -0,0 +1,444 @@
+#pragma once
+
+#include <Singleton/Singleton.h>
+#include <Assets/Asset.h>
+#include <Assets/AssetManifest.h>
+#include <File/FileUtils.h>
+#include <Thread/ThreadPool.h>
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+
+namespace DX
+{
+    // Loads the data of an asset. The thread pool can be used to parallelize the
+    // work, it's null when the load has to run serially.
+    template<typename T>
+    using LoadDataFunc = std::function<std::unique_ptr<typename T::DataType>(const std::filesystem::path& fileNamePath, ThreadPool* threadPool)>;
+
+    using AssetFuture = std::shared_future<std::shared_ptr<AssetBase>>;
+
+    // Starts loading an asset asynchronously with the import settings flags recorded in the manifest.
+    using PrefetchLoadFunc = std::function<void(const std::string& fileName, uint32_t loadFlags)>;
+
+    // How long the asset manager keeps the assets of a type in memory.
+    // Assets are alive anyway while anybody else references them.
+    enum class AssetResidency
+    {
+        Keep,            // Until it's removed or the asset manager is destroyed.
+        DropAfterUpload, // Until NotifyAssetUploaded is called after uploading its data to GPU.
+        Cache            // While it fits in the memory budget, least recently used are evicted first.
+    };
+
+    struct AssetResidencyStats
+    {
+        uint32_t m_assetCount = 0;
+        size_t m_residentBytes = 0; // CPU memory owned by the assets' data
+    };
+
+    // Handle to an asset being loaded asynchronously.
+    template<typename T>
+    class AssetLoadHandle
+    {
+    public:
+        AssetLoadHandle() = default;
+        explicit AssetLoadHandle(AssetFuture future)
+            : m_future(std::move(future))
+        {
+        }
+
+        bool IsValid() const { return m_future.valid(); }
+
+        // Returns true when the load has finished, successfully or not.
+        bool IsReady() const
+        {
+            return m_future.valid() &&
+                m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        // Waits for the load to finish and returns the asset.
+        // Returns null if the load failed, also when the loader threw an exception.
+        std::shared_ptr<T> Get() const;
+
+    private:
+        AssetFuture m_future;
+    };
+
+    // Manager for all assets. It stores all assets in a map and provides methods to get them.
+    // Each specific asset type will use AssetManager to load and store assets.
+    // Do not use AssetManager directly, use the specific Asset class instead.
+    //
+    // All methods are thread safe. Assets can be loaded asynchronously in a pool
+    // of worker threads, requests of an asset already being loaded will wait for
+    // the same load instead of starting a new one.
+    //
+    // The residency policy of each asset type decides when the asset manager stops
+    // holding its assets. Evicting an asset turns its reference into a weak one, so
+    // the asset is destroyed when no one else is using it and until then requests
+    // still find it instead of loading it again.
+    //
+    // The assets requested during a session are recorded in a manifest. On the next
+    // startup the manifest can be prefetched, reading all its files from disk and
+    // loading its assets in the background before they are requested.
+    //
+    // Call Shutdown before Destroy, so no load is running once the singleton is gone.
+    // Loaders receive the thread pool as parameter and never go through Get().
+    class AssetManager : public Singleton<AssetManager>
+    {
+        friend class Singleton<AssetManager>;
+        AssetManager();
+
+    public:
+        ~AssetManager();
+
+        // Cancels the asynchronous loads still queued, waits for the ones running and
+        // destroys the worker threads. Loads requested afterwards fail, except
+        // synchronous ones, which run serially in the calling thread.
+        // To be called from the main thread once nobody else is requesting assets.
+        void Shutdown();
+
+        void AddAsset(std::shared_ptr<AssetBase> asset);
+        void RemoveAsset(AssetId assetId);
+
+        std::shared_ptr<AssetBase> GetAsset(AssetId assetId);
+
+        // Residency policy of the assets of a type. Keep by default.
+        void SetResidencyPolicy(AssetType assetType, AssetResidency residency);
+        AssetResidency GetResidencyPolicy(AssetType assetType);
+
+        // Memory that assets held by the asset manager can use before cached assets are evicted.
+        void SetMemoryBudget(size_t budgetBytes);
+        size_t GetMemoryBudget();
+
+        // To be called when the asset's data has been uploaded to GPU and the
+        // caller doesn't need it anymore. Assets with DropAfterUpload policy are evicted.
+        void NotifyAssetUploaded(const AssetId& assetId);
+
+        // Assets alive and the CPU memory they use, per asset type.
+        std::unordered_map<AssetType, AssetResidencyStats> GetResidencyStats();
+
+        template<typename T>
+        std::shared_ptr<T> GetAssetAs(AssetId assetId);
+
+        // Loads an asset from a file. The filename is relative to the Assets folder.
+        // If the asset is being loaded asynchronously it waits for it to finish.
+        // Load flags are the import settings used by loadDataFunc, they are recorded in the manifest.
+        // Assets are identified by filename only, when the asset has been loaded with other flags
+        // that one is returned and a warning is logged.
+        template<typename T>
+        std::shared_ptr<T> LoadAssetAs(const std::string& fileName, LoadDataFunc<T> loadDataFunc, uint32_t loadFlags = 0);
+
+        // Loads an asset from a file in a worker thread. The filename is relative to the Assets folder.
+        // Load flags are the import settings used by loadDataFunc, they are recorded in the manifest.
+        // Assets are identified by filename only, when the asset has been loaded with other flags
+        // that one is returned and a warning is logged.
+        template<typename T>
+        AssetLoadHandle<T> LoadAssetAsync(const std::string& fileName, LoadDataFunc<T> loadDataFunc, uint32_t loadFlags = 0);
+
+        // Loads the asset again in a worker thread, for example after its file has been modified.
+        // When it succeeds the new asset replaces the current one for new requests, who is still
+        // using the current asset keeps it. When it fails the current asset is kept.
+        // If the asset is already being loaded, that load is returned instead.
+        template<typename T>
+        AssetLoadHandle<T> ReloadAssetAsync(const std::string& fileName, LoadDataFunc<T> loadDataFunc);
+
+        // Function used to load the assets of a type found in the manifest when prefetching it.
+        // Assets of types without a prefetch loader only have their files prefetched.
+        void SetPrefetchLoader(AssetType assetType, PrefetchLoadFunc prefetchLoadFunc);
+
+        // Reads all the files of the assets in the manifest from disk in the background and
+        // starts loading the assets in the worker threads, in the order they were requested.
+        // Returns false if the manifest couldn't be loaded, for example the first time.
+        bool PrefetchManifest(const std::filesystem::path& manifestPath);
+
+        // Writes the manifest of the assets requested since the asset manager was created.
+        bool SaveManifest(const std::filesystem::path& manifestPath);
+
+        // Pool of worker threads used to load assets. Not available after Shutdown.
+        // Asset loaders receive it as parameter instead.
+        ThreadPool& GetThreadPool()
+        {
+            DX_ASSERT(m_threadPool != nullptr, "AssetManager", "Thread pool used after shutting down the asset manager.");
+            return *m_threadPool;
+        }
+
+    private:
+        // Returns the asset or its in-flight load if any, warning when they were loaded with
+        // other flags. Otherwise it registers the new load passed as parameter and returns
+        // nullopt, in which case the caller must load the asset and then call EndLoad.
+        std::optional<AssetFuture> FindOrBeginLoad(const AssetId& assetId, uint32_t loadFlags, AssetFuture newLoad);
+        // Same as FindOrBeginLoad, but only in-flight loads are returned, existing assets are ignored.
+        // The reload keeps the load flags of the current asset.
+        std::optional<AssetFuture> FindOrBeginReload(const AssetId& assetId, AssetFuture newLoad);
+        void EndLoad(const AssetId& assetId, std::shared_ptr<AssetBase> asset);
+
+        // Submits the job to the worker threads, which passes it their pool.
+        // Returns false if the asset manager has been shut down.
+        bool SubmitLoadJob(std::function<void(ThreadPool* threadPool)> loadJob);
+
+        // Thread pool for the loads running in the calling thread, null once shut down.
+        ThreadPool* GetLoadThreadPool();
+
+        // Loads the asset in a worker thread and ends its load. Loads that were
+        // still queued when the asset manager was shut down are cancelled.
+        template<typename T>
+        void RunLoadJob(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc,
+            std::promise<std::shared_ptr<AssetBase>>& promise, ThreadPool* threadPool);
+
+        // Loads the asset and ends its load. The promise is set with the asset,
+        // null if it failed, or with the exception thrown by the loader.
+        template<typename T>
+        void CompleteLoad(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc,
+            std::promise<std::shared_ptr<AssetBase>>& promise, ThreadPool* threadPool);
+
+        // Adds the asset to the manifest the first time it's requested.
+        // Requests done while prefetching are not recorded.
+        void RecordRequest(const AssetId& assetId, AssetType assetType, uint32_t loadFlags);
+
+        template<typename T>
+        static std::shared_ptr<AssetBase> LoadAssetData(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc, ThreadPool* threadPool);
+
+        struct AssetEntry
+        {
+            std::shared_ptr<AssetBase> m_asset; // Null once evicted
+            std::weak_ptr<AssetBase> m_weakAsset;
+            uint64_t m_lastAccess = 0;
+            uint32_t m_loadFlags = 0;
+        };
+
+        struct PendingLoad
+        {
+            AssetFuture m_future;
+            uint32_t m_loadFlags = 0;
+        };
+
+        // Returns the asset if it's still alive and marks it as used.
+        // Entries of evicted assets already destroyed are removed.
+        std::shared_ptr<AssetBase> FindAsset(const AssetId& assetId);
+
+        // Evicts cached assets, least recently used first, until the memory of the
+        // assets held by the manager fits in the budget. Evicted assets are moved
+        // to the output, so they are destroyed after releasing the lock.
+        void EvictOverBudget(std::vector<std::shared_ptr<AssetBase>>& evictedAssets);
+
+        using Assets = std::unordered_map<AssetId, AssetEntry>;
+        using PendingLoads = std::unordered_map<AssetId, PendingLoad>;
+
+        static constexpr size_t DefaultMemoryBudget = 512 * 1024 * 1024;
+
+        std::mutex m_mutex;
+        Assets m_assets;
+        PendingLoads m_pendingLoads;
+
+        std::unordered_map<AssetType, AssetResidency> m_residencyPolicies;
+        size_t m_memoryBudget = DefaultMemoryBudget;
+        uint64_t m_accessCounter = 0;
+
+        std::chrono::steady_clock::time_point m_creationTime;
+        std::vector<AssetManifestEntry> m_manifest;
+        std::unordered_set<AssetId> m_manifestAssets;
+        std::unordered_map<AssetType, PrefetchLoadFunc> m_prefetchLoaders;
+
+        std::unique_ptr<ThreadPool> m_threadPool; // Null once shut down
+        std::atomic<bool> m_shuttingDown = false;
+    };
+
+    template<typename T>
+    std::shared_ptr<T> AssetLoadHandle<T>::Get() const
+    {
+        if (!m_future.valid())
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<AssetBase> asset;
+        try
+        {
+            asset = m_future.get();
+        }
+        catch (const std::exception& exception)
+        {
+            DX_LOG(Error, "AssetManager", "Asset load failed with exception: %s", exception.what());
+            return nullptr;
+        }
+        catch (...)
+        {
+            DX_LOG(Error, "AssetManager", "Asset load failed with unknown exception.");
+            return nullptr;
+        }
+
+        if (asset && asset->GetAssetType() != T::AssetTypeId)
+        {
+            DX_LOG(Error, "AssetManager", "An asset of different asset type already exists with Id %s.", asset->GetAssetId().c_str());
+            return nullptr;
+        }
+        return std::static_pointer_cast<T>(asset);
+    }
+
+    template<typename T>
+    std::shared_ptr<T> AssetManager::GetAssetAs(AssetId assetId)
+    {
+        return std::static_pointer_cast<T>(GetAsset(std::move(assetId)));
+    }
+
+    template<typename T>
+    std::shared_ptr<T> AssetManager::LoadAssetAs(const std::string& fileName, LoadDataFunc<T> loadDataFunc, uint32_t loadFlags)
+    {
+        if (fileName.empty())
+        {
+            DX_LOG(Error, "AssetManager", "Filename is empty.");
+            return nullptr;
+        }
+
+        RecordRequest(fileName, T::AssetTypeId, loadFlags);
+
+        // Check if asset already exists (by Id) or it's being loaded
+        std::promise<std::shared_ptr<AssetBase>> promise;
+        AssetFuture future = promise.get_future().share();
+        if (auto existingLoad = FindOrBeginLoad(fileName, loadFlags, future))
+        {
+            return AssetLoadHandle<T>(*existingLoad).Get();
+        }
+
+        CompleteLoad<T>(fileName, loadDataFunc, promise, GetLoadThreadPool());
+
+        return AssetLoadHandle<T>(future).Get();
+    }
+
+    template<typename T>
+    AssetLoadHandle<T> AssetManager::LoadAssetAsync(const std::string& fileName, LoadDataFunc<T> loadDataFunc, uint32_t loadFlags)
+    {
+        if (fileName.empty())
+        {
+            DX_LOG(Error, "AssetManager", "Filename is empty.");
+            return {};
+        }
+
+        RecordRequest(fileName, T::AssetTypeId, loadFlags);
+
+        // Check if asset already exists (by Id) or it's being loaded
+        auto promise = std::make_shared<std::promise<std::shared_ptr<AssetBase>>>();
+        AssetFuture future = promise->get_future().share();
+        if (auto existingLoad = FindOrBeginLoad(fileName, loadFlags, future))
+        {
+            return AssetLoadHandle<T>(*existingLoad);
+        }
+
+        if (!SubmitLoadJob([this, fileName, loadDataFunc = std::move(loadDataFunc), promise](ThreadPool* threadPool)
+            {
+                RunLoadJob<T>(fileName, loadDataFunc, *promise, threadPool);
+            }))
+        {
+            DX_LOG(Error, "AssetManager", "Asset %s requested after shutting down the asset manager.", fileName.c_str());
+            EndLoad(fileName, nullptr);
+            promise->set_value(nullptr);
+        }
+
+        return AssetLoadHandle<T>(future);
+    }
+
+    template<typename T>
+    AssetLoadHandle<T> AssetManager::ReloadAssetAsync(const std::string& fileName, LoadDataFunc<T> loadDataFunc)
+    {
+        if (fileName.empty())
+        {
+            DX_LOG(Error, "AssetManager", "Filename is empty.");
+            return {};
+        }
+
+        auto promise = std::make_shared<std::promise<std::shared_ptr<AssetBase>>>();
+        AssetFuture future = promise->get_future().share();
+        if (auto existingLoad = FindOrBeginReload(fileName, future))
+        {
+            return AssetLoadHandle<T>(*existingLoad);
+        }
+
+        if (!SubmitLoadJob([this, fileName, loadDataFunc = std::move(loadDataFunc), promise](ThreadPool* threadPool)
+            {
+                RunLoadJob<T>(fileName, loadDataFunc, *promise, threadPool);
+            }))
+        {
+            DX_LOG(Error, "AssetManager", "Asset %s requested after shutting down the asset manager.", fileName.c_str());
+            EndLoad(fileName, nullptr);
+            promise->set_value(nullptr);
+        }
+
+        return AssetLoadHandle<T>(future);
+    }
+
+    template<typename T>
+    void AssetManager::RunLoadJob(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc,
+        std::promise<std::shared_ptr<AssetBase>>& promise, ThreadPool* threadPool)
+    {
+        if (m_shuttingDown)
+        {
+            DX_LOG(Verbose, "AssetManager", "Load of asset %s cancelled, the asset manager is shutting down.", fileName.c_str());
+            EndLoad(fileName, nullptr);
+            promise.set_value(nullptr);
+            return;
+        }
+
+        CompleteLoad<T>(fileName, loadDataFunc, promise, threadPool);
+    }
+
+    template<typename T>
+    void AssetManager::CompleteLoad(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc,
+        std::promise<std::shared_ptr<AssetBase>>& promise, ThreadPool* threadPool)
+    {
+        // An exception escaping a worker would terminate the application, and
+        // without ending the load every request would wait for it forever.
+        std::shared_ptr<AssetBase> newAsset;
+        std::exception_ptr exception;
+        try
+        {
+            newAsset = LoadAssetData<T>(fileName, loadDataFunc, threadPool);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        EndLoad(fileName, newAsset);
+
+        if (exception)
+        {
+            promise.set_exception(exception);
+        }
+        else
+        {
+            promise.set_value(newAsset);
+        }
+    }
+
+    template<typename T>
+    std::shared_ptr<AssetBase> AssetManager::LoadAssetData(const std::string& fileName, const LoadDataFunc<T>& loadDataFunc, ThreadPool* threadPool)
+    {
+        // Check if filename exists, either in the mounted asset pack or the assets folder
+        auto fileNamePath = GetAssetPath() / fileName;
+        if (!AssetFileExists(fileName))
+        {
+            DX_LOG(Error, "AssetManager", "Filename path %s does not exist.", fileNamePath.generic_string().c_str());
+            return nullptr;
+        }
+
+        auto data = loadDataFunc(fileNamePath, threadPool);
+        if (!data)
+        {
+            DX_LOG(Error, "AssetManager", "Failed to load asset %s.", fileNamePath.generic_string().c_str());
+            return nullptr;
+        }
+
+        return std::shared_ptr<T>(new T(fileName, std::move(data)));
+    }
+} // namespace DX
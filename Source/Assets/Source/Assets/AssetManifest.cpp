@@ -0,0 +1,149 @@
+#include <Assets/AssetManifest.h>
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Log/Log.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t AssetManifestMagic = 0x4D415844; // 'DXAM'
+
+        // Increment every time the layout of the manifest changes.
+        static constexpr uint32_t AssetManifestVersion = 1;
+
+        static constexpr const char* AssetManifestFileName = "AssetLoad.manifest";
+
+        // Asset manifest file layout:
+        //   AssetManifestHeader
+        //   Entries one after the other, each one is an AssetManifestRecord followed by the asset id
+        struct AssetManifestHeader
+        {
+            uint32_t m_magic;
+            uint32_t m_version;
+            uint32_t m_entryCount;
+        };
+
+        struct AssetManifestRecord
+        {
+            uint32_t m_assetType;
+            uint32_t m_loadFlags;
+            float m_requestTimeMs;
+            uint32_t m_assetIdSize;
+        };
+    } // namespace Internal
+
+    std::filesystem::path GetAssetManifestPath()
+    {
+        return GetAssetCachePath() / Internal::AssetManifestFileName;
+    }
+
+    std::optional<std::vector<AssetManifestEntry>> LoadAssetManifest(const std::filesystem::path& manifestPath)
+    {
+        if (!std::filesystem::exists(manifestPath))
+        {
+            return std::nullopt;
+        }
+
+        MappedFile manifestFile;
+        if (!manifestFile.Open(manifestPath))
+        {
+            return std::nullopt;
+        }
+
+        if (manifestFile.GetSize() < sizeof(Internal::AssetManifestHeader))
+        {
+            DX_LOG(Warning, "AssetManifest", "Asset manifest %s is corrupted.", manifestPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        Internal::AssetManifestHeader header;
+        std::memcpy(&header, manifestFile.GetData(), sizeof(header));
+
+        if (header.m_magic != Internal::AssetManifestMagic ||
+            header.m_version != Internal::AssetManifestVersion)
+        {
+            DX_LOG(Verbose, "AssetManifest", "Asset manifest %s is from a different version.", manifestPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        std::vector<AssetManifestEntry> entries;
+        entries.reserve(header.m_entryCount);
+
+        size_t offset = sizeof(header);
+        for (uint32_t entryIndex = 0; entryIndex < header.m_entryCount; ++entryIndex)
+        {
+            Internal::AssetManifestRecord record;
+            if (offset + sizeof(record) > manifestFile.GetSize())
+            {
+                DX_LOG(Warning, "AssetManifest", "Asset manifest %s is corrupted.", manifestPath.generic_string().c_str());
+                return std::nullopt;
+            }
+            std::memcpy(&record, manifestFile.GetData() + offset, sizeof(record));
+            offset += sizeof(record);
+
+            if (record.m_assetIdSize == 0 || offset + record.m_assetIdSize > manifestFile.GetSize())
+            {
+                DX_LOG(Warning, "AssetManifest", "Asset manifest %s is corrupted.", manifestPath.generic_string().c_str());
+                return std::nullopt;
+            }
+
+            AssetManifestEntry& entry = entries.emplace_back();
+            entry.m_assetId.assign(reinterpret_cast<const char*>(manifestFile.GetData() + offset), record.m_assetIdSize);
+            entry.m_assetType = record.m_assetType;
+            entry.m_loadFlags = record.m_loadFlags;
+            entry.m_requestTimeMs = record.m_requestTimeMs;
+            offset += record.m_assetIdSize;
+        }
+
+        return entries;
+    }
+
+    bool SaveAssetManifest(const std::filesystem::path& manifestPath, const std::vector<AssetManifestEntry>& entries)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(manifestPath.parent_path(), errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "AssetManifest", "Failed to create cache folder %s.", manifestPath.parent_path().generic_string().c_str());
+            return false;
+        }
+
+        const Internal::AssetManifestHeader header =
+        {
+            .m_magic = Internal::AssetManifestMagic,
+            .m_version = Internal::AssetManifestVersion,
+            .m_entryCount = static_cast<uint32_t>(entries.size())
+        };
+
+        // Write into a temporary file and rename it at the end, so a
+        // partially written manifest is never picked up on startup.
+        const bool written = WriteFileAtomically(manifestPath, [&](std::ofstream& file)
+            {
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                for (const AssetManifestEntry& entry : entries)
+                {
+                    const Internal::AssetManifestRecord record =
+                    {
+                        .m_assetType = entry.m_assetType,
+                        .m_loadFlags = entry.m_loadFlags,
+                        .m_requestTimeMs = entry.m_requestTimeMs,
+                        .m_assetIdSize = static_cast<uint32_t>(entry.m_assetId.size())
+                    };
+                    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+                    file.write(entry.m_assetId.data(), entry.m_assetId.size());
+                }
+            });
+        if (!written)
+        {
+            DX_LOG(Error, "AssetManifest", "Failed to save asset manifest %s.", manifestPath.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+} // namespace DX
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Assets/Asset.h>
+
+#include <vector>
+#include <optional>
+#include <filesystem>
+
+namespace DX
+{
+    // Asset loaded during a session, in the order they were requested.
+    struct AssetManifestEntry
+    {
+        AssetId m_assetId;
+        AssetType m_assetType = 0;
+        uint32_t m_loadFlags = 0; // Import settings flags the asset was loaded with
+        float m_requestTimeMs = 0.0f; // Since the asset manager was created
+    };
+
+    // Returns the path of the manifest recorded by the last session inside the cache folder.
+    std::filesystem::path GetAssetManifestPath();
+
+    // Reads a manifest of asset loads. Returns nullopt if the file
+    // doesn't exist, it's from a different version or it's corrupted.
+    std::optional<std::vector<AssetManifestEntry>> LoadAssetManifest(const std::filesystem::path& manifestPath);
+
+    // Writes a manifest of asset loads, replacing the existing one.
+    bool SaveAssetManifest(const std::filesystem::path& manifestPath, const std::vector<AssetManifestEntry>& entries);
+} // namespace DX
@@ -0,0 +1,699 @@
+#include <Assets/GltfLoader.h>
+#include <Assets/MeshAsset.h>
+#include <Assets/MeshVertexProcessing.h>
+#include <File/FileUtils.h>
+#include <Json/Json.h>
+#include <Math/Matrix3x3.h>
+#include <Math/Matrix4x4.h>
+#include <Math/Transform.h>
+#include <Log/Log.h>
+
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Binary glTF container.
+        static constexpr uint32_t GlbMagic = 0x46546C67; // "glTF"
+        static constexpr uint32_t GlbVersion = 2;
+        static constexpr uint32_t GlbChunkJson = 0x4E4F534A; // "JSON"
+        static constexpr uint32_t GlbChunkBin = 0x004E4942; // "BIN\0"
+        static constexpr size_t GlbHeaderSize = 12;
+        static constexpr size_t GlbChunkHeaderSize = 8;
+
+        // Accessor component types.
+        static constexpr uint32_t GltfUnsignedByte = 5121;
+        static constexpr uint32_t GltfUnsignedShort = 5123;
+        static constexpr uint32_t GltfUnsignedInt = 5125;
+        static constexpr uint32_t GltfFloat = 5126;
+
+        static constexpr uint32_t GltfTriangles = 4;
+
+        // Nodes can't be deeper than this, it protects against cycles in malformed files.
+        static constexpr uint32_t GltfMaxNodeDepth = 256;
+
+        uint32_t ReadUint32(const uint8_t* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        size_t GetGltfComponentSize(uint32_t componentType)
+        {
+            switch (componentType)
+            {
+            case 5120: // Byte
+            case GltfUnsignedByte:
+                return 1;
+            case 5122: // Short
+            case GltfUnsignedShort:
+                return 2;
+            case GltfUnsignedInt:
+            case GltfFloat:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+
+        uint32_t GetGltfComponentCount(std::string_view type)
+        {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            return 0;
+        }
+
+        // Elements of an accessor, validated to be inside their buffer.
+        struct GltfAccessor
+        {
+            const uint8_t* m_data = nullptr;
+            size_t m_stride = 0;
+            uint32_t m_count = 0;
+            uint32_t m_componentType = 0;
+            uint32_t m_componentCount = 0;
+            bool m_normalized = false;
+
+            Math::Vector2 ReadVector2(uint32_t index) const
+            {
+                const uint8_t* element = m_data + index * m_stride;
+                switch (m_componentType)
+                {
+                case GltfUnsignedByte:
+                    return Math::Vector2(element[0], element[1]) / 255.0f;
+                case GltfUnsignedShort:
+                {
+                    uint16_t components[2];
+                    std::memcpy(components, element, sizeof(components));
+                    return Math::Vector2(components[0], components[1]) / 65535.0f;
+                }
+                default:
+                {
+                    Math::Vector2Packed packed;
+                    std::memcpy(&packed, element, sizeof(packed));
+                    return Math::Vector2(packed);
+                }
+                }
+            }
+
+            Math::Vector3 ReadVector3(uint32_t index) const
+            {
+                Math::Vector3Packed packed;
+                std::memcpy(&packed, m_data + index * m_stride, sizeof(packed));
+                return Math::Vector3(packed);
+            }
+
+            Math::Vector4 ReadVector4(uint32_t index) const
+            {
+                Math::Vector4Packed packed;
+                std::memcpy(&packed, m_data + index * m_stride, sizeof(packed));
+                return Math::Vector4(packed);
+            }
+
+            uint32_t ReadIndex(uint32_t index) const
+            {
+                const uint8_t* element = m_data + index * m_stride;
+                switch (m_componentType)
+                {
+                case GltfUnsignedByte:
+                    return element[0];
+                case GltfUnsignedShort:
+                {
+                    uint16_t value;
+                    std::memcpy(&value, element, sizeof(value));
+                    return value;
+                }
+                default:
+                    return ReadUint32(element);
+                }
+            }
+        };
+
+        // Finds the json text and the embedded binary buffer of glb files.
+        bool ReadGltfChunks(const std::filesystem::path& filePath, std::span<const uint8_t> data,
+            std::string_view& jsonText, std::span<const uint8_t>& binaryChunk)
+        {
+            if (filePath.extension() != ".glb")
+            {
+                jsonText = std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+                return true;
+            }
+
+            if (data.size() < GlbHeaderSize + GlbChunkHeaderSize ||
+                ReadUint32(data.data()) != GlbMagic ||
+                ReadUint32(data.data() + 4) != GlbVersion)
+            {
+                DX_LOG(Warning, "GltfLoader", "Invalid glb header in %s.", filePath.generic_string().c_str());
+                return false;
+            }
+
+            // JSON chunk comes first, followed by an optional BIN chunk.
+            size_t offset = GlbHeaderSize;
+            while (offset + GlbChunkHeaderSize <= data.size())
+            {
+                const size_t chunkSize = ReadUint32(data.data() + offset);
+                const uint32_t chunkType = ReadUint32(data.data() + offset + 4);
+                offset += GlbChunkHeaderSize;
+                if (chunkSize > data.size() - offset)
+                {
+                    DX_LOG(Warning, "GltfLoader", "Truncated glb chunk in %s.", filePath.generic_string().c_str());
+                    return false;
+                }
+
+                const auto chunk = data.subspan(offset, chunkSize);
+                if (chunkType == GlbChunkJson && jsonText.empty())
+                {
+                    jsonText = std::string_view(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+                }
+                else if (chunkType == GlbChunkBin && binaryChunk.empty())
+                {
+                    binaryChunk = chunk;
+                }
+                offset += chunkSize;
+            }
+            return true;
+        }
+
+        // Buffers stored in external files, relative to the glTF file.
+        bool IsExternalGltfBuffer(std::string_view uri)
+        {
+            return !uri.empty() && !uri.starts_with("data:");
+        }
+
+        // Json document of a glTF file with its binary buffers mapped.
+        class GltfDocument
+        {
+        public:
+            bool Load(const std::filesystem::path& filePath)
+            {
+                auto file = OpenAssetFile(filePath);
+                if (!file)
+                {
+                    return false;
+                }
+
+                std::string_view jsonText;
+                std::span<const uint8_t> binaryChunk;
+                if (!ReadGltfChunks(filePath, file->GetData(), jsonText, binaryChunk))
+                {
+                    return false;
+                }
+
+                auto json = ParseJson(jsonText);
+                if (!json || !json->IsObject())
+                {
+                    DX_LOG(Warning, "GltfLoader", "Invalid json in %s.", filePath.generic_string().c_str());
+                    return false;
+                }
+                m_json = std::move(*json);
+                m_files.push_back(std::move(*file));
+
+                return LoadBuffers(filePath, binaryChunk);
+            }
+
+            const JsonValue& GetArray(std::string_view name) const
+            {
+                static const JsonValue EmptyArray;
+                const JsonValue* array = m_json.Find(name);
+                return array ? *array : EmptyArray;
+            }
+
+            const JsonValue& GetRoot() const
+            {
+                return m_json;
+            }
+
+            std::optional<GltfAccessor> GetAccessor(uint32_t accessorIndex) const
+            {
+                const JsonValue& accessor = GetArray("accessors")[accessorIndex];
+                const JsonValue* bufferViewIndex = accessor.Find("bufferView");
+
+                // Accessors without buffer view are all zeros and sparse accessors
+                // patch their values, neither is used by the meshes we load.
+                if (!accessor.IsObject() || !bufferViewIndex || accessor.Find("sparse"))
+                {
+                    return std::nullopt;
+                }
+
+                const JsonValue& bufferView = GetArray("bufferViews")[bufferViewIndex->GetUint(UINT32_MAX)];
+                const uint32_t bufferIndex = bufferView.Find("buffer") ? bufferView.Find("buffer")->GetUint(UINT32_MAX) : UINT32_MAX;
+                if (!bufferView.IsObject() || bufferIndex >= m_buffers.size())
+                {
+                    return std::nullopt;
+                }
+
+                GltfAccessor result;
+                result.m_count = accessor.Find("count") ? accessor.Find("count")->GetUint() : 0;
+                result.m_componentType = accessor.Find("componentType") ? accessor.Find("componentType")->GetUint() : 0;
+                result.m_componentCount = accessor.Find("type") ? GetGltfComponentCount(accessor.Find("type")->GetString()) : 0;
+                result.m_normalized = accessor.Find("normalized") && accessor.Find("normalized")->GetBool();
+
+                const size_t elementSize = GetGltfComponentSize(result.m_componentType) * result.m_componentCount;
+                if (elementSize == 0)
+                {
+                    return std::nullopt;
+                }
+
+                const auto getOffset = [](const JsonValue& value, std::string_view name, size_t defaultValue)
+                {
+                    const JsonValue* offset = value.Find(name);
+                    return offset ? static_cast<size_t>(offset->GetUint(UINT32_MAX)) : defaultValue;
+                };
+
+                const std::span<const uint8_t> buffer = m_buffers[bufferIndex];
+                const size_t viewOffset = getOffset(bufferView, "byteOffset", 0);
+                const size_t viewLength = getOffset(bufferView, "byteLength", 0);
+                const size_t accessorOffset = getOffset(accessor, "byteOffset", 0);
+                result.m_stride = getOffset(bufferView, "byteStride", elementSize);
+
+                if (viewOffset > buffer.size() ||
+                    viewLength > buffer.size() - viewOffset ||
+                    result.m_stride < elementSize)
+                {
+                    return std::nullopt;
+                }
+
+                if (result.m_count > 0)
+                {
+                    const size_t accessorSize = result.m_stride * (result.m_count - 1) + elementSize;
+                    if (accessorOffset > viewLength || accessorSize > viewLength - accessorOffset)
+                    {
+                        return std::nullopt;
+                    }
+                }
+
+                result.m_data = buffer.data() + viewOffset + accessorOffset;
+                return result;
+            }
+
+        private:
+            JsonValue m_json;
+            std::vector<AssetFile> m_files; // Keeps the buffers mapped
+            std::vector<std::span<const uint8_t>> m_buffers;
+
+            bool LoadBuffers(const std::filesystem::path& filePath, std::span<const uint8_t> binaryChunk)
+            {
+                const JsonValue& buffers = GetArray("buffers");
+                for (size_t i = 0; i < buffers.GetSize(); ++i)
+                {
+                    const JsonValue* uri = buffers[i].Find("uri");
+                    const size_t byteLength = buffers[i].Find("byteLength") ? buffers[i].Find("byteLength")->GetUint() : 0;
+
+                    std::span<const uint8_t> buffer;
+                    if (!uri)
+                    {
+                        // Only the first buffer of a glb file can reference the BIN chunk.
+                        if (i != 0 || binaryChunk.empty())
+                        {
+                            return false;
+                        }
+                        buffer = binaryChunk;
+                    }
+                    else
+                    {
+                        // Embedded base64 buffers are left to Assimp.
+                        const std::string_view uriPath = uri->GetString();
+                        if (!Internal::IsExternalGltfBuffer(uriPath))
+                        {
+                            return false;
+                        }
+
+                        auto bufferFile = OpenAssetFile(filePath.parent_path() / std::filesystem::path(uriPath));
+                        if (!bufferFile)
+                        {
+                            DX_LOG(Warning, "GltfLoader", "Buffer %.*s referenced by %s not found.",
+                                static_cast<int>(uriPath.size()), uriPath.data(), filePath.generic_string().c_str());
+                            return false;
+                        }
+                        buffer = bufferFile->GetData();
+                        m_files.push_back(std::move(*bufferFile));
+                    }
+
+                    if (buffer.size() < byteLength)
+                    {
+                        return false;
+                    }
+                    m_buffers.push_back(buffer.first(byteLength));
+                }
+                return true;
+            }
+        };
+
+        Math::Matrix4x4 GetGltfNodeTransform(const JsonValue& node)
+        {
+            if (const JsonValue* matrix = node.Find("matrix");
+                matrix && matrix->GetSize() == 16)
+            {
+                // Column major, like Matrix4x4
+                Math::Matrix4x4 transform = Math::Matrix4x4::Identity();
+                for (int i = 0; i < 16; ++i)
+                {
+                    transform(i % 4, i / 4) = (*matrix)[i].GetFloat();
+                }
+                return transform;
+            }
+
+            Math::Transform transform = Math::Transform::CreateIdentity();
+            if (const JsonValue* translation = node.Find("translation");
+                translation && translation->GetSize() == 3)
+            {
+                transform.m_position = Math::Vector3((*translation)[0].GetFloat(), (*translation)[1].GetFloat(), (*translation)[2].GetFloat());
+            }
+            if (const JsonValue* rotation = node.Find("rotation");
+                rotation && rotation->GetSize() == 4)
+            {
+                // glTF stores quaternions as (x, y, z, w)
+                transform.m_rotation = Math::Quaternion(
+                    (*rotation)[3].GetFloat(), (*rotation)[0].GetFloat(), (*rotation)[1].GetFloat(), (*rotation)[2].GetFloat()).Normalized();
+            }
+            if (const JsonValue* scale = node.Find("scale");
+                scale && scale->GetSize() == 3)
+            {
+                transform.m_scale = Math::Vector3((*scale)[0].GetFloat(), (*scale)[1].GetFloat(), (*scale)[2].GetFloat());
+            }
+            return transform.ToMatrix();
+        }
+
+        class GltfMeshLoader
+        {
+        public:
+            GltfMeshLoader(const GltfDocument& document, MeshData* meshData, const std::filesystem::path& filePath, ThreadPool* threadPool)
+                : m_document(document)
+                , m_meshData(meshData)
+                , m_fileName(filePath.filename().generic_string())
+                , m_threadPool(threadPool)
+            {
+            }
+
+            bool ProcessNode(uint32_t nodeIndex, const Math::Matrix4x4& parentTransform, uint32_t depth)
+            {
+                const JsonValue& node = m_document.GetArray("nodes")[nodeIndex];
+                if (!node.IsObject() || depth > GltfMaxNodeDepth)
+                {
+                    DX_LOG(Warning, "GltfLoader", "Invalid node %u in %s.", nodeIndex, m_fileName.c_str());
+                    return false;
+                }
+
+                const Math::Matrix4x4 nodeTransform = parentTransform * GetGltfNodeTransform(node);
+
+                if (const JsonValue* meshIndex = node.Find("mesh"))
+                {
+                    const JsonValue& mesh = m_document.GetArray("meshes")[meshIndex->GetUint(UINT32_MAX)];
+                    const JsonValue* primitives = mesh.Find("primitives");
+                    if (!primitives)
+                    {
+                        DX_LOG(Warning, "GltfLoader", "Invalid mesh in node %u of %s.", nodeIndex, m_fileName.c_str());
+                        return false;
+                    }
+
+                    for (const JsonValue& primitive : primitives->GetElements())
+                    {
+                        if (!ProcessPrimitive(primitive, nodeTransform))
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                if (const JsonValue* children = node.Find("children"))
+                {
+                    for (const JsonValue& child : children->GetElements())
+                    {
+                        if (!ProcessNode(child.GetUint(UINT32_MAX), nodeTransform, depth + 1))
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+        private:
+            const GltfDocument& m_document;
+            MeshData* m_meshData;
+            std::string m_fileName;
+            ThreadPool* m_threadPool;
+
+            // Per primitive scratch, kept to reuse the allocations.
+            std::vector<Math::Vector3> m_positions;
+            std::vector<Math::Vector3> m_normals;
+            std::vector<Math::Vector2> m_uvs;
+            std::vector<Math::Vector3> m_tangents;
+            std::vector<Math::Vector3> m_binormals;
+            std::vector<uint32_t> m_primitiveIndices;
+
+            std::optional<GltfAccessor> GetAttribute(const JsonValue& attributes, std::string_view name) const
+            {
+                const JsonValue* accessorIndex = attributes.Find(name);
+                return accessorIndex ? m_document.GetAccessor(accessorIndex->GetUint(UINT32_MAX)) : std::nullopt;
+            }
+
+            bool ProcessPrimitive(const JsonValue& primitive, const Math::Matrix4x4& transform)
+            {
+                if (const JsonValue* mode = primitive.Find("mode");
+                    mode && mode->GetUint() != GltfTriangles)
+                {
+                    DX_LOG(Verbose, "GltfLoader", "Mesh %s has non-triangle primitives.", m_fileName.c_str());
+                    return false;
+                }
+
+                const JsonValue* attributes = primitive.Find("attributes");
+                if (!attributes)
+                {
+                    return false;
+                }
+
+                const auto positions = GetAttribute(*attributes, "POSITION");
+                const auto normals = GetAttribute(*attributes, "NORMAL");
+                const auto tangents = GetAttribute(*attributes, "TANGENT");
+                const auto uvs = GetAttribute(*attributes, "TEXCOORD_0");
+
+                // Normals are left to Assimp to generate.
+                if (!positions || positions->m_componentType != GltfFloat || positions->m_componentCount != 3 ||
+                    !normals || normals->m_componentType != GltfFloat || normals->m_componentCount != 3 ||
+                    !uvs || uvs->m_componentCount != 2 || (uvs->m_componentType != GltfFloat && !uvs->m_normalized) ||
+                    normals->m_count != positions->m_count || uvs->m_count != positions->m_count)
+                {
+                    DX_LOG(Verbose, "GltfLoader", "Mesh %s is missing supported positions, normals or texture coordinates.", m_fileName.c_str());
+                    return false;
+                }
+
+                const bool hasTangents = tangents.has_value();
+                if (hasTangents &&
+                    (tangents->m_componentType != GltfFloat || tangents->m_componentCount != 4 || tangents->m_count != positions->m_count))
+                {
+                    return false;
+                }
+
+                const uint32_t vertexCount = positions->m_count;
+
+                // Non-indexed primitives draw the vertices in order.
+                m_primitiveIndices.clear();
+                if (const JsonValue* indicesIndex = primitive.Find("indices"))
+                {
+                    const auto indices = m_document.GetAccessor(indicesIndex->GetUint(UINT32_MAX));
+                    if (!indices || indices->m_componentCount != 1 || indices->m_componentType == GltfFloat)
+                    {
+                        return false;
+                    }
+
+                    m_primitiveIndices.resize(indices->m_count);
+                    for (uint32_t i = 0; i < indices->m_count; ++i)
+                    {
+                        m_primitiveIndices[i] = indices->ReadIndex(i);
+                        if (m_primitiveIndices[i] >= vertexCount)
+                        {
+                            DX_LOG(Warning, "GltfLoader", "Mesh %s has indices out of range.", m_fileName.c_str());
+                            return false;
+                        }
+                    }
+                }
+                else
+                {
+                    m_primitiveIndices.resize(vertexCount);
+                    for (uint32_t i = 0; i < vertexCount; ++i)
+                    {
+                        m_primitiveIndices[i] = i;
+                    }
+                }
+                m_primitiveIndices.resize(m_primitiveIndices.size() - m_primitiveIndices.size() % 3);
+
+                // Read the attributes into SIMD vectors.
+                m_positions.resize(vertexCount);
+                m_normals.resize(vertexCount);
+                m_uvs.resize(vertexCount);
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                {
+                    m_positions[i] = positions->ReadVector3(i);
+                    m_normals[i] = normals->ReadVector3(i);
+                    m_uvs[i] = uvs->ReadVector2(i);
+                }
+
+                if (hasTangents)
+                {
+                    // Binormals are defined by the sign in the w component of tangents.
+                    m_tangents.resize(vertexCount);
+                    m_binormals.resize(vertexCount);
+                    for (uint32_t i = 0; i < vertexCount; ++i)
+                    {
+                        const Math::Vector4 tangent = tangents->ReadVector4(i);
+                        m_tangents[i] = tangent.xyz();
+                        m_binormals[i] = Math::Vector3::CrossProduct(m_normals[i], m_tangents[i]) * tangent.w;
+                    }
+                }
+                else
+                {
+                    // Generated once the vertices are transformed.
+                    m_tangents.assign(vertexCount, Math::Vector3(0.0f));
+                    m_binormals.assign(vertexCount, Math::Vector3(0.0f));
+                }
+
+                // glTF is right handed, mirroring the z axis converts it to left handed
+                // after the node transform, as Assimp's ConvertToLeftHanded does.
+                // Directions are transformed without translation nor inverse transpose to match Assimp.
+                Math::Matrix4x4 mirrorZ = Math::Matrix4x4::Identity();
+                mirrorZ(2, 2) = -1.0f;
+                const Math::Matrix4x4 pointTransform = mirrorZ * transform;
+                const Math::Matrix3x3 directionTransform = Math::CreateMatrix3x3FromBasis(
+                    pointTransform.GetColumn(0).xyz(),
+                    pointTransform.GetColumn(1).xyz(),
+                    pointTransform.GetColumn(2).xyz());
+
+                const uint32_t vertexBaseCount = static_cast<uint32_t>(m_meshData->m_vertices.size());
+                const uint32_t indexBaseCount = static_cast<uint32_t>(m_meshData->m_indices.size());
+
+                m_meshData->m_vertices.resize(vertexBaseCount + vertexCount);
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                {
+                    VertexPNTBUv& vertex = m_meshData->m_vertices[vertexBaseCount + i];
+                    (pointTransform * m_positions[i]).Pack(&vertex.m_position);
+                    (directionTransform * m_normals[i]).Pack(&vertex.m_normal);
+                    (directionTransform * m_tangents[i]).Pack(&vertex.m_tangent);
+                    (directionTransform * m_binormals[i]).Pack(&vertex.m_binormal);
+                    // Texture coordinates are already top-left origin, like Assimp leaves them after flipping twice.
+                    m_uvs[i].Pack(&vertex.m_uv);
+                }
+
+                // Exporters often duplicate vertices, they are welded before generating tangents
+                // so all faces sharing position, normal and texture coordinates contribute to the same vertex.
+                const uint32_t weldedVertexCount = WeldVertices(
+                    std::span<VertexPNTBUv>(m_meshData->m_vertices.data() + vertexBaseCount, vertexCount),
+                    m_primitiveIndices, m_threadPool);
+                m_meshData->m_vertices.resize(vertexBaseCount + weldedVertexCount);
+
+                if (!hasTangents)
+                {
+                    // The winding of the primitive indices doesn't change the tangents.
+                    GenerateTangents(std::span<VertexPNTBUv>(m_meshData->m_vertices.data() + vertexBaseCount, weldedVertexCount),
+                        m_primitiveIndices, m_threadPool);
+                }
+
+                // Mirroring flips the winding of the triangles, swap it back.
+                const uint32_t indexCount = static_cast<uint32_t>(m_primitiveIndices.size());
+                m_meshData->m_indices.resize(indexBaseCount + indexCount);
+                for (uint32_t i = 0; i < indexCount; i += 3)
+                {
+                    const uint32_t index = indexBaseCount + i;
+                    m_meshData->m_indices[index + 0] = vertexBaseCount + m_primitiveIndices[i + 2];
+                    m_meshData->m_indices[index + 1] = vertexBaseCount + m_primitiveIndices[i + 1];
+                    m_meshData->m_indices[index + 2] = vertexBaseCount + m_primitiveIndices[i + 0];
+                }
+
+                MeshSubmesh& submesh = m_meshData->m_submeshes.emplace_back();
+                submesh.m_firstIndex = indexBaseCount;
+                submesh.m_indexCount = indexCount;
+                submesh.m_firstVertex = vertexBaseCount;
+                submesh.m_vertexCount = weldedVertexCount;
+                submesh.m_materialIndex = primitive.Find("material") ? primitive.Find("material")->GetUint() : 0;
+
+                return true;
+            }
+        };
+    }
+
+    bool IsGltfFile(const std::filesystem::path& filePath)
+    {
+        const auto extension = filePath.extension();
+        return extension == ".gltf" || extension == ".glb";
+    }
+
+    std::vector<std::filesystem::path> GetGltfBufferPaths(const std::filesystem::path& filePath)
+    {
+        auto file = OpenAssetFile(filePath);
+        if (!file)
+        {
+            return {};
+        }
+
+        std::string_view jsonText;
+        std::span<const uint8_t> binaryChunk;
+        if (!Internal::ReadGltfChunks(filePath, file->GetData(), jsonText, binaryChunk))
+        {
+            return {};
+        }
+
+        const auto json = ParseJson(jsonText);
+        const JsonValue* buffers = json ? json->Find("buffers") : nullptr;
+        if (!buffers)
+        {
+            return {};
+        }
+
+        std::vector<std::filesystem::path> bufferPaths;
+        for (const JsonValue& buffer : buffers->GetElements())
+        {
+            if (const JsonValue* uri = buffer.Find("uri");
+                uri && Internal::IsExternalGltfBuffer(uri->GetString()))
+            {
+                bufferPaths.push_back(filePath.parent_path() / std::filesystem::path(uri->GetString()));
+            }
+        }
+        return bufferPaths;
+    }
+
+    std::unique_ptr<MeshData> LoadGltfMesh(const std::filesystem::path& filePath, ThreadPool* threadPool)
+    {
+        Internal::GltfDocument document;
+        if (!document.Load(filePath))
+        {
+            return nullptr;
+        }
+
+        // Only the default scene is loaded, as Assimp does.
+        const JsonValue& root = document.GetRoot();
+        const uint32_t sceneIndex = root.Find("scene") ? root.Find("scene")->GetUint() : 0;
+        const JsonValue* sceneNodes = document.GetArray("scenes")[sceneIndex].Find("nodes");
+        if (!sceneNodes || sceneNodes->GetSize() == 0)
+        {
+            DX_LOG(Verbose, "GltfLoader", "Mesh %s has no scene nodes.", filePath.filename().generic_string().c_str());
+            return nullptr;
+        }
+
+        auto meshData = std::make_unique<MeshData>();
+
+        Internal::GltfMeshLoader loader(document, meshData.get(), filePath, threadPool);
+        for (const JsonValue& node : sceneNodes->GetElements())
+        {
+            if (!loader.ProcessNode(node.GetUint(UINT32_MAX), Math::Matrix4x4::Identity(), 0))
+            {
+                return nullptr;
+            }
+        }
+
+        if (meshData->m_indices.empty())
+        {
+            return nullptr;
+        }
+
+        return meshData;
+    }
+} // namespace DX
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <filesystem>
+
+namespace DX
+{
+    struct MeshData;
+    class ThreadPool;
+
+    // Returns whether the file is a glTF 2.0 file (.gltf or .glb).
+    bool IsGltfFile(const std::filesystem::path& filePath);
+
+    // Returns the paths of the external binary buffers referenced by a glTF file,
+    // which are part of its source when checking if it changed.
+    std::vector<std::filesystem::path> GetGltfBufferPaths(const std::filesystem::path& filePath);
+
+    // Loads the triangle geometry of a glTF 2.0 file without going through Assimp.
+    //
+    // Buffers are mapped and the accessors are converted straight into the
+    // interleaved vertex stream, producing the same vertices Assimp imports
+    // (left handed, one submesh per primitive). Only positions, normals,
+    // tangents and the first texture coordinates are read.
+    //
+    // Returns null if the file uses something the loader doesn't handle
+    // (embedded buffers, sparse accessors, non-triangle primitives, missing
+    // normals...), in which case the mesh should be imported with Assimp.
+    // Identical vertices are welded like Assimp's JoinIdenticalVertices does and tangents
+    // missing in the file are generated, in parallel when there is a thread pool.
+    std::unique_ptr<MeshData> LoadGltfMesh(const std::filesystem::path& filePath, ThreadPool* threadPool = nullptr);
+} // namespace DX
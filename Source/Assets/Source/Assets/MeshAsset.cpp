@@ -0,0 +1,1019 @@
+#include <Assets/MeshAsset.h>
+#include <Assets/AssetManager.h>
+#include <Assets/GltfLoader.h>
+#include <Assets/MeshCache.h>
+#include <Assets/MeshOptimizer.h>
+#include <Assets/MeshVertexProcessing.h>
+#include <Math/Matrix3x3.h>
+#include <Math/Matrix4x4.h>
+#include <Thread/ThreadPool.h>
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/config.h>
+
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+#include <array>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Set to 0 to import glTF files with Assimp too, to compare import times.
+#ifndef DX_NATIVE_GLTF_LOADER
+#define DX_NATIVE_GLTF_LOADER 1
+#endif
+
+// Set to 1 to import meshes also with Assimp's vertex processing when the native
+// one is used, logging the differences between both results.
+#ifndef DX_VALIDATE_VERTEX_PROCESSING
+#define DX_VALIDATE_VERTEX_PROCESSING 0
+#endif
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Mesh found while walking the node tree, with its world transform
+        // and where its vertices and indices go in the mesh data.
+        struct AssimpMeshInstance
+        {
+            const aiMesh* m_mesh = nullptr;
+            Math::Matrix4x4 m_transform;
+            uint32_t m_firstVertex = 0;
+            uint32_t m_firstIndex = 0;
+        };
+
+        // Range of vertices and faces of a mesh instance converted by one job,
+        // so big meshes are split between workers too.
+        struct AssimpConversionJob
+        {
+            uint32_t m_instanceIndex = 0;
+            uint32_t m_firstVertex = 0; // Relative to the mesh
+            uint32_t m_vertexCount = 0;
+            uint32_t m_firstFace = 0; // Relative to the mesh
+            uint32_t m_faceCount = 0;
+        };
+
+        static constexpr uint32_t AssimpConversionJobSize = 16 * 1024;
+
+        // Flags always passed to Assimp.
+        static constexpr uint32_t AssimpImporterFlags =
+            aiProcess_Triangulate |
+            aiProcess_ConvertToLeftHanded;
+
+        // Flags of the steps done by the native vertex processing instead when
+        // MeshImportSettings::m_assimpVertexProcessing is not set.
+        static constexpr uint32_t AssimpVertexProcessingFlags =
+            aiProcess_GenSmoothNormals |
+            aiProcess_CalcTangentSpace |
+            aiProcess_JoinIdenticalVertices;
+
+        // Without Assimp's vertex processing normals and tangents might be
+        // missing, they are left as zero to be generated afterwards.
+        bool ValidateAssimpMesh(const aiMesh* mesh, bool assimpVertexProcessing)
+        {
+            if (!mesh->HasPositions())
+            {
+                DX_LOG(Error, "MeshAsset", "Mesh %s has no positions\n", mesh->mName.C_Str());
+                return false;
+            }
+            // Use first set of texture coordinates
+            if (!mesh->HasTextureCoords(0))
+            {
+                DX_LOG(Error, "MeshAsset", "Mesh %s has no texture coordinates\n", mesh->mName.C_Str());
+                return false;
+            }
+            if (assimpVertexProcessing && !mesh->HasNormals())
+            {
+                DX_LOG(Error, "MeshAsset", "Mesh %s has no normals\n", mesh->mName.C_Str());
+                return false;
+            }
+            if (assimpVertexProcessing && !mesh->HasTangentsAndBitangents())
+            {
+                DX_LOG(Error, "MeshAsset", "Mesh %s has no tangents and binormals\n", mesh->mName.C_Str());
+                return false;
+            }
+            return true;
+        }
+
+        // Assimp matrices are row major.
+        Math::Matrix4x4 ToMatrix4x4(const aiMatrix4x4& matrix)
+        {
+            Math::Matrix4x4 result;
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int column = 0; column < 4; ++column)
+                {
+                    result(row, column) = matrix[row][column];
+                }
+            }
+            return result;
+        }
+
+        // First phase: walks the node tree calculating the world transform of each mesh
+        // and the offsets of its vertices and indices, so the arrays are sized only once.
+        bool CollectAssimpMeshes(const aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform, bool assimpVertexProcessing,
+            std::vector<AssimpMeshInstance>& instances, uint32_t& vertexCount, uint32_t& indexCount)
+        {
+            // Calculate the node's model transformation
+            const aiMatrix4x4 nodeModelTransform = parentTransform * node->mTransformation;
+
+            for (uint32_t i = 0; i < node->mNumMeshes; i++)
+            {
+                const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+                if (!ValidateAssimpMesh(mesh, assimpVertexProcessing))
+                {
+                    return false;
+                }
+
+                instances.push_back({ mesh, ToMatrix4x4(nodeModelTransform), vertexCount, indexCount });
+                vertexCount += mesh->mNumVertices;
+                indexCount += mesh->mNumFaces * 3;
+            }
+
+            // Recursively process each child node
+            for (unsigned int i = 0; i < node->mNumChildren; i++)
+            {
+                if (!CollectAssimpMeshes(node->mChildren[i], scene, nodeModelTransform, assimpVertexProcessing, instances, vertexCount, indexCount))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Second phase: writes a range of a mesh directly into its place of the
+        // interleaved vertex stream and the index buffer. Ranges don't overlap,
+        // so they are converted in parallel.
+        void ConvertAssimpMeshRange(MeshData* meshData, const AssimpMeshInstance& instance, const AssimpConversionJob& job)
+        {
+            const aiMesh* mesh = instance.m_mesh;
+
+            // Transforms are done with mathfu's SIMD types
+            const Math::Matrix4x4& transform = instance.m_transform;
+            const Math::Matrix3x3 transform3x3 = Math::CreateMatrix3x3FromBasis(
+                transform.GetColumn(0).xyz(),
+                transform.GetColumn(1).xyz(),
+                transform.GetColumn(2).xyz());
+
+            auto toVector3 = [](const aiVector3D& vector)
+            {
+                return Math::Vector3(vector.x, vector.y, vector.z);
+            };
+
+            for (uint32_t i = job.m_firstVertex; i < job.m_firstVertex + job.m_vertexCount; ++i)
+            {
+                VertexPNTBUv& vertex = meshData->m_vertices[instance.m_firstVertex + i];
+                (transform * toVector3(mesh->mVertices[i])).Pack(&vertex.m_position);
+                (mesh->HasNormals() ? transform3x3 * toVector3(mesh->mNormals[i]) : Math::Vector3(0.0f)).Pack(&vertex.m_normal);
+                if (mesh->HasTangentsAndBitangents())
+                {
+                    (transform3x3 * toVector3(mesh->mTangents[i])).Pack(&vertex.m_tangent);
+                    (transform3x3 * toVector3(mesh->mBitangents[i])).Pack(&vertex.m_binormal);
+                }
+                else
+                {
+                    Math::Vector3(0.0f).Pack(&vertex.m_tangent);
+                    Math::Vector3(0.0f).Pack(&vertex.m_binormal);
+                }
+                vertex.m_uv.x = mesh->mTextureCoords[0][i].x;
+                vertex.m_uv.y = mesh->mTextureCoords[0][i].y;
+            }
+
+            for (uint32_t faceIndex = job.m_firstFace; faceIndex < job.m_firstFace + job.m_faceCount; ++faceIndex)
+            {
+                DX_ASSERT(mesh->mFaces[faceIndex].mNumIndices == 3, "MeshAsset", "Mesh face must have 3 indices");
+
+                const uint32_t index = instance.m_firstIndex + faceIndex * 3;
+                meshData->m_indices[index + 0] = instance.m_firstVertex + mesh->mFaces[faceIndex].mIndices[0];
+                meshData->m_indices[index + 1] = instance.m_firstVertex + mesh->mFaces[faceIndex].mIndices[1];
+                meshData->m_indices[index + 2] = instance.m_firstVertex + mesh->mFaces[faceIndex].mIndices[2];
+            }
+        }
+
+        bool ProcessAssimpScene(MeshData* meshData, const aiScene* scene, bool assimpVertexProcessing, ThreadPool* threadPool)
+        {
+            std::vector<AssimpMeshInstance> instances;
+            uint32_t vertexCount = 0;
+            uint32_t indexCount = 0;
+            if (aiMatrix4x4 identityMatrix;
+                !CollectAssimpMeshes(scene->mRootNode, scene, identityMatrix, assimpVertexProcessing, instances, vertexCount, indexCount))
+            {
+                return false;
+            }
+
+            meshData->m_vertices.resize(vertexCount);
+            meshData->m_indices.resize(indexCount);
+            meshData->m_submeshes.resize(instances.size());
+
+            std::vector<AssimpConversionJob> jobs;
+            for (uint32_t instanceIndex = 0; instanceIndex < instances.size(); ++instanceIndex)
+            {
+                const aiMesh* mesh = instances[instanceIndex].m_mesh;
+
+                MeshSubmesh& submesh = meshData->m_submeshes[instanceIndex];
+                submesh.m_firstIndex = instances[instanceIndex].m_firstIndex;
+                submesh.m_indexCount = mesh->mNumFaces * 3;
+                submesh.m_firstVertex = instances[instanceIndex].m_firstVertex;
+                submesh.m_vertexCount = mesh->mNumVertices;
+                submesh.m_materialIndex = mesh->mMaterialIndex;
+
+                const uint32_t jobCount = std::max(
+                    (std::max(mesh->mNumVertices, mesh->mNumFaces) + AssimpConversionJobSize - 1) / AssimpConversionJobSize, 1u);
+                for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+                {
+                    AssimpConversionJob& job = jobs.emplace_back();
+                    job.m_instanceIndex = instanceIndex;
+                    job.m_firstVertex = std::min(jobIndex * AssimpConversionJobSize, mesh->mNumVertices);
+                    job.m_vertexCount = std::min(AssimpConversionJobSize, mesh->mNumVertices - job.m_firstVertex);
+                    job.m_firstFace = std::min(jobIndex * AssimpConversionJobSize, mesh->mNumFaces);
+                    job.m_faceCount = std::min(AssimpConversionJobSize, mesh->mNumFaces - job.m_firstFace);
+                }
+            }
+
+            auto convertJob = [&](uint32_t jobIndex)
+            {
+                const AssimpConversionJob& job = jobs[jobIndex];
+                ConvertAssimpMeshRange(meshData, instances[job.m_instanceIndex], job);
+            };
+
+            if (threadPool && jobs.size() > 1)
+            {
+                threadPool->ParallelFor(static_cast<uint32_t>(jobs.size()), convertJob);
+            }
+            else
+            {
+                for (uint32_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+                {
+                    convertJob(jobIndex);
+                }
+            }
+
+            return true;
+        }
+
+        // Makes indices relative to a different first vertex. Used to process a
+        // submesh alone with only its vertices.
+        void RebaseIndices(std::span<Index> indices, uint32_t fromFirstVertex, uint32_t toFirstVertex)
+        {
+            for (Index& index : indices)
+            {
+                index = index - fromFirstVertex + toFirstVertex;
+            }
+        }
+
+        std::span<Index> GetSubmeshIndices(MeshData* meshData, const MeshSubmesh& submesh)
+        {
+            return std::span<Index>(meshData->m_indices.data() + submesh.m_firstIndex, submesh.m_indexCount);
+        }
+
+        std::span<const VertexPNTBUv> GetSubmeshVertices(const MeshData* meshData, const MeshSubmesh& submesh)
+        {
+            return std::span<const VertexPNTBUv>(meshData->m_vertices.data() + submesh.m_firstVertex, submesh.m_vertexCount);
+        }
+
+        // Vertex ranges after the vertices have been reordered, each submesh
+        // references a contiguous range since submeshes don't share vertices.
+        void CalculateSubmeshVertexRanges(MeshData* meshData)
+        {
+            for (MeshSubmesh& submesh : meshData->m_submeshes)
+            {
+                if (submesh.m_indexCount == 0)
+                {
+                    submesh.m_firstVertex = 0;
+                    submesh.m_vertexCount = 0;
+                    continue;
+                }
+
+                const auto [minIndex, maxIndex] = std::ranges::minmax(GetSubmeshIndices(meshData, submesh));
+                submesh.m_firstVertex = minIndex;
+                submesh.m_vertexCount = maxIndex - minIndex + 1;
+            }
+        }
+
+        void CalculateSubmeshBounds(MeshData* meshData)
+        {
+            for (MeshSubmesh& submesh : meshData->m_submeshes)
+            {
+                const std::span<const VertexPNTBUv> vertices = GetSubmeshVertices(meshData, submesh);
+
+                submesh.m_bounds = CalculateMeshBounds(vertices);
+
+                // Centered in the bounds, with the radius reaching the farthest vertex.
+                const Math::Vector3 center = 0.5f * (Math::Vector3(submesh.m_bounds.m_min) + Math::Vector3(submesh.m_bounds.m_max));
+                float radiusSquared = 0.0f;
+                for (const VertexPNTBUv& vertex : vertices)
+                {
+                    radiusSquared = std::max(radiusSquared, (Math::Vector3(vertex.m_position) - center).LengthSquared());
+                }
+
+                submesh.m_sphereCenter = center;
+                submesh.m_sphereRadius = std::sqrt(radiusSquared);
+            }
+        }
+
+        void OptimizeMesh(MeshData* meshData, [[maybe_unused]] const std::string& meshName)
+        {
+            [[maybe_unused]] const VertexCacheStatistics statisticsBefore =
+                AnalyzeVertexCache(meshData->m_indices, static_cast<uint32_t>(meshData->m_vertices.size()));
+
+            // Triangles are reordered within each submesh, so their index ranges are kept.
+            for (const MeshSubmesh& submesh : meshData->m_submeshes)
+            {
+                const std::span<Index> indices = GetSubmeshIndices(meshData, submesh);
+
+                RebaseIndices(indices, submesh.m_firstVertex, 0);
+                OptimizeVertexCache(indices, submesh.m_vertexCount);
+                OptimizeOverdraw(indices, GetSubmeshVertices(meshData, submesh));
+                RebaseIndices(indices, 0, submesh.m_firstVertex);
+            }
+
+            OptimizeVertexFetch(meshData->m_vertices, meshData->m_indices);
+            CalculateSubmeshVertexRanges(meshData);
+
+            [[maybe_unused]] const VertexCacheStatistics statisticsAfter =
+                AnalyzeVertexCache(meshData->m_indices, static_cast<uint32_t>(meshData->m_vertices.size()));
+
+            DX_LOG(Info, "MeshAsset", "Mesh %s optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%zu vertices, %zu triangles).",
+                meshName.c_str(),
+                statisticsBefore.m_acmr, statisticsAfter.m_acmr,
+                statisticsBefore.m_atvr, statisticsAfter.m_atvr,
+                meshData->m_vertices.size(), meshData->m_indices.size() / 3);
+        }
+
+        // Native version of Assimp's GenSmoothNormals, JoinIdenticalVertices and CalcTangentSpace.
+        // Submeshes are processed in parallel with their own vertices and packed
+        // together again afterwards, since welding removes vertices.
+        // Calls func(submeshIndex) for each submesh, in parallel when there is a thread pool.
+        void ForEachSubmesh(ThreadPool* threadPool, uint32_t submeshCount, const std::function<void(uint32_t submeshIndex)>& func)
+        {
+            if (threadPool && submeshCount > 1)
+            {
+                threadPool->ParallelFor(submeshCount, func);
+            }
+            else
+            {
+                for (uint32_t submeshIndex = 0; submeshIndex < submeshCount; ++submeshIndex)
+                {
+                    func(submeshIndex);
+                }
+            }
+        }
+
+        void ProcessMeshVertices(MeshData* meshData, ThreadPool* threadPool)
+        {
+            const uint32_t submeshCount = static_cast<uint32_t>(meshData->m_submeshes.size());
+
+            std::vector<uint32_t> weldedVertexCounts(submeshCount);
+            ForEachSubmesh(threadPool, submeshCount, [&](uint32_t submeshIndex)
+                {
+                    const MeshSubmesh& submesh = meshData->m_submeshes[submeshIndex];
+                    const std::span<Index> indices = GetSubmeshIndices(meshData, submesh);
+                    const std::span<VertexPNTBUv> vertices(meshData->m_vertices.data() + submesh.m_firstVertex, submesh.m_vertexCount);
+
+                    RebaseIndices(indices, submesh.m_firstVertex, 0);
+
+                    GenerateSmoothNormals(vertices, indices, threadPool);
+
+                    // Tangents are generated after welding, so all faces sharing
+                    // position, normal and texture coordinates contribute to the same vertex.
+                    weldedVertexCounts[submeshIndex] = WeldVertices(vertices, indices, threadPool);
+                    GenerateTangents(vertices.first(weldedVertexCounts[submeshIndex]), indices, threadPool);
+                });
+
+            // Destination ranges never start after their source, so vertices are moved forward in order.
+            uint32_t vertexCount = 0;
+            for (uint32_t submeshIndex = 0; submeshIndex < submeshCount; ++submeshIndex)
+            {
+                MeshSubmesh& submesh = meshData->m_submeshes[submeshIndex];
+                const auto submeshVertices = meshData->m_vertices.begin() + submesh.m_firstVertex;
+                std::copy(submeshVertices, submeshVertices + weldedVertexCounts[submeshIndex], meshData->m_vertices.begin() + vertexCount);
+
+                submesh.m_firstVertex = vertexCount;
+                submesh.m_vertexCount = weldedVertexCounts[submeshIndex];
+                vertexCount += submesh.m_vertexCount;
+            }
+            meshData->m_vertices.resize(vertexCount);
+            meshData->m_vertices.shrink_to_fit();
+
+            ForEachSubmesh(threadPool, submeshCount, [meshData](uint32_t submeshIndex)
+                {
+                    const MeshSubmesh& submesh = meshData->m_submeshes[submeshIndex];
+                    RebaseIndices(GetSubmeshIndices(meshData, submesh), 0, submesh.m_firstVertex);
+                });
+        }
+
+#if DX_VALIDATE_VERTEX_PROCESSING
+        float AngleInDegrees(const Math::Vector3Packed& vectorA, const Math::Vector3Packed& vectorB)
+        {
+            const float cosAngle = Math::Vector3::DotProduct(
+                Math::Vector3(vectorA).Normalized(), Math::Vector3(vectorB).Normalized());
+            return std::acos(std::clamp(cosAngle, -1.0f, 1.0f)) * 180.0f / 3.14159265f;
+        }
+
+        // Compares the vertices of every face corner of a mesh processed natively with the same mesh
+        // processed by Assimp. Both come from the same faces in the same order, so corners match.
+        void ValidateVertexProcessing(const MeshData& meshData, const MeshData& assimpMeshData, [[maybe_unused]] const std::string& meshName)
+        {
+            if (meshData.m_indices.size() != assimpMeshData.m_indices.size())
+            {
+                DX_LOG(Warning, "MeshAsset", "Mesh %s vertex processing validation: %zu indices, Assimp has %zu.",
+                    meshName.c_str(), meshData.m_indices.size(), assimpMeshData.m_indices.size());
+                return;
+            }
+
+            static constexpr float MaxTangentAngle = 10.0f; // In degrees
+
+            float maxPositionError = 0.0f;
+            float maxNormalAngle = 0.0f;
+            float maxTangentAngle = 0.0f;
+            uint32_t tangentMismatchCount = 0;
+            uint32_t handednessMismatchCount = 0;
+            for (size_t i = 0; i < meshData.m_indices.size(); ++i)
+            {
+                const VertexPNTBUv& vertex = meshData.m_vertices[meshData.m_indices[i]];
+                const VertexPNTBUv& assimpVertex = assimpMeshData.m_vertices[assimpMeshData.m_indices[i]];
+
+                maxPositionError = std::max(maxPositionError,
+                    (Math::Vector3(vertex.m_position) - Math::Vector3(assimpVertex.m_position)).Length());
+                maxNormalAngle = std::max(maxNormalAngle, AngleInDegrees(vertex.m_normal, assimpVertex.m_normal));
+
+                const float tangentAngle = AngleInDegrees(vertex.m_tangent, assimpVertex.m_tangent);
+                maxTangentAngle = std::max(maxTangentAngle, tangentAngle);
+                tangentMismatchCount += (tangentAngle > MaxTangentAngle) ? 1 : 0;
+                handednessMismatchCount += (AngleInDegrees(vertex.m_binormal, assimpVertex.m_binormal) > 90.0f) ? 1 : 0;
+            }
+
+            DX_LOG(Info, "MeshAsset", "Mesh %s vertex processing validation: %zu vertices (Assimp %zu), "
+                "max position error %g, max normal angle %.2f deg, max tangent angle %.2f deg, "
+                "%u of %zu corners with tangents more than %.0f deg apart, %u with opposite handedness.",
+                meshName.c_str(), meshData.m_vertices.size(), assimpMeshData.m_vertices.size(),
+                maxPositionError, maxNormalAngle, maxTangentAngle,
+                tangentMismatchCount, meshData.m_indices.size(), MaxTangentAngle, handednessMismatchCount);
+        }
+#endif
+
+        static constexpr uint32_t MaxLodCount = 4; // Including full detail
+        static constexpr float LodIndexCountReduction = 0.5f; // Each level targets half the triangles of the previous one
+        static constexpr float LodMinIndexCountReduction = 0.8f; // Levels that don't reduce at least this much are discarded
+        static constexpr float LodMaxError = 0.02f; // Relative to mesh size
+
+        void GenerateLods(MeshData* meshData, [[maybe_unused]] const std::string& meshName)
+        {
+            const uint32_t baseIndexCount = static_cast<uint32_t>(meshData->m_indices.size());
+            const size_t submeshCount = meshData->m_submeshes.size();
+
+            meshData->m_lods = { MeshLod{ 0, baseIndexCount, 0.0f } };
+            meshData->m_submeshLods.clear();
+            for (const MeshSubmesh& submesh : meshData->m_submeshes)
+            {
+                meshData->m_submeshLods.push_back(MeshLod{ submesh.m_firstIndex, submesh.m_indexCount, 0.0f });
+            }
+
+            // Every level is simplified from the full detail mesh, so the error is not accumulated.
+            // Submeshes are simplified separately, the ones that cannot be simplified
+            // further repeat the indices of the previous level.
+            while (meshData->m_lods.size() < MaxLodCount)
+            {
+                const MeshLod previousLod = meshData->m_lods.back();
+                const uint32_t previousLodIndex = static_cast<uint32_t>(meshData->m_lods.size() - 1);
+
+                float lodError = 0.0f;
+                std::vector<Index> lodIndices;
+                std::vector<MeshLod> submeshLods;
+                for (uint32_t submeshIndex = 0; submeshIndex < submeshCount; ++submeshIndex)
+                {
+                    const MeshSubmesh& submesh = meshData->m_submeshes[submeshIndex];
+                    const MeshLod previousSubmeshLod = meshData->GetSubmeshLod(previousLodIndex, submeshIndex);
+                    const size_t targetIndexCount = static_cast<size_t>(previousSubmeshLod.m_indexCount * LodIndexCountReduction) / 3 * 3;
+
+                    std::vector<Index> submeshIndices(
+                        meshData->m_indices.begin() + submesh.m_firstIndex,
+                        meshData->m_indices.begin() + submesh.m_firstIndex + submesh.m_indexCount);
+                    RebaseIndices(submeshIndices, submesh.m_firstVertex, 0);
+
+                    float submeshError = 0.0f;
+                    std::vector<Index> simplifiedIndices = SimplifyMesh(
+                        submeshIndices, GetSubmeshVertices(meshData, submesh), targetIndexCount, LodMaxError, &submeshError);
+
+                    MeshLod submeshLod;
+                    submeshLod.m_firstIndex = static_cast<uint32_t>(meshData->m_indices.size() + lodIndices.size());
+                    if (simplifiedIndices.empty() ||
+                        simplifiedIndices.size() > previousSubmeshLod.m_indexCount * LodMinIndexCountReduction)
+                    {
+                        lodIndices.insert(lodIndices.end(),
+                            meshData->m_indices.begin() + previousSubmeshLod.m_firstIndex,
+                            meshData->m_indices.begin() + previousSubmeshLod.m_firstIndex + previousSubmeshLod.m_indexCount);
+                        submeshLod.m_indexCount = previousSubmeshLod.m_indexCount;
+                        submeshLod.m_error = previousSubmeshLod.m_error;
+                    }
+                    else
+                    {
+                        OptimizeVertexCache(simplifiedIndices, submesh.m_vertexCount);
+                        RebaseIndices(simplifiedIndices, 0, submesh.m_firstVertex);
+
+                        lodIndices.insert(lodIndices.end(), simplifiedIndices.begin(), simplifiedIndices.end());
+                        submeshLod.m_indexCount = static_cast<uint32_t>(simplifiedIndices.size());
+                        submeshLod.m_error = submeshError;
+                    }
+
+                    lodError = std::max(lodError, submeshLod.m_error);
+                    submeshLods.push_back(submeshLod);
+                }
+
+                if (lodIndices.size() > previousLod.m_indexCount * LodMinIndexCountReduction)
+                {
+                    break;
+                }
+
+                const MeshLod lod = { static_cast<uint32_t>(meshData->m_indices.size()), static_cast<uint32_t>(lodIndices.size()), lodError };
+                meshData->m_indices.insert(meshData->m_indices.end(), lodIndices.begin(), lodIndices.end());
+                meshData->m_lods.push_back(lod);
+                meshData->m_submeshLods.insert(meshData->m_submeshLods.end(), submeshLods.begin(), submeshLods.end());
+
+                DX_LOG(Verbose, "MeshAsset", "Mesh %s LOD %zu: %u triangles, error %f.",
+                    meshName.c_str(), meshData->m_lods.size() - 1, lod.m_indexCount / 3, lod.m_error);
+            }
+
+            DX_LOG(Info, "MeshAsset", "Mesh %s generated %zu levels of detail.", meshName.c_str(), meshData->m_lods.size());
+        }
+
+        void BuildMeshlets(MeshData* meshData, [[maybe_unused]] const std::string& meshName)
+        {
+            // Only the full detail level is partitioned, each submesh on its own
+            // so meshlets don't mix triangles of different submeshes.
+            uint32_t indexCount = 0;
+            MeshletData& meshletData = meshData->m_meshletData;
+            meshletData = {};
+            for (MeshSubmesh& submesh : meshData->m_submeshes)
+            {
+                MeshletData submeshMeshletData = DX::BuildMeshlets(GetSubmeshIndices(meshData, submesh), meshData->m_vertices);
+
+                const uint32_t vertexOffset = static_cast<uint32_t>(meshletData.m_meshletVertices.size());
+                const uint32_t triangleOffset = static_cast<uint32_t>(meshletData.m_meshletTriangles.size());
+                for (Meshlet& meshlet : submeshMeshletData.m_meshlets)
+                {
+                    meshlet.m_vertexOffset += vertexOffset;
+                    meshlet.m_triangleOffset += triangleOffset;
+                }
+
+                submesh.m_firstMeshlet = static_cast<uint32_t>(meshletData.m_meshlets.size());
+                submesh.m_meshletCount = static_cast<uint32_t>(submeshMeshletData.m_meshlets.size());
+                indexCount += submesh.m_indexCount;
+
+                meshletData.m_meshlets.insert(meshletData.m_meshlets.end(),
+                    submeshMeshletData.m_meshlets.begin(), submeshMeshletData.m_meshlets.end());
+                meshletData.m_meshletVertices.insert(meshletData.m_meshletVertices.end(),
+                    submeshMeshletData.m_meshletVertices.begin(), submeshMeshletData.m_meshletVertices.end());
+                meshletData.m_meshletTriangles.insert(meshletData.m_meshletTriangles.end(),
+                    submeshMeshletData.m_meshletTriangles.begin(), submeshMeshletData.m_meshletTriangles.end());
+            }
+
+            DX_LOG(Info, "MeshAsset", "Mesh %s partitioned in %zu meshlets (%.1f vertices and %.1f triangles per meshlet on average).",
+                meshName.c_str(),
+                meshData->m_meshletData.m_meshlets.size(),
+                static_cast<float>(meshData->m_meshletData.m_meshletVertices.size()) / std::max<size_t>(meshData->m_meshletData.m_meshlets.size(), 1),
+                static_cast<float>(indexCount / 3) / std::max<size_t>(meshData->m_meshletData.m_meshlets.size(), 1));
+        }
+
+        void CompactMesh(MeshData* meshData, [[maybe_unused]] const std::string& meshName)
+        {
+            meshData->m_compactVertices = QuantizeVertices(meshData->m_vertices, meshData->m_bounds);
+
+            [[maybe_unused]] const QuantizationError error =
+                CalculateQuantizationError(meshData->m_vertices, meshData->m_compactVertices, meshData->m_bounds);
+
+            DX_LOG(Info, "MeshAsset", "Mesh %s vertices compacted from %.1f KB to %.1f KB. Max error: position %f, normal %.2f degrees, uv %f.",
+                meshName.c_str(),
+                meshData->m_vertices.size() * sizeof(VertexPNTBUv) / 1024.0f,
+                meshData->m_compactVertices.size() * sizeof(VertexCompact) / 1024.0f,
+                error.m_maxPositionError, error.m_maxNormalErrorDegrees, error.m_maxUvError);
+
+            // Only the compact vertices are kept
+            meshData->m_vertexFormat = VertexFormat::Compact;
+            meshData->m_vertices.clear();
+            meshData->m_vertices.shrink_to_fit();
+        }
+
+        // Assimp stream reading an asset file from the mounted asset pack or the assets folder.
+        class AssetFileIOStream : public Assimp::IOStream
+        {
+        public:
+            explicit AssetFileIOStream(AssetFile assetFile)
+                : m_assetFile(std::move(assetFile))
+            {
+            }
+
+            size_t Read(void* buffer, size_t size, size_t count) override
+            {
+                const auto data = m_assetFile.GetData();
+                if (size == 0)
+                {
+                    return 0;
+                }
+
+                const size_t readCount = std::min(count, (data.size() - m_position) / size);
+                if (readCount > 0)
+                {
+                    std::memcpy(buffer, data.data() + m_position, readCount * size);
+                    m_position += readCount * size;
+                }
+                return readCount;
+            }
+
+            size_t Write(const void*, size_t, size_t) override
+            {
+                return 0;
+            }
+
+            aiReturn Seek(size_t offset, aiOrigin origin) override
+            {
+                const size_t fileSize = m_assetFile.GetData().size();
+                size_t position = 0;
+                switch (origin)
+                {
+                case aiOrigin_SET: position = offset; break;
+                case aiOrigin_CUR: position = m_position + offset; break;
+                case aiOrigin_END: position = fileSize - offset; break;
+                default: return aiReturn_FAILURE;
+                }
+
+                if (position > fileSize)
+                {
+                    return aiReturn_FAILURE;
+                }
+                m_position = position;
+                return aiReturn_SUCCESS;
+            }
+
+            size_t Tell() const override
+            {
+                return m_position;
+            }
+
+            size_t FileSize() const override
+            {
+                return m_assetFile.GetData().size();
+            }
+
+            void Flush() override
+            {
+            }
+
+        private:
+            AssetFile m_assetFile;
+            size_t m_position = 0;
+        };
+
+        // Assimp file system resolving the mesh and its dependencies (gltf buffers,
+        // obj materials...) against the mounted asset pack before the assets folder.
+        class AssetFileIOSystem : public Assimp::IOSystem
+        {
+        public:
+            bool Exists(const char* filePath) const override
+            {
+                return AssetFileExists(filePath);
+            }
+
+            char getOsSeparator() const override
+            {
+                return '/';
+            }
+
+            Assimp::IOStream* Open(const char* filePath, const char* mode) override
+            {
+                // Asset files are read-only
+                if (std::strchr(mode, 'w') || std::strchr(mode, 'a'))
+                {
+                    return nullptr;
+                }
+
+                auto assetFile = OpenAssetFile(filePath);
+                if (!assetFile)
+                {
+                    return nullptr;
+                }
+                return new AssetFileIOStream(std::move(*assetFile));
+            }
+
+            void Close(Assimp::IOStream* stream) override
+            {
+                delete stream;
+            }
+        };
+
+        // Post-processing steps in the order Assimp runs them, applying them one
+        // at a time gives the same scene as passing all of them to ReadFile.
+        struct AssimpPostProcessStage
+        {
+            uint32_t m_flags;
+            const char* m_name;
+        };
+
+        static constexpr std::array AssimpPostProcessStages =
+        {
+            AssimpPostProcessStage{ aiProcess_ConvertToLeftHanded, "ConvertToLeftHanded" },
+            AssimpPostProcessStage{ aiProcess_Triangulate, "Triangulate" },
+            AssimpPostProcessStage{ aiProcess_GenSmoothNormals, "GenSmoothNormals" },
+            AssimpPostProcessStage{ aiProcess_CalcTangentSpace, "CalcTangentSpace" },
+            AssimpPostProcessStage{ aiProcess_JoinIdenticalVertices, "JoinIdenticalVertices" }
+        };
+
+        // Constructing an importer registers all its file importers and post-processing
+        // steps, so each thread keeps one and reuses it for all the meshes it imports.
+        // Only the FBX and glTF importers are built (see FetchLibraries.cmake).
+        Assimp::Importer& GetThreadAssimpImporter()
+        {
+            thread_local std::unique_ptr<Assimp::Importer> ThreadImporter;
+            if (!ThreadImporter)
+            {
+                ThreadImporter = std::make_unique<Assimp::Importer>();
+
+                // The importer takes ownership of the IO system.
+                ThreadImporter->SetIOHandler(new AssetFileIOSystem());
+
+                // Only the geometry of the scene is used.
+                ThreadImporter->SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_ANIMATIONS, false);
+                ThreadImporter->SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_CAMERAS, false);
+                ThreadImporter->SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_LIGHTS, false);
+            }
+            return *ThreadImporter;
+        }
+
+        std::unique_ptr<MeshData> ImportAssimpMesh(const std::filesystem::path& filePath, uint32_t importerFlags, ThreadPool* threadPool)
+        {
+            Assimp::Importer& importer = GetThreadAssimpImporter();
+
+            auto stageStartTime = std::chrono::steady_clock::now();
+            auto measureStage = [&stageStartTime]()
+            {
+                const auto now = std::chrono::steady_clock::now();
+                const float stageTimeMs = std::chrono::duration<float, std::milli>(now - stageStartTime).count();
+                stageStartTime = now;
+                return stageTimeMs;
+            };
+
+            // Time of each stage, logged when the import finishes.
+            std::string stageTimes;
+            auto appendStageTime = [&stageTimes](const char* stageName, float stageTimeMs)
+            {
+                char stageTime[64];
+                std::snprintf(stageTime, sizeof(stageTime), "%s%s %.2f ms", stageTimes.empty() ? "" : ", ", stageName, stageTimeMs);
+                stageTimes += stageTime;
+            };
+
+            const aiScene* scene = importer.ReadFile(filePath.generic_string(), 0);
+
+            if (!scene || 
+                !scene->mRootNode ||
+                scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
+            {
+                DX_LOG(Error, "MeshAsset", "Assimp failed to import mesh: %s\n\nError message: %s\n", 
+                    filePath.generic_string().c_str(), importer.GetErrorString());
+                importer.FreeScene();
+                return nullptr;
+            }
+            appendStageTime("Read", measureStage());
+
+            [[maybe_unused]] uint32_t appliedFlags = 0;
+            for (const AssimpPostProcessStage& stage : AssimpPostProcessStages)
+            {
+                if ((importerFlags & stage.m_flags) == 0)
+                {
+                    continue;
+                }
+
+                scene = importer.ApplyPostProcessing(stage.m_flags);
+                if (!scene)
+                {
+                    DX_LOG(Error, "MeshAsset", "Assimp failed to post-process mesh: %s\n\nError message: %s\n",
+                        filePath.generic_string().c_str(), importer.GetErrorString());
+                    importer.FreeScene();
+                    return nullptr;
+                }
+                appendStageTime(stage.m_name, measureStage());
+                appliedFlags |= stage.m_flags;
+            }
+            DX_ASSERT(appliedFlags == importerFlags, "MeshAsset", "Importer flags without post-processing stage");
+
+            if (!scene->HasMeshes())
+            {
+                DX_LOG(Error, "MeshAsset", "Assimp failed to import mesh: %s\n\nError message: %s\n",
+                    filePath.generic_string().c_str(), importer.GetErrorString());
+                importer.FreeScene();
+                return nullptr;
+            }
+
+            auto meshData = std::make_unique<MeshData>();
+
+            const bool assimpVertexProcessing = (importerFlags & AssimpVertexProcessingFlags) == AssimpVertexProcessingFlags;
+            const bool processed = Internal::ProcessAssimpScene(meshData.get(), scene, assimpVertexProcessing, threadPool);
+
+            // The scene is not needed anymore, release it now instead of on the next import.
+            importer.FreeScene();
+
+            if (!processed)
+            {
+                DX_LOG(Error, "MeshAsset", "Assimp failed to process mesh: %s",
+                    filePath.generic_string().c_str());
+                return nullptr;
+            }
+            appendStageTime("Convert", measureStage());
+
+            if (!assimpVertexProcessing)
+            {
+                ProcessMeshVertices(meshData.get(), threadPool);
+                appendStageTime("NativeVertexProcessing", measureStage());
+            }
+
+            DX_LOG(Verbose, "MeshAsset", "Mesh %s Assimp stages: %s.",
+                filePath.filename().generic_string().c_str(), stageTimes.c_str());
+
+            return meshData;
+        }
+    }
+
+    namespace Internal
+    {
+        static std::atomic<size_t> ResidentMeshDataSize = 0;
+    }
+
+    MeshAsset::MeshAsset(AssetId assetId, std::unique_ptr<MeshData> data)
+        : Super(assetId, std::move(data))
+    {
+        Internal::ResidentMeshDataSize += m_data->GetSizeInBytes();
+    }
+
+    MeshAsset::~MeshAsset()
+    {
+        Internal::ResidentMeshDataSize -= m_data->GetSizeInBytes();
+    }
+
+    size_t MeshAsset::GetResidentDataSize()
+    {
+        return Internal::ResidentMeshDataSize;
+    }
+
+    uint32_t MeshImportSettings::ToFlags() const
+    {
+        uint32_t flags = 0;
+        flags |= m_optimize ? (1 << 0) : 0;
+        flags |= m_compactVertices ? (1 << 1) : 0;
+        flags |= m_generateLods ? (1 << 2) : 0;
+        flags |= m_buildMeshlets ? (1 << 3) : 0;
+        flags |= m_assimpVertexProcessing ? (1 << 4) : 0;
+        return flags;
+    }
+
+    MeshImportSettings MeshImportSettings::FromFlags(uint32_t flags)
+    {
+        MeshImportSettings settings;
+        settings.m_optimize = (flags & (1 << 0)) != 0;
+        settings.m_compactVertices = (flags & (1 << 1)) != 0;
+        settings.m_generateLods = (flags & (1 << 2)) != 0;
+        settings.m_buildMeshlets = (flags & (1 << 3)) != 0;
+        settings.m_assimpVertexProcessing = (flags & (1 << 4)) != 0;
+        return settings;
+    }
+
+    std::shared_ptr<MeshAsset> MeshAsset::LoadMeshAsset(const std::string& fileName, const MeshImportSettings& settings)
+    {
+        return DX::AssetManager::Get().LoadAssetAs<MeshAsset>(
+            fileName, 
+            std::bind(&MeshAsset::LoadMesh, std::placeholders::_1, settings, std::placeholders::_2), settings.ToFlags());
+    }
+
+    AssetLoadHandle<MeshAsset> MeshAsset::LoadMeshAssetAsync(const std::string& fileName, const MeshImportSettings& settings)
+    {
+        return DX::AssetManager::Get().LoadAssetAsync<MeshAsset>(
+            fileName,
+            std::bind(&MeshAsset::LoadMesh, std::placeholders::_1, settings, std::placeholders::_2), settings.ToFlags());
+    }
+
+    AssetLoadHandle<MeshAsset> MeshAsset::ReloadMeshAssetAsync(const std::string& fileName, const MeshImportSettings& settings)
+    {
+        return DX::AssetManager::Get().ReloadAssetAsync<MeshAsset>(
+            fileName,
+            std::bind(&MeshAsset::LoadMesh, std::placeholders::_1, settings, std::placeholders::_2));
+    }
+
+    bool MeshAsset::CookMeshAsset(const std::string& fileName, const MeshImportSettings& settings, ThreadPool* threadPool)
+    {
+        return LoadMesh(GetAssetPath() / fileName, settings, threadPool) != nullptr;
+    }
+
+    std::unique_ptr<MeshData> MeshAsset::LoadMesh(const std::filesystem::path& fileNamePath, const MeshImportSettings& settings, ThreadPool* threadPool)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        const uint32_t importerFlags = settings.m_assimpVertexProcessing
+            ? Internal::AssimpImporterFlags | Internal::AssimpVertexProcessingFlags
+            : Internal::AssimpImporterFlags;
+
+        // Warm path: use the cooked mesh from cache when it's up to date with the source.
+        const auto sourceHash = HashMeshSource(fileNamePath);
+        const auto cookedPath = GetCookedMeshPath(fileNamePath);
+        const MeshCacheKey cacheKey{ sourceHash.value_or(0), importerFlags, settings.ToFlags() };
+
+        if (sourceHash.has_value())
+        {
+            if (auto cookedMesh = LoadCookedMesh(cookedPath, cacheKey, threadPool))
+            {
+                [[maybe_unused]] const float loadTimeMs =
+                    std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+                DX_LOG(Info, "MeshAsset", "Mesh %s loaded from cooked cache in %.2f ms (cold import took %.2f ms).",
+                    fileNamePath.filename().generic_string().c_str(), loadTimeMs, cookedMesh->m_importTimeMs);
+
+                return std::move(cookedMesh->m_meshData);
+            }
+        }
+
+        // Cold path: import the source and cook the result.
+        // glTF files are read by the native loader, which leaves to Assimp those it can't handle.
+        // The native loader does its own vertex processing, so it's skipped when Assimp's is requested.
+        std::unique_ptr<MeshData> meshData;
+        [[maybe_unused]] const char* importerName = "Assimp";
+#if DX_NATIVE_GLTF_LOADER
+        if (IsGltfFile(fileNamePath) && !settings.m_assimpVertexProcessing)
+        {
+            meshData = LoadGltfMesh(fileNamePath, threadPool);
+            if (meshData)
+            {
+                importerName = "glTF loader";
+            }
+        }
+#endif
+        if (!meshData)
+        {
+            meshData = Internal::ImportAssimpMesh(fileNamePath, importerFlags, threadPool);
+            if (!meshData)
+            {
+                return nullptr;
+            }
+
+#if DX_VALIDATE_VERTEX_PROCESSING
+            if (!settings.m_assimpVertexProcessing)
+            {
+                if (auto assimpMeshData = Internal::ImportAssimpMesh(fileNamePath, importerFlags | Internal::AssimpVertexProcessingFlags, threadPool))
+                {
+                    Internal::ValidateVertexProcessing(*meshData, *assimpMeshData, fileNamePath.filename().generic_string());
+                }
+            }
+#endif
+        }
+
+        [[maybe_unused]] const float readTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        if (settings.m_optimize)
+        {
+            Internal::OptimizeMesh(meshData.get(), fileNamePath.filename().generic_string());
+        }
+
+        meshData->m_bounds = CalculateMeshBounds(meshData->m_vertices);
+        Internal::CalculateSubmeshBounds(meshData.get());
+
+        DX_LOG(Verbose, "MeshAsset", "Mesh %s has %zu submeshes.",
+            fileNamePath.filename().generic_string().c_str(), meshData->m_submeshes.size());
+
+        if (settings.m_generateLods)
+        {
+            Internal::GenerateLods(meshData.get(), fileNamePath.filename().generic_string());
+        }
+
+        if (settings.m_buildMeshlets)
+        {
+            Internal::BuildMeshlets(meshData.get(), fileNamePath.filename().generic_string());
+        }
+
+        if (settings.m_compactVertices)
+        {
+            Internal::CompactMesh(meshData.get(), fileNamePath.filename().generic_string());
+        }
+
+        const float importTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        DX_LOG(Info, "MeshAsset", "Mesh %s imported with %s in %.2f ms (geometry read in %.2f ms).",
+            fileNamePath.filename().generic_string().c_str(), importerName, importTimeMs, readTimeMs);
+
+        if (sourceHash.has_value())
+        {
+            SaveCookedMesh(cookedPath, cacheKey, *meshData, importTimeMs, threadPool);
+        }
+
+        return meshData;
+    }
+} // namespace DX
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <Assets/Asset.h>
+#include <Assets/AssetManager.h>
+#include <Assets/MeshQuantization.h>
+#include <Assets/Meshlet.h>
+#include <Assets/Vertices.h>
+#include <Math/Vector2.h>
+#include <Math/Vector3.h>
+
+#include <vector>
+#include <filesystem>
+
+namespace DX
+{
+    // Range of indices with a level of detail of the mesh.
+    // All levels of detail share the same vertices.
+    struct MeshLod
+    {
+        uint32_t m_firstIndex = 0;
+        uint32_t m_indexCount = 0;
+        float m_error = 0.0f; // Simplification error relative to the mesh size
+    };
+
+    // Part of a mesh imported from the same source mesh, with a single material.
+    // Submeshes can be culled and drawn independently.
+    struct MeshSubmesh
+    {
+        // Indices of the full detail level and the vertices they reference.
+        uint32_t m_firstIndex = 0;
+        uint32_t m_indexCount = 0;
+        uint32_t m_firstVertex = 0;
+        uint32_t m_vertexCount = 0;
+
+        // Material slot of the source file.
+        uint32_t m_materialIndex = 0;
+
+        // Meshlets of the submesh. Zero when meshlets were not built.
+        uint32_t m_firstMeshlet = 0;
+        uint32_t m_meshletCount = 0;
+
+        // Bounding volumes in object space.
+        MeshBounds m_bounds = {};
+        Math::Vector3Packed m_sphereCenter;
+        float m_sphereRadius = 0.0f;
+    };
+
+    struct MeshData
+    {
+        // Format of the vertex stream uploaded to the vertex buffer.
+        // Only the vertices of this format are filled.
+        VertexFormat m_vertexFormat = VertexFormat::PNTBUv;
+
+        // Interleaved vertex streams, ready to be uploaded to a vertex buffer.
+        std::vector<VertexPNTBUv> m_vertices;
+        std::vector<VertexCompact> m_compactVertices;
+        std::vector<Index> m_indices;
+
+        // Levels of detail, from full detail (level 0) to the most simplified.
+        // Their indices are stored one after the other in m_indices.
+        // Empty when levels of detail were not generated.
+        std::vector<MeshLod> m_lods;
+
+        // Submeshes in the order they were found in the source file. The vertices and
+        // indices of each submesh are contiguous, there is always at least one.
+        std::vector<MeshSubmesh> m_submeshes;
+
+        // Indices of each submesh in each level of detail, all submeshes of level 0
+        // first, then all submeshes of level 1 and so on. Use GetSubmeshLod to access them.
+        // The indices of a level are the indices of its submeshes one after the other.
+        // Empty when levels of detail were not generated.
+        std::vector<MeshLod> m_submeshLods;
+
+        // Bounds of the vertex positions. Needed to decode compact vertex positions.
+        MeshBounds m_bounds = {};
+
+        // Meshlets of the full detail level. Empty when meshlets were not built.
+        MeshletData m_meshletData;
+
+        const MeshLod& GetSubmeshLod(uint32_t lodIndex, uint32_t submeshIndex) const
+        {
+            return m_submeshLods[lodIndex * m_submeshes.size() + submeshIndex];
+        }
+
+        uint32_t GetVertexCount() const
+        {
+            return static_cast<uint32_t>((m_vertexFormat == VertexFormat::Compact) ? m_compactVertices.size() : m_vertices.size());
+        }
+
+        size_t GetSizeInBytes() const
+        {
+            return m_vertices.size() * sizeof(VertexPNTBUv) +
+                m_compactVertices.size() * sizeof(VertexCompact) +
+                m_indices.size() * sizeof(Index) +
+                m_submeshes.size() * sizeof(MeshSubmesh) +
+                m_submeshLods.size() * sizeof(MeshLod) +
+                m_meshletData.m_meshlets.size() * sizeof(Meshlet) +
+                m_meshletData.m_meshletVertices.size() * sizeof(uint32_t) +
+                m_meshletData.m_meshletTriangles.size() * sizeof(uint8_t);
+        }
+    };
+
+    // Options applied when importing a mesh from its source file.
+    struct MeshImportSettings
+    {
+        // Reorders triangles and vertices to improve the efficiency of
+        // the GPU vertex cache, overdraw and vertex fetching.
+        bool m_optimize = true;
+
+        // Quantizes the vertices into VertexCompact format (16 bytes per vertex
+        // instead of 56), at the cost of some precision.
+        bool m_compactVertices = false;
+
+        // Generates a chain of simplified levels of detail.
+        bool m_generateLods = true;
+
+        // Partitions the mesh into meshlets of up to 64 vertices and 124 triangles,
+        // each with bounding sphere and normal cone for cluster culling.
+        bool m_buildMeshlets = false;
+
+        // Uses Assimp to generate missing normals and tangents and to weld identical vertices.
+        // When false the native vertex processing is used instead, which is faster on big meshes
+        // but hasn't been validated yet against Assimp (see DX_VALIDATE_VERTEX_PROCESSING).
+        bool m_assimpVertexProcessing = true;
+
+        // Packs the settings into bits, used to identify cooked meshes.
+        uint32_t ToFlags() const;
+        static MeshImportSettings FromFlags(uint32_t flags);
+    };
+
+    // Mesh asset with the list of vertices, indices and other
+    // data needed to create a mesh.
+    // 
+    // Mesh asset formats supported: fbx, gltf and glb
+    class MeshAsset : public Asset<MeshData>
+    {
+    public:
+        // Loads a mesh from a file. The filename is relative to the assets folder.
+        // Settings are only used the first time the mesh is loaded.
+        static std::shared_ptr<MeshAsset> LoadMeshAsset(const std::string& fileName,
+            const MeshImportSettings& settings = {});
+
+        // Loads a mesh from a file in a worker thread. The filename is relative to the assets folder.
+        // Settings are only used the first time the mesh is loaded.
+        static AssetLoadHandle<MeshAsset> LoadMeshAssetAsync(const std::string& fileName,
+            const MeshImportSettings& settings = {});
+
+        // Imports the mesh again in a worker thread after its file has been modified.
+        // The new asset replaces the current one in the asset manager when it finishes successfully.
+        static AssetLoadHandle<MeshAsset> ReloadMeshAssetAsync(const std::string& fileName,
+            const MeshImportSettings& settings = {});
+
+        // Imports the mesh into the cooked cache without adding it to the asset manager,
+        // a cooked mesh already up to date is left as it is. Used to cook assets offline.
+        // The filename is relative to the assets folder. Returns false if the import fails.
+        // The import is parallelized in the thread pool when there is one.
+        static bool CookMeshAsset(const std::string& fileName, const MeshImportSettings& settings = {},
+            ThreadPool* threadPool = nullptr);
+
+        static inline const AssetType AssetTypeId = 0x73E47A71;
+
+        AssetType GetAssetType() const override
+        {
+            return AssetTypeId;
+        }
+
+        size_t GetDataSizeInBytes() const override
+        {
+            return m_data->GetSizeInBytes();
+        }
+
+        ~MeshAsset();
+
+        // Total size of mesh data currently alive in memory.
+        static size_t GetResidentDataSize();
+
+    protected:
+        friend class AssetManager;
+        using Super = Asset<MeshData>;
+
+        MeshAsset(AssetId assetId, std::unique_ptr<MeshData> data);
+
+    private:
+        static std::unique_ptr<MeshData> LoadMesh(const std::filesystem::path& fileNamePath, const MeshImportSettings& settings,
+            ThreadPool* threadPool);
+    };
+} // namespace DX
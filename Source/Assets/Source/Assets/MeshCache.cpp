@@ -0,0 +1,275 @@
+#include <Assets/MeshCache.h>
+#include <Assets/GltfLoader.h>
+#include <Assets/MeshAsset.h>
+#include <Assets/MeshCompression.h>
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Log/Log.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t CookedMeshMagic = 0x534D5844; // 'DXMS'
+
+        // Increment every time the layout of the cooked mesh changes.
+        static constexpr uint32_t CookedMeshVersion = 8;
+
+        static constexpr const char* CookedMeshExtension = ".dxmesh";
+
+        // Cooked mesh file layout:
+        //   CookedMeshHeader
+        //   Vertices (VertexPNTBUv or VertexCompact * vertexCount), encoded with EncodeMeshStream
+        //   Indices (16 or 32 bits * indexCount, see CalculateIndexSize), encoded with EncodeIndexStream
+        //   Levels of detail (MeshLod * lodCount)
+        //   Submeshes (MeshSubmesh * submeshCount)
+        //   Levels of detail of the submeshes (MeshLod * submeshLodCount)
+        //   Meshlets (Meshlet * meshletCount)
+        //   Meshlet vertices (uint32_t * meshletVertexCount)
+        //   Meshlet triangles (uint8_t * meshletTriangleIndexCount)
+        struct CookedMeshHeader
+        {
+            uint32_t m_magic;
+            uint32_t m_version;
+            HashValue m_sourceHash;
+            uint32_t m_importerFlags;
+            uint32_t m_settingsFlags;
+            uint32_t m_vertexFormat;
+            uint32_t m_vertexCount;
+            uint32_t m_indexCount;
+            uint32_t m_lodCount;
+            uint32_t m_submeshCount;
+            uint32_t m_submeshLodCount;
+            uint32_t m_meshletCount;
+            uint32_t m_meshletVertexCount;
+            uint32_t m_meshletTriangleIndexCount;
+            uint32_t m_vertexStreamSize; // Encoded size in bytes
+            uint32_t m_indexStreamSize; // Encoded size in bytes
+            float m_importTimeMs;
+            MeshBounds m_bounds;
+        };
+
+        size_t CookedMeshSize(const CookedMeshHeader& header)
+        {
+            return sizeof(CookedMeshHeader) +
+                header.m_vertexStreamSize +
+                header.m_indexStreamSize +
+                header.m_lodCount * sizeof(MeshLod) +
+                header.m_submeshCount * sizeof(MeshSubmesh) +
+                header.m_submeshLodCount * sizeof(MeshLod) +
+                header.m_meshletCount * sizeof(Meshlet) +
+                header.m_meshletVertexCount * sizeof(uint32_t) +
+                header.m_meshletTriangleIndexCount * sizeof(uint8_t);
+        }
+
+        template<typename T>
+        std::span<const uint8_t> AsBytes(const std::vector<T>& array)
+        {
+            return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(array.data()), array.size() * sizeof(T));
+        }
+
+        template<typename T>
+        std::span<uint8_t> AsWritableBytes(std::vector<T>& array)
+        {
+            return std::span<uint8_t>(reinterpret_cast<uint8_t*>(array.data()), array.size() * sizeof(T));
+        }
+
+        template<typename T>
+        const uint8_t* ReadArray(std::vector<T>& array, const uint8_t* data, uint32_t count)
+        {
+            array.resize(count);
+            std::memcpy(array.data(), data, count * sizeof(T));
+            return data + count * sizeof(T);
+        }
+
+        template<typename T>
+        void WriteArray(std::ofstream& file, const std::vector<T>& array)
+        {
+            file.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+        }
+    } // namespace Internal
+
+    std::optional<HashValue> HashMeshSource(const std::filesystem::path& sourcePath)
+    {
+        auto sourceFile = OpenAssetFile(sourcePath);
+        if (!sourceFile)
+        {
+            return std::nullopt;
+        }
+
+        HashValue hash = HashBytes(sourceFile->GetData().data(), sourceFile->GetData().size());
+
+        // The geometry of gltf files lives in separate binary buffers.
+        if (IsGltfFile(sourcePath))
+        {
+            for (const auto& binaryPath : GetGltfBufferPaths(sourcePath))
+            {
+                if (auto binaryFile = OpenAssetFile(binaryPath))
+                {
+                    hash = HashCombine(hash, HashBytes(binaryFile->GetData().data(), binaryFile->GetData().size()));
+                }
+            }
+        }
+
+        return hash;
+    }
+
+    std::filesystem::path GetCookedMeshPath(const std::filesystem::path& sourcePath)
+    {
+        auto cookedPath = GetAssetCachePath() / sourcePath.lexically_relative(GetAssetPath());
+        cookedPath += Internal::CookedMeshExtension;
+        return cookedPath;
+    }
+
+    std::optional<CookedMesh> LoadCookedMesh(const std::filesystem::path& cookedPath, const MeshCacheKey& key, ThreadPool* threadPool)
+    {
+        if (!std::filesystem::exists(cookedPath))
+        {
+            return std::nullopt;
+        }
+
+        MappedFile cookedFile;
+        if (!cookedFile.Open(cookedPath))
+        {
+            return std::nullopt;
+        }
+
+        if (cookedFile.GetSize() < sizeof(Internal::CookedMeshHeader))
+        {
+            DX_LOG(Warning, "MeshCache", "Cooked mesh %s is corrupted.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        Internal::CookedMeshHeader header;
+        std::memcpy(&header, cookedFile.GetData(), sizeof(header));
+
+        if (header.m_magic != Internal::CookedMeshMagic ||
+            header.m_version != Internal::CookedMeshVersion)
+        {
+            DX_LOG(Verbose, "MeshCache", "Cooked mesh %s is from a different version.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        if (header.m_sourceHash != key.m_sourceHash ||
+            header.m_importerFlags != key.m_importerFlags ||
+            header.m_settingsFlags != key.m_settingsFlags)
+        {
+            DX_LOG(Verbose, "MeshCache", "Cooked mesh %s is stale.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        const auto vertexFormat = static_cast<VertexFormat>(header.m_vertexFormat);
+        if ((vertexFormat != VertexFormat::PNTBUv && vertexFormat != VertexFormat::Compact) ||
+            header.m_submeshCount == 0 ||
+            header.m_submeshLodCount != header.m_lodCount * header.m_submeshCount ||
+            cookedFile.GetSize() != Internal::CookedMeshSize(header))
+        {
+            DX_LOG(Warning, "MeshCache", "Cooked mesh %s is corrupted.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        auto meshData = std::make_unique<MeshData>();
+        meshData->m_vertexFormat = vertexFormat;
+        meshData->m_bounds = header.m_bounds;
+
+        const uint8_t* data = cookedFile.GetData() + sizeof(header);
+        const std::span<const uint8_t> vertexStream(data, header.m_vertexStreamSize);
+        data += header.m_vertexStreamSize;
+        const std::span<const uint8_t> indexStream(data, header.m_indexStreamSize);
+        data += header.m_indexStreamSize;
+
+        bool decoded = false;
+        if (vertexFormat == VertexFormat::Compact)
+        {
+            meshData->m_compactVertices.resize(header.m_vertexCount);
+            decoded = DecodeMeshStream(vertexStream, Internal::AsWritableBytes(meshData->m_compactVertices), sizeof(VertexCompact), threadPool);
+        }
+        else
+        {
+            meshData->m_vertices.resize(header.m_vertexCount);
+            decoded = DecodeMeshStream(vertexStream, Internal::AsWritableBytes(meshData->m_vertices), sizeof(VertexPNTBUv), threadPool);
+        }
+
+        meshData->m_indices.resize(header.m_indexCount);
+        decoded = decoded && DecodeIndexStream(indexStream, meshData->m_indices, header.m_vertexCount, threadPool);
+
+        if (!decoded)
+        {
+            DX_LOG(Warning, "MeshCache", "Cooked mesh %s is corrupted.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        data = Internal::ReadArray(meshData->m_lods, data, header.m_lodCount);
+        data = Internal::ReadArray(meshData->m_submeshes, data, header.m_submeshCount);
+        data = Internal::ReadArray(meshData->m_submeshLods, data, header.m_submeshLodCount);
+        data = Internal::ReadArray(meshData->m_meshletData.m_meshlets, data, header.m_meshletCount);
+        data = Internal::ReadArray(meshData->m_meshletData.m_meshletVertices, data, header.m_meshletVertexCount);
+        data = Internal::ReadArray(meshData->m_meshletData.m_meshletTriangles, data, header.m_meshletTriangleIndexCount);
+
+        return CookedMesh{ std::move(meshData), header.m_importTimeMs };
+    }
+
+    bool SaveCookedMesh(const std::filesystem::path& cookedPath, const MeshCacheKey& key, const MeshData& meshData, float importTimeMs,
+        ThreadPool* threadPool)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(cookedPath.parent_path(), errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "MeshCache", "Failed to create cache folder %s.", cookedPath.parent_path().generic_string().c_str());
+            return false;
+        }
+
+        const std::vector<uint8_t> vertexStream = (meshData.m_vertexFormat == VertexFormat::Compact)
+            ? EncodeMeshStream(Internal::AsBytes(meshData.m_compactVertices), sizeof(VertexCompact), threadPool)
+            : EncodeMeshStream(Internal::AsBytes(meshData.m_vertices), sizeof(VertexPNTBUv), threadPool);
+        const std::vector<uint8_t> indexStream = EncodeIndexStream(meshData.m_indices, meshData.GetVertexCount(), threadPool);
+
+        const Internal::CookedMeshHeader header =
+        {
+            .m_magic = Internal::CookedMeshMagic,
+            .m_version = Internal::CookedMeshVersion,
+            .m_sourceHash = key.m_sourceHash,
+            .m_importerFlags = key.m_importerFlags,
+            .m_settingsFlags = key.m_settingsFlags,
+            .m_vertexFormat = static_cast<uint32_t>(meshData.m_vertexFormat),
+            .m_vertexCount = meshData.GetVertexCount(),
+            .m_indexCount = static_cast<uint32_t>(meshData.m_indices.size()),
+            .m_lodCount = static_cast<uint32_t>(meshData.m_lods.size()),
+            .m_submeshCount = static_cast<uint32_t>(meshData.m_submeshes.size()),
+            .m_submeshLodCount = static_cast<uint32_t>(meshData.m_submeshLods.size()),
+            .m_meshletCount = static_cast<uint32_t>(meshData.m_meshletData.m_meshlets.size()),
+            .m_meshletVertexCount = static_cast<uint32_t>(meshData.m_meshletData.m_meshletVertices.size()),
+            .m_meshletTriangleIndexCount = static_cast<uint32_t>(meshData.m_meshletData.m_meshletTriangles.size()),
+            .m_vertexStreamSize = static_cast<uint32_t>(vertexStream.size()),
+            .m_indexStreamSize = static_cast<uint32_t>(indexStream.size()),
+            .m_importTimeMs = importTimeMs,
+            .m_bounds = meshData.m_bounds
+        };
+
+        // Write into a temporary file and rename it at the end, so a
+        // partially written cooked mesh is never picked up by a loader.
+        const bool written = WriteFileAtomically(cookedPath, [&](std::ofstream& file)
+            {
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                Internal::WriteArray(file, vertexStream);
+                Internal::WriteArray(file, indexStream);
+                Internal::WriteArray(file, meshData.m_lods);
+                Internal::WriteArray(file, meshData.m_submeshes);
+                Internal::WriteArray(file, meshData.m_submeshLods);
+                Internal::WriteArray(file, meshData.m_meshletData.m_meshlets);
+                Internal::WriteArray(file, meshData.m_meshletData.m_meshletVertices);
+                Internal::WriteArray(file, meshData.m_meshletData.m_meshletTriangles);
+            });
+        if (!written)
+        {
+            DX_LOG(Error, "MeshCache", "Failed to save cooked mesh %s.", cookedPath.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+} // namespace DX
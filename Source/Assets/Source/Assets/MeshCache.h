@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Hash/Hash.h>
+
+#include <memory>
+#include <optional>
+#include <filesystem>
+
+namespace DX
+{
+    struct MeshData;
+    class ThreadPool;
+
+    // Identifies the source a cooked mesh was generated from.
+    // When any of its values differ from the ones stored in the
+    // cooked file, the cooked mesh is stale and must be imported again.
+    struct MeshCacheKey
+    {
+        HashValue m_sourceHash = 0;
+        uint32_t m_importerFlags = 0;
+        uint32_t m_settingsFlags = 0;
+    };
+
+    // Cooked mesh loaded from the cache.
+    struct CookedMesh
+    {
+        std::unique_ptr<MeshData> m_meshData;
+        float m_importTimeMs = 0.0f; // Time it took to import the source when cooked
+    };
+
+    // Calculates the hash of the contents of a mesh source file.
+    // For gltf files the binary buffers they reference are hashed as well.
+    std::optional<HashValue> HashMeshSource(const std::filesystem::path& sourcePath);
+
+    // Returns the path of the cooked mesh inside the cache folder for a source mesh path.
+    std::filesystem::path GetCookedMeshPath(const std::filesystem::path& sourcePath);
+
+    // Maps a cooked mesh file and reads its content into a new MeshData.
+    // Returns nullopt if the file doesn't exist, it's from a different
+    // version or it was cooked with a different key.
+    // Streams are decoded in parallel when there is a thread pool.
+    std::optional<CookedMesh> LoadCookedMesh(const std::filesystem::path& cookedPath, const MeshCacheKey& key,
+        ThreadPool* threadPool = nullptr);
+
+    // Writes mesh data into a cooked mesh file.
+    // Streams are encoded in parallel when there is a thread pool.
+    bool SaveCookedMesh(const std::filesystem::path& cookedPath, const MeshCacheKey& key, const MeshData& meshData, float importTimeMs,
+        ThreadPool* threadPool = nullptr);
+} // namespace DX
@@ -0,0 +1,341 @@
+#include <Assets/MeshCompression.h>
+#include <Compression/LZ4.h>
+#include <Debug/Debug.h>
+#include <Thread/ThreadPool.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DX_MESH_COMPRESSION_SSE2 1
+#include <emmintrin.h>
+#else
+#define DX_MESH_COMPRESSION_SSE2 0
+#endif
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Elements per chunk. Chunks are encoded independently so they are decoded in
+        // parallel, and the planes of a chunk fit in the L2 cache while being transposed.
+        static constexpr uint32_t MeshStreamChunkSize = 4096;
+
+        uint32_t MeshStreamChunkCount(uint32_t elementCount)
+        {
+            return (elementCount + MeshStreamChunkSize - 1) / MeshStreamChunkSize;
+        }
+
+        template<typename T>
+        std::span<const uint8_t> AsBytes(std::span<const T> elements)
+        {
+            return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(elements.data()), elements.size_bytes());
+        }
+
+        template<typename T>
+        std::span<uint8_t> AsWritableBytes(std::span<T> elements)
+        {
+            return std::span<uint8_t>(reinterpret_cast<uint8_t*>(elements.data()), elements.size_bytes());
+        }
+
+        // Delta encodes the bytes of the elements and transposes them into planes,
+        // byte b of element e goes to planes[b * elementCount + e].
+        void FilterMeshStream(const uint8_t* elements, uint8_t* planes, uint32_t elementCount, uint32_t elementSize)
+        {
+            for (uint32_t byte = 0; byte < elementSize; ++byte)
+            {
+                uint8_t* plane = planes + static_cast<size_t>(byte) * elementCount;
+                uint8_t previous = 0;
+                for (uint32_t element = 0; element < elementCount; ++element)
+                {
+                    const uint8_t value = elements[static_cast<size_t>(element) * elementSize + byte];
+                    plane[element] = static_cast<uint8_t>(value - previous);
+                    previous = value;
+                }
+            }
+        }
+
+#if DX_MESH_COMPRESSION_SSE2
+        // Transposes a 16x16 block of bytes: row i ends up with byte i of every input row.
+        inline void TransposeBlock16x16(__m128i (&rows)[16])
+        {
+            // Pairs of bytes, even registers have columns 0-7 and odd registers columns 8-15.
+            __m128i pairs[16];
+            for (uint32_t i = 0; i < 16; i += 2)
+            {
+                pairs[i + 0] = _mm_unpacklo_epi8(rows[i], rows[i + 1]);
+                pairs[i + 1] = _mm_unpackhi_epi8(rows[i], rows[i + 1]);
+            }
+
+            // Groups of 4 bytes, each register has 4 consecutive columns of 4 rows.
+            __m128i quads[16];
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                quads[i + 0] = _mm_unpacklo_epi16(pairs[i + 0], pairs[i + 2]);
+                quads[i + 1] = _mm_unpackhi_epi16(pairs[i + 0], pairs[i + 2]);
+                quads[i + 2] = _mm_unpacklo_epi16(pairs[i + 1], pairs[i + 3]);
+                quads[i + 3] = _mm_unpackhi_epi16(pairs[i + 1], pairs[i + 3]);
+            }
+
+            // Groups of 8 bytes, each register has 2 consecutive columns of 8 rows.
+            __m128i octets[16];
+            for (uint32_t half = 0; half < 2; ++half)
+            {
+                for (uint32_t i = 0; i < 4; ++i)
+                {
+                    octets[half * 8 + i * 2 + 0] = _mm_unpacklo_epi32(quads[half * 8 + i], quads[half * 8 + 4 + i]);
+                    octets[half * 8 + i * 2 + 1] = _mm_unpackhi_epi32(quads[half * 8 + i], quads[half * 8 + 4 + i]);
+                }
+            }
+
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                rows[i * 2 + 0] = _mm_unpacklo_epi64(octets[i], octets[8 + i]);
+                rows[i * 2 + 1] = _mm_unpackhi_epi64(octets[i], octets[8 + i]);
+            }
+        }
+#endif
+
+        // Inverse of FilterMeshStream.
+        void UnfilterMeshStream(const uint8_t* planes, uint8_t* elements, uint32_t elementCount, uint32_t elementSize)
+        {
+            // Last value decoded of each byte, the base of the next delta.
+            std::array<uint8_t, MaxMeshStreamElementSize> previous = {};
+
+            uint32_t firstElement = 0;
+
+#if DX_MESH_COMPRESSION_SSE2
+            alignas(16) std::array<uint8_t, MaxMeshStreamElementSize * 16> block;
+            alignas(16) std::array<uint32_t, 16> words;
+
+            for (; firstElement + 16 <= elementCount; firstElement += 16)
+            {
+                // Prefix sum of the deltas of 16 elements of each plane.
+                for (uint32_t byte = 0; byte < elementSize; ++byte)
+                {
+                    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + static_cast<size_t>(byte) * elementCount + firstElement));
+                    values = _mm_add_epi8(values, _mm_slli_si128(values, 1));
+                    values = _mm_add_epi8(values, _mm_slli_si128(values, 2));
+                    values = _mm_add_epi8(values, _mm_slli_si128(values, 4));
+                    values = _mm_add_epi8(values, _mm_slli_si128(values, 8));
+                    values = _mm_add_epi8(values, _mm_set1_epi8(static_cast<char>(previous[byte])));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(block.data() + byte * 16), values);
+                    previous[byte] = block[byte * 16 + 15];
+                }
+
+                uint8_t* blockElements = elements + static_cast<size_t>(firstElement) * elementSize;
+                uint32_t byte = 0;
+
+                // Transpose 16 planes at a time into 16 bytes of each of the 16 elements.
+                for (; byte + 16 <= elementSize; byte += 16)
+                {
+                    __m128i rows[16];
+                    for (uint32_t plane = 0; plane < 16; ++plane)
+                    {
+                        rows[plane] = _mm_load_si128(reinterpret_cast<const __m128i*>(block.data() + (byte + plane) * 16));
+                    }
+                    TransposeBlock16x16(rows);
+                    for (uint32_t element = 0; element < 16; ++element)
+                    {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(blockElements + element * elementSize + byte), rows[element]);
+                    }
+                }
+
+                // Transpose 4 planes at a time into the 32-bit words of the 16 elements.
+                for (; byte + 4 <= elementSize; byte += 4)
+                {
+                    const __m128i plane0 = _mm_load_si128(reinterpret_cast<const __m128i*>(block.data() + (byte + 0) * 16));
+                    const __m128i plane1 = _mm_load_si128(reinterpret_cast<const __m128i*>(block.data() + (byte + 1) * 16));
+                    const __m128i plane2 = _mm_load_si128(reinterpret_cast<const __m128i*>(block.data() + (byte + 2) * 16));
+                    const __m128i plane3 = _mm_load_si128(reinterpret_cast<const __m128i*>(block.data() + (byte + 3) * 16));
+
+                    const __m128i bytes01Low = _mm_unpacklo_epi8(plane0, plane1);
+                    const __m128i bytes01High = _mm_unpackhi_epi8(plane0, plane1);
+                    const __m128i bytes23Low = _mm_unpacklo_epi8(plane2, plane3);
+                    const __m128i bytes23High = _mm_unpackhi_epi8(plane2, plane3);
+
+                    _mm_store_si128(reinterpret_cast<__m128i*>(words.data() + 0), _mm_unpacklo_epi16(bytes01Low, bytes23Low));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(words.data() + 4), _mm_unpackhi_epi16(bytes01Low, bytes23Low));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(words.data() + 8), _mm_unpacklo_epi16(bytes01High, bytes23High));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(words.data() + 12), _mm_unpackhi_epi16(bytes01High, bytes23High));
+
+                    if (elementSize == 4)
+                    {
+                        std::memcpy(blockElements, words.data(), sizeof(words));
+                    }
+                    else
+                    {
+                        for (uint32_t element = 0; element < 16; ++element)
+                        {
+                            std::memcpy(blockElements + element * elementSize + byte, &words[element], sizeof(uint32_t));
+                        }
+                    }
+                }
+
+                // Remaining bytes of elements whose size is not a multiple of 4.
+                for (; byte < elementSize; ++byte)
+                {
+                    for (uint32_t element = 0; element < 16; ++element)
+                    {
+                        blockElements[element * elementSize + byte] = block[byte * 16 + element];
+                    }
+                }
+            }
+#endif
+
+            for (uint32_t element = firstElement; element < elementCount; ++element)
+            {
+                for (uint32_t byte = 0; byte < elementSize; ++byte)
+                {
+                    previous[byte] = static_cast<uint8_t>(previous[byte] + planes[static_cast<size_t>(byte) * elementCount + element]);
+                    elements[static_cast<size_t>(element) * elementSize + byte] = previous[byte];
+                }
+            }
+        }
+    } // namespace Internal
+
+    std::vector<uint8_t> EncodeMeshStream(std::span<const uint8_t> elements, uint32_t elementSize, ThreadPool* threadPool)
+    {
+        DX_ASSERT(elementSize > 0 && elementSize <= MaxMeshStreamElementSize, "MeshCompression",
+            "Element size %u not supported", elementSize);
+        DX_ASSERT(elements.size() % elementSize == 0, "MeshCompression", "Stream size is not a multiple of the element size");
+
+        const uint32_t elementCount = static_cast<uint32_t>(elements.size() / elementSize);
+        const uint32_t chunkCount = Internal::MeshStreamChunkCount(elementCount);
+
+        std::vector<std::vector<uint8_t>> compressedChunks(chunkCount);
+        auto encodeChunk = [&](uint32_t chunkIndex)
+        {
+            const uint32_t firstElement = chunkIndex * Internal::MeshStreamChunkSize;
+            const uint32_t chunkElementCount = std::min(Internal::MeshStreamChunkSize, elementCount - firstElement);
+
+            std::vector<uint8_t> planes(static_cast<size_t>(chunkElementCount) * elementSize);
+            Internal::FilterMeshStream(elements.data() + static_cast<size_t>(firstElement) * elementSize, planes.data(),
+                chunkElementCount, elementSize);
+            compressedChunks[chunkIndex] = LZ4Compress(planes);
+        };
+
+        if (threadPool && chunkCount > 1)
+        {
+            threadPool->ParallelFor(chunkCount, encodeChunk);
+        }
+        else
+        {
+            for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+            {
+                encodeChunk(chunkIndex);
+            }
+        }
+
+        // Compressed size of every chunk, followed by the chunks.
+        std::vector<uint8_t> encodedStream(chunkCount * sizeof(uint32_t));
+        for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            const uint32_t chunkSize = static_cast<uint32_t>(compressedChunks[chunkIndex].size());
+            std::memcpy(encodedStream.data() + chunkIndex * sizeof(uint32_t), &chunkSize, sizeof(chunkSize));
+            encodedStream.insert(encodedStream.end(), compressedChunks[chunkIndex].begin(), compressedChunks[chunkIndex].end());
+        }
+        return encodedStream;
+    }
+
+    bool DecodeMeshStream(std::span<const uint8_t> encodedStream, std::span<uint8_t> elements, uint32_t elementSize, ThreadPool* threadPool)
+    {
+        if (elementSize == 0 || elementSize > MaxMeshStreamElementSize || elements.size() % elementSize != 0)
+        {
+            return false;
+        }
+
+        const uint32_t elementCount = static_cast<uint32_t>(elements.size() / elementSize);
+        const uint32_t chunkCount = Internal::MeshStreamChunkCount(elementCount);
+
+        const size_t chunkTableSize = chunkCount * sizeof(uint32_t);
+        if (encodedStream.size() < chunkTableSize)
+        {
+            return false;
+        }
+
+        // The chunks must cover the rest of the stream exactly.
+        std::vector<size_t> chunkOffsets(chunkCount + 1, chunkTableSize);
+        for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            uint32_t chunkSize;
+            std::memcpy(&chunkSize, encodedStream.data() + chunkIndex * sizeof(uint32_t), sizeof(chunkSize));
+            chunkOffsets[chunkIndex + 1] = chunkOffsets[chunkIndex] + chunkSize;
+        }
+        if (chunkOffsets[chunkCount] != encodedStream.size())
+        {
+            return false;
+        }
+
+        std::atomic<bool> decoded = true;
+        auto decodeChunk = [&](uint32_t chunkIndex)
+        {
+            const uint32_t firstElement = chunkIndex * Internal::MeshStreamChunkSize;
+            const uint32_t chunkElementCount = std::min(Internal::MeshStreamChunkSize, elementCount - firstElement);
+
+            // Reused between chunks, allocating it every time costs as much as decoding.
+            thread_local std::vector<uint8_t> planes;
+            planes.resize(static_cast<size_t>(chunkElementCount) * elementSize);
+            if (!LZ4Decompress(encodedStream.subspan(chunkOffsets[chunkIndex], chunkOffsets[chunkIndex + 1] - chunkOffsets[chunkIndex]), planes))
+            {
+                decoded = false;
+                return;
+            }
+
+            Internal::UnfilterMeshStream(planes.data(), elements.data() + static_cast<size_t>(firstElement) * elementSize,
+                chunkElementCount, elementSize);
+        };
+
+        if (threadPool && chunkCount > 1)
+        {
+            threadPool->ParallelFor(chunkCount, decodeChunk);
+        }
+        else
+        {
+            for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+            {
+                decodeChunk(chunkIndex);
+            }
+        }
+
+        return decoded;
+    }
+
+    std::vector<uint8_t> EncodeIndexStream(std::span<const Index> indices, uint32_t vertexCount, ThreadPool* threadPool)
+    {
+        if (CalculateIndexSize(vertexCount) == sizeof(Index))
+        {
+            return EncodeMeshStream(Internal::AsBytes(indices), sizeof(Index), threadPool);
+        }
+
+        std::vector<Index16> indices16(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            DX_ASSERT(indices[i] < vertexCount, "MeshCompression", "Index %u out of range", indices[i]);
+            indices16[i] = static_cast<Index16>(indices[i]);
+        }
+        return EncodeMeshStream(Internal::AsBytes(std::span<const Index16>(indices16)), sizeof(Index16), threadPool);
+    }
+
+    bool DecodeIndexStream(std::span<const uint8_t> encodedStream, std::span<Index> indices, uint32_t vertexCount, ThreadPool* threadPool)
+    {
+        if (CalculateIndexSize(vertexCount) == sizeof(Index))
+        {
+            return DecodeMeshStream(encodedStream, Internal::AsWritableBytes(indices), sizeof(Index), threadPool);
+        }
+
+        std::vector<Index16> indices16(indices.size());
+        if (!DecodeMeshStream(encodedStream, Internal::AsWritableBytes(std::span<Index16>(indices16)), sizeof(Index16), threadPool))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = indices16[i];
+        }
+        return true;
+    }
+} // namespace DX
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Assets/Vertices.h>
+
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    class ThreadPool;
+
+    // Lossless codec for the vertex and index streams of cooked meshes.
+    //
+    // Each byte of an element is delta encoded against the same byte of the previous
+    // element and the bytes are transposed, so every byte position of the elements forms
+    // a contiguous plane. Neighbouring vertices have similar attributes, which leaves
+    // long runs of zeros in most planes that are then compressed with LZ4.
+    // Streams are split in chunks of elements encoded independently, when a thread pool
+    // is provided chunks are encoded and decoded in parallel. Decoding undoes the deltas
+    // and the transposition 16 elements at a time with SSE2.
+
+    // Maximum size of the elements of a stream.
+    inline constexpr uint32_t MaxMeshStreamElementSize = 64;
+
+    // Encodes a stream of elements of elementSize bytes each.
+    std::vector<uint8_t> EncodeMeshStream(std::span<const uint8_t> elements, uint32_t elementSize,
+        ThreadPool* threadPool = nullptr);
+
+    // Decodes a stream into the elements, which must have the exact size of the elements encoded.
+    // Returns false if the encoded stream is corrupted.
+    bool DecodeMeshStream(std::span<const uint8_t> encodedStream, std::span<uint8_t> elements, uint32_t elementSize,
+        ThreadPool* threadPool = nullptr);
+
+    // Encodes indices with CalculateIndexSize(vertexCount) bytes each.
+    std::vector<uint8_t> EncodeIndexStream(std::span<const Index> indices, uint32_t vertexCount,
+        ThreadPool* threadPool = nullptr);
+
+    // Decodes indices encoded with EncodeIndexStream, widening them back to Index.
+    // Returns false if the encoded stream is corrupted.
+    bool DecodeIndexStream(std::span<const uint8_t> encodedStream, std::span<Index> indices, uint32_t vertexCount,
+        ThreadPool* threadPool = nullptr);
+} // namespace DX
@@ -0,0 +1,774 @@
+#include <Assets/MeshOptimizer.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        // Constants of Forsyth's algorithm
+        static constexpr uint32_t ForsythCacheSize = 32;
+        static constexpr float ForsythCacheDecayPower = 1.5f;
+        static constexpr float ForsythLastTriangleScore = 0.75f;
+        static constexpr float ForsythValenceBoostScale = 2.0f;
+        static constexpr float ForsythValenceBoostPower = 0.5f;
+
+        // Cache size used to split triangles in clusters for overdraw optimization
+        static constexpr uint32_t OverdrawCacheSize = 16;
+
+        float ForsythVertexScore(int cachePosition, uint32_t activeTriangleCount)
+        {
+            if (activeTriangleCount == 0)
+            {
+                // No triangles left using this vertex
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+            if (cachePosition >= 0)
+            {
+                if (cachePosition < 3)
+                {
+                    // Vertices used by the last triangle get a fixed score, so it doesn't
+                    // matter which of the three the triangle was written with.
+                    score = ForsythLastTriangleScore;
+                }
+                else
+                {
+                    const float scaler = 1.0f / (ForsythCacheSize - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scaler, ForsythCacheDecayPower);
+                }
+            }
+
+            // Boost vertices with few triangles left, so lone triangles are not left behind
+            score += ForsythValenceBoostScale * std::pow(static_cast<float>(activeTriangleCount), -ForsythValenceBoostPower);
+
+            return score;
+        }
+
+        // Quadric error metric: sum of squared distances to a set of planes,
+        // weighted by the area of the triangles they come from.
+        struct Quadric
+        {
+            double m_a2 = 0.0, m_ab = 0.0, m_ac = 0.0, m_ad = 0.0;
+            double m_b2 = 0.0, m_bc = 0.0, m_bd = 0.0;
+            double m_c2 = 0.0, m_cd = 0.0;
+            double m_d2 = 0.0;
+            double m_weight = 0.0;
+
+            // Plane with equation dot(normal, point) + distance = 0
+            void AddPlane(const Math::Vector3& normal, float distance, float weight)
+            {
+                const double a = normal.x, b = normal.y, c = normal.z, d = distance;
+                m_a2 += weight * a * a; m_ab += weight * a * b; m_ac += weight * a * c; m_ad += weight * a * d;
+                m_b2 += weight * b * b; m_bc += weight * b * c; m_bd += weight * b * d;
+                m_c2 += weight * c * c; m_cd += weight * c * d;
+                m_d2 += weight * d * d;
+                m_weight += weight;
+            }
+
+            void Add(const Quadric& other)
+            {
+                m_a2 += other.m_a2; m_ab += other.m_ab; m_ac += other.m_ac; m_ad += other.m_ad;
+                m_b2 += other.m_b2; m_bc += other.m_bc; m_bd += other.m_bd;
+                m_c2 += other.m_c2; m_cd += other.m_cd;
+                m_d2 += other.m_d2;
+                m_weight += other.m_weight;
+            }
+
+            // Mean squared distance from the point to the planes
+            double Evaluate(const Math::Vector3& point) const
+            {
+                if (m_weight <= 0.0)
+                {
+                    return 0.0;
+                }
+
+                const double x = point.x, y = point.y, z = point.z;
+                const double error =
+                    m_a2 * x * x + m_b2 * y * y + m_c2 * z * z +
+                    2.0 * (m_ab * x * y + m_ac * x * z + m_bc * y * z) +
+                    2.0 * (m_ad * x + m_bd * y + m_cd * z) +
+                    m_d2;
+                return std::max(error, 0.0) / m_weight;
+            }
+        };
+
+        struct PositionKey
+        {
+            uint32_t m_bits[3];
+
+            bool operator==(const PositionKey& other) const
+            {
+                return std::memcmp(m_bits, other.m_bits, sizeof(m_bits)) == 0;
+            }
+        };
+
+        struct PositionKeyHash
+        {
+            size_t operator()(const PositionKey& key) const
+            {
+                return (key.m_bits[0] * 73856093u) ^ (key.m_bits[1] * 19349663u) ^ (key.m_bits[2] * 83492791u);
+            }
+        };
+
+        // Triangles adjacent to each vertex, stored in ranges of a flat list.
+        struct TriangleAdjacency
+        {
+            std::vector<uint32_t> m_offsets; // vertexCount + 1
+            std::vector<uint32_t> m_triangles;
+
+            void Build(std::span<const Index> indices, uint32_t vertexCount)
+            {
+                m_offsets.assign(vertexCount + 1, 0);
+                for (const Index index : indices)
+                {
+                    ++m_offsets[index + 1];
+                }
+                std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+                m_triangles.resize(indices.size());
+                std::vector<uint32_t> fillOffsets(m_offsets.begin(), m_offsets.end() - 1);
+                for (uint32_t i = 0; i < indices.size(); ++i)
+                {
+                    m_triangles[fillOffsets[indices[i]]++] = i / 3;
+                }
+            }
+
+            std::span<const uint32_t> GetTriangles(uint32_t vertex) const
+            {
+                return std::span<const uint32_t>(m_triangles.data() + m_offsets[vertex], m_offsets[vertex + 1] - m_offsets[vertex]);
+            }
+        };
+
+        // Checks that moving the vertex to the target's position doesn't flip
+        // or degenerate any of the triangles that remain after the collapse.
+        bool IsCollapseValid(std::span<const Index> indices, std::span<const VertexPNTBUv> vertices,
+            const TriangleAdjacency& adjacency, uint32_t vertex, uint32_t target)
+        {
+            const Math::Vector3 targetPosition(vertices[target].m_position);
+
+            for (const uint32_t triangle : adjacency.GetTriangles(vertex))
+            {
+                const Index* triangleIndices = &indices[triangle * 3];
+                if (triangleIndices[0] == target || triangleIndices[1] == target || triangleIndices[2] == target)
+                {
+                    continue; // Triangle removed by the collapse
+                }
+
+                Math::Vector3 positions[3];
+                Math::Vector3 collapsedPositions[3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    positions[i] = Math::Vector3(vertices[triangleIndices[i]].m_position);
+                    collapsedPositions[i] = (triangleIndices[i] == vertex) ? targetPosition : positions[i];
+                }
+
+                const Math::Vector3 normal = Math::Vector3::CrossProduct(positions[1] - positions[0], positions[2] - positions[0]);
+                const Math::Vector3 collapsedNormal = Math::Vector3::CrossProduct(collapsedPositions[1] - collapsedPositions[0], collapsedPositions[2] - collapsedPositions[0]);
+
+                // Reject flips and rotations of more than ~75 degrees
+                if (Math::Vector3::DotProduct(normal, collapsedNormal) <= 0.25f * normal.Length() * collapsedNormal.Length())
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } // namespace Internal
+
+    VertexCacheStatistics AnalyzeVertexCache(std::span<const Index> indices, uint32_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStatistics statistics;
+        if (indices.empty() || vertexCount == 0)
+        {
+            return statistics;
+        }
+
+        // A vertex is in the FIFO cache if less than cacheSize
+        // vertices have been added to it since it was added.
+        std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+        uint32_t timestamp = cacheSize + 1;
+
+        for (const Index index : indices)
+        {
+            if (timestamp - cacheTimestamps[index] > cacheSize)
+            {
+                cacheTimestamps[index] = timestamp++;
+                ++statistics.m_cacheMisses;
+            }
+        }
+
+        statistics.m_acmr = static_cast<float>(statistics.m_cacheMisses) / (indices.size() / 3);
+        statistics.m_atvr = static_cast<float>(statistics.m_cacheMisses) / vertexCount;
+        return statistics;
+    }
+
+    void OptimizeVertexCache(std::span<Index> indices, uint32_t vertexCount)
+    {
+        const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        // Triangles adjacent to each vertex. Each vertex has a range in the adjacency
+        // list, with its active (not yet added) triangles at the beginning of the range.
+        std::vector<uint32_t> activeTriangleCounts(vertexCount, 0);
+        for (const Index index : indices)
+        {
+            DX_ASSERT(index < vertexCount, "MeshOptimizer", "Index %u out of range", index);
+            ++activeTriangleCounts[index];
+        }
+
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + activeTriangleCounts[vertex];
+        }
+
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+            {
+                for (uint32_t i = 0; i < 3; ++i)
+                {
+                    adjacency[fillOffsets[indices[triangle * 3 + i]]++] = triangle;
+                }
+            }
+        }
+
+        std::vector<int> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            vertexScores[vertex] = Internal::ForsythVertexScore(-1, activeTriangleCounts[vertex]);
+        }
+
+        auto calculateTriangleScore = [&indices, &vertexScores](uint32_t triangle)
+        {
+            return vertexScores[indices[triangle * 3 + 0]] +
+                vertexScores[indices[triangle * 3 + 1]] +
+                vertexScores[indices[triangle * 3 + 2]];
+        };
+
+        std::vector<bool> triangleAdded(triangleCount, false);
+
+        // Start with the triangle with best score
+        uint32_t bestTriangle = 0;
+        {
+            float bestScore = -1.0f;
+            for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+            {
+                if (const float score = calculateTriangleScore(triangle);
+                    score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        std::vector<Index> optimizedIndices(indices.size());
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> newCache;
+        cache.reserve(Internal::ForsythCacheSize + 3);
+        newCache.reserve(Internal::ForsythCacheSize + 3);
+
+        uint32_t nextTriangleToScan = 0;
+
+        for (uint32_t outputTriangle = 0; outputTriangle < triangleCount; ++outputTriangle)
+        {
+            if (bestTriangle == Internal::InvalidIndex)
+            {
+                // No candidates adjacent to the cache, continue with
+                // the next triangle that hasn't been added yet.
+                while (triangleAdded[nextTriangleToScan])
+                {
+                    ++nextTriangleToScan;
+                }
+                bestTriangle = nextTriangleToScan;
+            }
+
+            const Index triangleIndices[3] =
+            {
+                indices[bestTriangle * 3 + 0],
+                indices[bestTriangle * 3 + 1],
+                indices[bestTriangle * 3 + 2]
+            };
+
+            std::copy(triangleIndices, triangleIndices + 3, optimizedIndices.begin() + outputTriangle * 3);
+            triangleAdded[bestTriangle] = true;
+
+            // Remove the triangle from the active triangles of its vertices
+            for (const Index vertex : triangleIndices)
+            {
+                auto activeBegin = adjacency.begin() + adjacencyOffsets[vertex];
+                auto activeEnd = activeBegin + activeTriangleCounts[vertex];
+                auto it = std::find(activeBegin, activeEnd, bestTriangle);
+                DX_ASSERT(it != activeEnd, "MeshOptimizer", "Triangle not found in vertex adjacency");
+                std::iter_swap(it, activeEnd - 1);
+                --activeTriangleCounts[vertex];
+            }
+
+            // Move the triangle's vertices to the front of the cache
+            newCache.clear();
+            newCache.insert(newCache.end(), triangleIndices, triangleIndices + 3);
+            for (const uint32_t vertex : cache)
+            {
+                if (vertex != triangleIndices[0] &&
+                    vertex != triangleIndices[1] &&
+                    vertex != triangleIndices[2])
+                {
+                    newCache.push_back(vertex);
+                }
+            }
+
+            // Vertices pushed out of the cache
+            for (size_t i = Internal::ForsythCacheSize; i < newCache.size(); ++i)
+            {
+                const uint32_t vertex = newCache[i];
+                cachePositions[vertex] = -1;
+                vertexScores[vertex] = Internal::ForsythVertexScore(-1, activeTriangleCounts[vertex]);
+            }
+            newCache.resize(std::min<size_t>(newCache.size(), Internal::ForsythCacheSize));
+            std::swap(cache, newCache);
+
+            // Update scores of vertices in cache
+            for (uint32_t i = 0; i < cache.size(); ++i)
+            {
+                const uint32_t vertex = cache[i];
+                cachePositions[vertex] = static_cast<int>(i);
+                vertexScores[vertex] = Internal::ForsythVertexScore(static_cast<int>(i), activeTriangleCounts[vertex]);
+            }
+
+            // Next triangle is the best among the ones using vertices in cache
+            bestTriangle = Internal::InvalidIndex;
+            float bestScore = -1.0f;
+            for (const uint32_t vertex : cache)
+            {
+                const uint32_t activeBegin = adjacencyOffsets[vertex];
+                const uint32_t activeEnd = activeBegin + activeTriangleCounts[vertex];
+                for (uint32_t i = activeBegin; i < activeEnd; ++i)
+                {
+                    const uint32_t triangle = adjacency[i];
+                    if (const float score = calculateTriangleScore(triangle);
+                        score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = triangle;
+                    }
+                }
+            }
+        }
+
+        std::copy(optimizedIndices.begin(), optimizedIndices.end(), indices.begin());
+    }
+
+    void OptimizeOverdraw(std::span<Index> indices, std::span<const VertexPNTBUv> vertices, float threshold)
+    {
+        const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        if (triangleCount < 2)
+        {
+            return;
+        }
+
+        struct Cluster
+        {
+            uint32_t m_firstTriangle = 0;
+            uint32_t m_triangleCount = 0;
+            float m_sortKey = 0.0f;
+        };
+
+        // Split triangles in clusters at the points where the vertex cache is
+        // flushed (all vertices of a triangle miss), that way reordering the
+        // clusters barely affects the vertex cache efficiency.
+        std::vector<Cluster> clusters;
+        {
+            std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+            uint32_t timestamp = Internal::OverdrawCacheSize + 1;
+
+            for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+            {
+                uint32_t cacheMisses = 0;
+                for (uint32_t i = 0; i < 3; ++i)
+                {
+                    const Index index = indices[triangle * 3 + i];
+                    if (timestamp - cacheTimestamps[index] > Internal::OverdrawCacheSize)
+                    {
+                        cacheTimestamps[index] = timestamp++;
+                        ++cacheMisses;
+                    }
+                }
+
+                if (clusters.empty() || cacheMisses == 3)
+                {
+                    clusters.push_back({ triangle, 0, 0.0f });
+                }
+                ++clusters.back().m_triangleCount;
+            }
+        }
+
+        if (clusters.size() < 2)
+        {
+            return;
+        }
+
+        // Calculate area-weighted centroid and normal of each cluster
+        std::vector<Math::Vector3> clusterCentroids(clusters.size(), Math::Vector3(0.0f));
+        std::vector<Math::Vector3> clusterNormals(clusters.size(), Math::Vector3(0.0f));
+        Math::Vector3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+
+        for (size_t clusterIndex = 0; clusterIndex < clusters.size(); ++clusterIndex)
+        {
+            const Cluster& cluster = clusters[clusterIndex];
+            float clusterArea = 0.0f;
+
+            for (uint32_t triangle = cluster.m_firstTriangle; triangle < cluster.m_firstTriangle + cluster.m_triangleCount; ++triangle)
+            {
+                const Math::Vector3 p0(vertices[indices[triangle * 3 + 0]].m_position);
+                const Math::Vector3 p1(vertices[indices[triangle * 3 + 1]].m_position);
+                const Math::Vector3 p2(vertices[indices[triangle * 3 + 2]].m_position);
+
+                const Math::Vector3 normal = Math::Vector3::CrossProduct(p1 - p0, p2 - p0);
+                const float area = normal.Length();
+
+                clusterCentroids[clusterIndex] += (p0 + p1 + p2) * (area / 3.0f);
+                clusterNormals[clusterIndex] += normal;
+                clusterArea += area;
+            }
+
+            meshCentroid += clusterCentroids[clusterIndex];
+            meshArea += clusterArea;
+
+            if (clusterArea > 0.0f)
+            {
+                clusterCentroids[clusterIndex] /= clusterArea;
+            }
+        }
+
+        if (meshArea <= 0.0f)
+        {
+            return;
+        }
+        meshCentroid /= meshArea;
+
+        // Clusters facing away from the center of the mesh are more likely
+        // to occlude others, so they are drawn first.
+        for (size_t clusterIndex = 0; clusterIndex < clusters.size(); ++clusterIndex)
+        {
+            const float normalLength = clusterNormals[clusterIndex].Length();
+            if (normalLength > 0.0f)
+            {
+                clusters[clusterIndex].m_sortKey = Math::Vector3::DotProduct(
+                    clusterCentroids[clusterIndex] - meshCentroid,
+                    clusterNormals[clusterIndex] / normalLength);
+            }
+        }
+
+        std::stable_sort(clusters.begin(), clusters.end(),
+            [](const Cluster& lhs, const Cluster& rhs)
+            {
+                return lhs.m_sortKey > rhs.m_sortKey;
+            });
+
+        std::vector<Index> sortedIndices;
+        sortedIndices.reserve(indices.size());
+        for (const Cluster& cluster : clusters)
+        {
+            sortedIndices.insert(sortedIndices.end(),
+                indices.begin() + cluster.m_firstTriangle * 3,
+                indices.begin() + (cluster.m_firstTriangle + cluster.m_triangleCount) * 3);
+        }
+
+        // Only keep the new order if vertex cache efficiency is not degraded beyond the threshold
+        const float originalAcmr = AnalyzeVertexCache(indices, vertexCount, Internal::OverdrawCacheSize).m_acmr;
+        const float sortedAcmr = AnalyzeVertexCache(sortedIndices, vertexCount, Internal::OverdrawCacheSize).m_acmr;
+        if (sortedAcmr <= originalAcmr * threshold)
+        {
+            std::copy(sortedIndices.begin(), sortedIndices.end(), indices.begin());
+        }
+    }
+
+    void OptimizeVertexFetch(std::vector<VertexPNTBUv>& vertices, std::span<Index> indices)
+    {
+        std::vector<uint32_t> remap(vertices.size(), Internal::InvalidIndex);
+
+        std::vector<VertexPNTBUv> remappedVertices;
+        remappedVertices.reserve(vertices.size());
+
+        for (Index& index : indices)
+        {
+            if (remap[index] == Internal::InvalidIndex)
+            {
+                remap[index] = static_cast<uint32_t>(remappedVertices.size());
+                remappedVertices.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices = std::move(remappedVertices);
+    }
+
+    std::vector<Index> SimplifyMesh(std::span<const Index> indices, std::span<const VertexPNTBUv> vertices,
+        size_t targetIndexCount, float targetError, float* resultError)
+    {
+        std::vector<Index> simplifiedIndices(indices.begin(), indices.end());
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+        if (resultError)
+        {
+            *resultError = 0.0f;
+        }
+
+        if (simplifiedIndices.size() <= targetIndexCount || vertexCount == 0)
+        {
+            return simplifiedIndices;
+        }
+
+        auto getPosition = [&vertices](uint32_t vertex)
+        {
+            return Math::Vector3(vertices[vertex].m_position);
+        };
+
+        // The error is relative to the size of the mesh
+        float meshSize = 0.0f;
+        {
+            Math::Vector3 min(std::numeric_limits<float>::max());
+            Math::Vector3 max(std::numeric_limits<float>::lowest());
+            for (const Index index : indices)
+            {
+                min = Math::Vector3::Min(min, getPosition(index));
+                max = Math::Vector3::Max(max, getPosition(index));
+            }
+            meshSize = (max - min).Length();
+        }
+        if (meshSize <= 0.0f)
+        {
+            return simplifiedIndices;
+        }
+        const double maxErrorSquared = static_cast<double>(targetError * meshSize) * (targetError * meshSize);
+
+        // Vertices that share position with others are on attribute seams (uv, normals) and
+        // vertices on edges used by only one triangle are on the mesh border. Both are locked.
+        std::vector<bool> lockedVertices(vertexCount, false);
+        {
+            std::vector<uint32_t> positionIds(vertexCount);
+            std::vector<uint32_t> positionUseCounts;
+            std::unordered_map<Internal::PositionKey, uint32_t, Internal::PositionKeyHash> positionMap;
+            for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                Internal::PositionKey key;
+                std::memcpy(key.m_bits, &vertices[vertex].m_position, sizeof(key.m_bits));
+
+                auto [it, inserted] = positionMap.try_emplace(key, static_cast<uint32_t>(positionUseCounts.size()));
+                if (inserted)
+                {
+                    positionUseCounts.push_back(0);
+                }
+                positionIds[vertex] = it->second;
+                ++positionUseCounts[it->second];
+            }
+
+            for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                lockedVertices[vertex] = positionUseCounts[positionIds[vertex]] > 1;
+            }
+
+            auto edgeKey = [&positionIds](Index a, Index b)
+            {
+                const uint64_t positionA = positionIds[a];
+                const uint64_t positionB = positionIds[b];
+                return (std::min(positionA, positionB) << 32) | std::max(positionA, positionB);
+            };
+
+            std::unordered_map<uint64_t, uint32_t> edgeUseCounts;
+            edgeUseCounts.reserve(indices.size());
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                for (size_t edge = 0; edge < 3; ++edge)
+                {
+                    ++edgeUseCounts[edgeKey(indices[i + edge], indices[i + (edge + 1) % 3])];
+                }
+            }
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                for (size_t edge = 0; edge < 3; ++edge)
+                {
+                    const Index a = indices[i + edge];
+                    const Index b = indices[i + (edge + 1) % 3];
+                    if (edgeUseCounts[edgeKey(a, b)] == 1)
+                    {
+                        lockedVertices[a] = true;
+                        lockedVertices[b] = true;
+                    }
+                }
+            }
+        }
+
+        // Quadrics of the planes of the triangles around each vertex
+        std::vector<Internal::Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            const Math::Vector3 p0 = getPosition(indices[i + 0]);
+            const Math::Vector3 p1 = getPosition(indices[i + 1]);
+            const Math::Vector3 p2 = getPosition(indices[i + 2]);
+
+            Math::Vector3 normal = Math::Vector3::CrossProduct(p1 - p0, p2 - p0);
+            const float doubleArea = normal.Length();
+            if (doubleArea > 0.0f)
+            {
+                normal /= doubleArea;
+                const float distance = -Math::Vector3::DotProduct(normal, p0);
+                for (size_t corner = 0; corner < 3; ++corner)
+                {
+                    quadrics[indices[i + corner]].AddPlane(normal, distance, 0.5f * doubleArea);
+                }
+            }
+        }
+
+        struct Collapse
+        {
+            uint32_t m_vertex = 0;
+            uint32_t m_target = 0;
+            double m_error = 0.0;
+        };
+
+        double maxCollapseError = 0.0;
+
+        Internal::TriangleAdjacency adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> collapseTargets(vertexCount);
+        std::vector<bool> touchedVertices(vertexCount);
+
+        // Each pass collapses as many independent edges as possible, in order of increasing error.
+        while (simplifiedIndices.size() > targetIndexCount)
+        {
+            adjacency.Build(simplifiedIndices, vertexCount);
+
+            // Cheapest collapse of each vertex into one of its neighbours.
+            // Half edge collapses move the vertex to the neighbour's position, so no new vertices are needed.
+            collapses.clear();
+            for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                if (lockedVertices[vertex])
+                {
+                    continue;
+                }
+
+                Collapse bestCollapse = { vertex, vertex, std::numeric_limits<double>::max() };
+                for (const uint32_t triangle : adjacency.GetTriangles(vertex))
+                {
+                    for (size_t corner = 0; corner < 3; ++corner)
+                    {
+                        const Index target = simplifiedIndices[triangle * 3 + corner];
+                        if (target == vertex)
+                        {
+                            continue;
+                        }
+
+                        if (const double error = quadrics[vertex].Evaluate(getPosition(target));
+                            error < bestCollapse.m_error)
+                        {
+                            bestCollapse = { vertex, target, error };
+                        }
+                    }
+                }
+
+                if (bestCollapse.m_target != vertex && bestCollapse.m_error <= maxErrorSquared)
+                {
+                    collapses.push_back(bestCollapse);
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(),
+                [](const Collapse& lhs, const Collapse& rhs)
+                {
+                    return lhs.m_error < rhs.m_error;
+                });
+
+            std::iota(collapseTargets.begin(), collapseTargets.end(), 0);
+            std::fill(touchedVertices.begin(), touchedVertices.end(), false);
+
+            const size_t trianglesToRemove = (simplifiedIndices.size() - targetIndexCount) / 3;
+            size_t removedTriangles = 0;
+            size_t collapseCount = 0;
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (removedTriangles >= trianglesToRemove)
+                {
+                    break;
+                }
+
+                if (touchedVertices[collapse.m_vertex] || touchedVertices[collapse.m_target] ||
+                    !Internal::IsCollapseValid(simplifiedIndices, vertices, adjacency, collapse.m_vertex, collapse.m_target))
+                {
+                    continue;
+                }
+
+                collapseTargets[collapse.m_vertex] = collapse.m_target;
+                quadrics[collapse.m_target].Add(quadrics[collapse.m_vertex]);
+                maxCollapseError = std::max(maxCollapseError, collapse.m_error);
+                ++collapseCount;
+
+                // Triangles around the vertex change, so its neighbours are
+                // not collapsed again until adjacency is rebuilt next pass.
+                for (const uint32_t triangle : adjacency.GetTriangles(collapse.m_vertex))
+                {
+                    const Index* triangleIndices = &simplifiedIndices[triangle * 3];
+                    touchedVertices[triangleIndices[0]] = true;
+                    touchedVertices[triangleIndices[1]] = true;
+                    touchedVertices[triangleIndices[2]] = true;
+
+                    if (triangleIndices[0] == collapse.m_target ||
+                        triangleIndices[1] == collapse.m_target ||
+                        triangleIndices[2] == collapse.m_target)
+                    {
+                        ++removedTriangles;
+                    }
+                }
+            }
+
+            if (collapseCount == 0)
+            {
+                break; // No more collapses within the error allowed
+            }
+
+            // Apply collapses and remove the triangles that became degenerate
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < simplifiedIndices.size(); i += 3)
+            {
+                const Index a = collapseTargets[simplifiedIndices[i + 0]];
+                const Index b = collapseTargets[simplifiedIndices[i + 1]];
+                const Index c = collapseTargets[simplifiedIndices[i + 2]];
+                if (a != b && b != c && c != a)
+                {
+                    simplifiedIndices[writeIndex++] = a;
+                    simplifiedIndices[writeIndex++] = b;
+                    simplifiedIndices[writeIndex++] = c;
+                }
+            }
+            simplifiedIndices.resize(writeIndex);
+        }
+
+        if (resultError)
+        {
+            *resultError = static_cast<float>(std::sqrt(maxCollapseError)) / meshSize;
+        }
+
+        return simplifiedIndices;
+    }
+} // namespace DX
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Assets/Vertices.h>
+
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    // Post-transform vertex cache statistics of an index buffer.
+    struct VertexCacheStatistics
+    {
+        uint32_t m_cacheMisses = 0;
+
+        // Average Cache Miss Ratio: vertex shader invocations per triangle.
+        // Ranges from 3.0 (worst) down to ~0.5 for regular grids.
+        float m_acmr = 0.0f;
+
+        // Average Transformed Vertex Ratio: vertex shader invocations per vertex.
+        // 1.0 is optimal, each vertex is transformed only once.
+        float m_atvr = 0.0f;
+    };
+
+    // Simulates a FIFO post-transform vertex cache of the size indicated.
+    VertexCacheStatistics AnalyzeVertexCache(std::span<const Index> indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+    // Reorders triangles to improve the hit rate of the post-transform vertex cache.
+    // Implementation of Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+    void OptimizeVertexCache(std::span<Index> indices, uint32_t vertexCount);
+
+    // Reorders clusters of triangles so the ones facing outwards are drawn first,
+    // reducing overdraw. Clusters are split at vertex cache flushes so the vertex
+    // cache efficiency is kept, it should be called after OptimizeVertexCache.
+    // If the resulting ACMR is worse than threshold times the original, it's discarded.
+    void OptimizeOverdraw(std::span<Index> indices, std::span<const VertexPNTBUv> vertices, float threshold = 1.05f);
+
+    // Reorders vertices in the order they are first referenced by the indices,
+    // improving the locality of vertex fetches. Vertices not referenced are removed.
+    void OptimizeVertexFetch(std::vector<VertexPNTBUv>& vertices, std::span<Index> indices);
+
+    // Simplifies a mesh by collapsing edges with the lowest quadric error, until the index
+    // count reaches the target or the error would exceed targetError (relative to the mesh size).
+    // Vertices are not modified, the simplified indices reference the same vertices.
+    // Vertices on borders and attribute seams are kept in place to preserve the mesh silhouette
+    // and its texture mapping. The error reached is returned in resultError if not null.
+    std::vector<Index> SimplifyMesh(std::span<const Index> indices, std::span<const VertexPNTBUv> vertices,
+        size_t targetIndexCount, float targetError, float* resultError = nullptr);
+} // namespace DX
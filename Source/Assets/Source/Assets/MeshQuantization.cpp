@@ -0,0 +1,296 @@
+#include <Assets/MeshQuantization.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr float PositionQuantizationScale = 65535.0f; // 16 bits UNORM
+        static constexpr float QTangentQuantizationScale = 127.0f; // 8 bits SNORM
+
+        // Minimum absolute value of the quaternion's w component, so it's never
+        // quantized to zero and its sign can always store the handedness.
+        static constexpr float QTangentBias = 1.0f / QTangentQuantizationScale;
+
+        struct QuaternionValues
+        {
+            float x, y, z, w;
+        };
+
+        // Rotation matrix with columns tangent, binormal and normal to quaternion.
+        QuaternionValues TangentFrameToQuaternion(const Math::Vector3& tangent, const Math::Vector3& binormal, const Math::Vector3& normal)
+        {
+            const float m00 = tangent.x, m01 = binormal.x, m02 = normal.x;
+            const float m10 = tangent.y, m11 = binormal.y, m12 = normal.y;
+            const float m20 = tangent.z, m21 = binormal.z, m22 = normal.z;
+
+            QuaternionValues q;
+            if (const float trace = m00 + m11 + m22;
+                trace > 0.0f)
+            {
+                const float s = std::sqrt(trace + 1.0f) * 2.0f;
+                q = { (m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s, 0.25f * s };
+            }
+            else if (m00 > m11 && m00 > m22)
+            {
+                const float s = std::sqrt(1.0f + m00 - m11 - m22) * 2.0f;
+                q = { 0.25f * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s };
+            }
+            else if (m11 > m22)
+            {
+                const float s = std::sqrt(1.0f + m11 - m00 - m22) * 2.0f;
+                q = { (m01 + m10) / s, 0.25f * s, (m12 + m21) / s, (m02 - m20) / s };
+            }
+            else
+            {
+                const float s = std::sqrt(1.0f + m22 - m00 - m11) * 2.0f;
+                q = { (m02 + m20) / s, (m12 + m21) / s, 0.25f * s, (m10 - m01) / s };
+            }
+
+            const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+            return { q.x / length, q.y / length, q.z / length, q.w / length };
+        }
+
+        Math::Vector3 AnyPerpendicular(const Math::Vector3& vector)
+        {
+            const Math::Vector3 axis = (std::abs(vector.x) < 0.9f) ? Math::Vector3(1.0f, 0.0f, 0.0f) : Math::Vector3(0.0f, 1.0f, 0.0f);
+            return Math::Normalize(Math::Cross(vector, axis));
+        }
+
+        void EncodeQTangent(int8_t* qtangent, const VertexPNTBUv& vertex)
+        {
+            const Math::Vector3 normal = Math::Normalize(Math::Vector3(vertex.m_normal));
+
+            // Gram-Schmidt orthogonalize the tangent against the normal
+            Math::Vector3 tangent = Math::Vector3(vertex.m_tangent);
+            tangent -= normal * Math::Dot(normal, tangent);
+            tangent = (tangent.LengthSquared() > 1e-12f) ? Math::Normalize(tangent) : AnyPerpendicular(normal);
+
+            // The binormal is rebuilt in the shader from the normal and tangent,
+            // only whether it points to the same side as the original is kept.
+            const Math::Vector3 binormal = Math::Cross(normal, tangent);
+            const float handedness = (Math::Dot(binormal, Math::Vector3(vertex.m_binormal)) < 0.0f) ? -1.0f : 1.0f;
+
+            QuaternionValues q = TangentFrameToQuaternion(tangent, binormal, normal);
+
+            // q and -q represent the same rotation, keep w positive to use its sign for the handedness.
+            if (q.w < 0.0f)
+            {
+                q = { -q.x, -q.y, -q.z, -q.w };
+            }
+
+            if (q.w < QTangentBias)
+            {
+                const float xyzLength = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+                const float xyzScale = std::sqrt(1.0f - QTangentBias * QTangentBias) / xyzLength;
+                q = { q.x * xyzScale, q.y * xyzScale, q.z * xyzScale, QTangentBias };
+            }
+
+            const float components[4] = { q.x * handedness, q.y * handedness, q.z * handedness, q.w * handedness };
+            for (int i = 0; i < 4; ++i)
+            {
+                qtangent[i] = static_cast<int8_t>(std::round(std::clamp(components[i], -1.0f, 1.0f) * QTangentQuantizationScale));
+            }
+        }
+
+        // Same decoding as the vertex shader.
+        void DecodeQTangent(VertexPNTBUv& vertex, const int8_t* qtangent)
+        {
+            float q[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                q[i] = std::max(qtangent[i] / QTangentQuantizationScale, -1.0f); // SNORM conversion
+            }
+            const float handedness = (q[3] < 0.0f) ? -1.0f : 1.0f;
+
+            const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            const float x = q[0] / length, y = q[1] / length, z = q[2] / length, w = q[3] / length;
+
+            const Math::Vector3 tangent(
+                1.0f - 2.0f * (y * y + z * z),
+                2.0f * (x * y + w * z),
+                2.0f * (x * z - w * y));
+            const Math::Vector3 normal(
+                2.0f * (x * z + w * y),
+                2.0f * (y * z - w * x),
+                1.0f - 2.0f * (x * x + y * y));
+
+            vertex.m_tangent = tangent;
+            vertex.m_normal = normal;
+            vertex.m_binormal = Math::Cross(normal, tangent) * handedness;
+        }
+    } // namespace Internal
+
+    MeshBounds CalculateMeshBounds(std::span<const VertexPNTBUv> vertices)
+    {
+        if (vertices.empty())
+        {
+            return MeshBounds{ Math::Vector3Packed(Math::Vector3(0.0f)), Math::Vector3Packed(Math::Vector3(0.0f)) };
+        }
+
+        Math::Vector3 min(std::numeric_limits<float>::max());
+        Math::Vector3 max(std::numeric_limits<float>::lowest());
+        for (const auto& vertex : vertices)
+        {
+            min = Math::Vector3::Min(min, Math::Vector3(vertex.m_position));
+            max = Math::Vector3::Max(max, Math::Vector3(vertex.m_position));
+        }
+
+        return MeshBounds{ Math::Vector3Packed(min), Math::Vector3Packed(max) };
+    }
+
+    std::vector<VertexCompact> QuantizeVertices(std::span<const VertexPNTBUv> vertices, const MeshBounds& bounds)
+    {
+        const Math::Vector3 min(bounds.m_min);
+        const Math::Vector3 extent = Math::Vector3(bounds.m_max) - min;
+
+        std::vector<VertexCompact> compactVertices(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const VertexPNTBUv& vertex = vertices[i];
+            VertexCompact& compactVertex = compactVertices[i];
+
+            const Math::Vector3 position = Math::Vector3(vertex.m_position) - min;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const float normalized = (extent[axis] > 0.0f) ? std::clamp(position[axis] / extent[axis], 0.0f, 1.0f) : 0.0f;
+                compactVertex.m_position[axis] = static_cast<uint16_t>(std::round(normalized * Internal::PositionQuantizationScale));
+            }
+            compactVertex.m_position[3] = 0;
+
+            Internal::EncodeQTangent(compactVertex.m_qtangent, vertex);
+
+            compactVertex.m_uv[0] = FloatToHalf(vertex.m_uv.x);
+            compactVertex.m_uv[1] = FloatToHalf(vertex.m_uv.y);
+        }
+
+        return compactVertices;
+    }
+
+    VertexPNTBUv DequantizeVertex(const VertexCompact& vertex, const MeshBounds& bounds)
+    {
+        const Math::Vector3 min(bounds.m_min);
+        const Math::Vector3 extent = Math::Vector3(bounds.m_max) - min;
+
+        VertexPNTBUv result;
+        result.m_position = min + extent * Math::Vector3(
+            vertex.m_position[0] / Internal::PositionQuantizationScale,
+            vertex.m_position[1] / Internal::PositionQuantizationScale,
+            vertex.m_position[2] / Internal::PositionQuantizationScale);
+
+        Internal::DecodeQTangent(result, vertex.m_qtangent);
+
+        result.m_uv.x = HalfToFloat(vertex.m_uv[0]);
+        result.m_uv.y = HalfToFloat(vertex.m_uv[1]);
+        return result;
+    }
+
+    QuantizationError CalculateQuantizationError(
+        std::span<const VertexPNTBUv> vertices, std::span<const VertexCompact> compactVertices, const MeshBounds& bounds)
+    {
+        QuantizationError error;
+
+        const size_t vertexCount = std::min(vertices.size(), compactVertices.size());
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            const VertexPNTBUv decoded = DequantizeVertex(compactVertices[i], bounds);
+
+            error.m_maxPositionError = std::max(error.m_maxPositionError,
+                Math::Vector3::Distance(Math::Vector3(vertices[i].m_position), Math::Vector3(decoded.m_position)));
+
+            const float cosAngle = Math::Dot(
+                Math::Normalize(Math::Vector3(vertices[i].m_normal)),
+                Math::Normalize(Math::Vector3(decoded.m_normal)));
+            error.m_maxNormalErrorDegrees = std::max(error.m_maxNormalErrorDegrees,
+                std::acos(std::clamp(cosAngle, -1.0f, 1.0f)) * 57.2957795f);
+
+            error.m_maxUvError = std::max({ error.m_maxUvError,
+                std::abs(vertices[i].m_uv.x - decoded.m_uv.x),
+                std::abs(vertices[i].m_uv.y - decoded.m_uv.y) });
+        }
+
+        return error;
+    }
+
+    uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const uint32_t sign = (bits >> 16) & 0x8000;
+        const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF);
+        uint32_t mantissa = bits & 0x7FFFFF;
+
+        // Infinity or NaN
+        if (exponent == 0xFF)
+        {
+            return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+        }
+
+        const int32_t halfExponent = exponent - 127 + 15;
+
+        // Overflow, becomes infinity
+        if (halfExponent >= 0x1F)
+        {
+            return static_cast<uint16_t>(sign | 0x7C00);
+        }
+
+        // Subnormal half or zero
+        if (halfExponent <= 0)
+        {
+            if (halfExponent < -10)
+            {
+                return static_cast<uint16_t>(sign);
+            }
+
+            mantissa |= 0x800000; // Implicit leading bit
+            const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+            uint32_t halfMantissa = mantissa >> shift;
+
+            // Round to nearest even
+            const uint32_t remainder = mantissa & ((1u << shift) - 1);
+            const uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (halfMantissa & 1)))
+            {
+                ++halfMantissa;
+            }
+            return static_cast<uint16_t>(sign | halfMantissa);
+        }
+
+        uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+
+        // Round to nearest even, a carry into the exponent is still correct.
+        const uint32_t remainder = mantissa & 0x1FFF;
+        if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+        {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    float HalfToFloat(uint16_t value)
+    {
+        const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1F;
+        const uint32_t mantissa = value & 0x3FF;
+
+        if (exponent == 0)
+        {
+            // Zero or subnormal
+            const float result = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -result : result;
+        }
+
+        const uint32_t bits = (exponent == 0x1F)
+            ? (sign | 0x7F800000 | (mantissa << 13)) // Infinity or NaN
+            : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+} // namespace DX
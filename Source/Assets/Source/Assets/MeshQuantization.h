@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Assets/Vertices.h>
+#include <Math/Vector3.h>
+
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    // Axis aligned bounds of the vertex positions of a mesh.
+    struct MeshBounds
+    {
+        Math::Vector3Packed m_min;
+        Math::Vector3Packed m_max;
+    };
+
+    // Maximum errors introduced by quantizing vertices.
+    struct QuantizationError
+    {
+        float m_maxPositionError = 0.0f; // In mesh units
+        float m_maxNormalErrorDegrees = 0.0f;
+        float m_maxUvError = 0.0f;
+    };
+
+    MeshBounds CalculateMeshBounds(std::span<const VertexPNTBUv> vertices);
+
+    // Encodes vertices into the compact format. Positions are quantized relative to the bounds.
+    std::vector<VertexCompact> QuantizeVertices(std::span<const VertexPNTBUv> vertices, const MeshBounds& bounds);
+
+    // Decodes a compact vertex back into the full format, the same way the vertex shader does.
+    VertexPNTBUv DequantizeVertex(const VertexCompact& vertex, const MeshBounds& bounds);
+
+    // Compares the original vertices with their quantized version.
+    QuantizationError CalculateQuantizationError(
+        std::span<const VertexPNTBUv> vertices, std::span<const VertexCompact> compactVertices, const MeshBounds& bounds);
+
+    // Conversions between 32 bits and 16 bits floats (IEEE 754 half precision).
+    uint16_t FloatToHalf(float value);
+    float HalfToFloat(uint16_t value);
+} // namespace DX
@@ -0,0 +1,366 @@
+#include <Assets/MeshVertexProcessing.h>
+#include <Hash/Hash.h>
+#include <Math/Vector2.h>
+#include <Math/Vector3.h>
+#include <Thread/ThreadPool.h>
+
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t InvalidVertex = std::numeric_limits<uint32_t>::max();
+
+        // Number of faces or vertices processed by each job.
+        static constexpr uint32_t VertexProcessingJobSize = 16 * 1024;
+
+        // Calls func(begin, end) with consecutive ranges covering [0, count),
+        // in parallel when a thread pool is provided.
+        void ParallelForRanges(ThreadPool* threadPool, uint32_t count, const std::function<void(uint32_t begin, uint32_t end)>& func)
+        {
+            const uint32_t rangeCount = (count + VertexProcessingJobSize - 1) / VertexProcessingJobSize;
+            if (threadPool && rangeCount > 1)
+            {
+                threadPool->ParallelFor(rangeCount, [count, &func](uint32_t rangeIndex)
+                    {
+                        const uint32_t begin = rangeIndex * VertexProcessingJobSize;
+                        func(begin, std::min(begin + VertexProcessingJobSize, count));
+                    });
+            }
+            else if (count > 0)
+            {
+                func(0, count);
+            }
+        }
+
+        bool IsZero(const Math::Vector3Packed& vector)
+        {
+            return vector.data[0] == 0.0f && vector.data[1] == 0.0f && vector.data[2] == 0.0f;
+        }
+
+        Math::Vector3 NormalizedOrZero(const Math::Vector3& vector)
+        {
+            const float length = vector.Length();
+            return (length > 0.0f) ? vector / length : Math::Vector3(0.0f);
+        }
+
+        // Finds, for each element, the first element equal to it. Elements are looked up
+        // by their hash in an open addressing table and compared when the hashes match.
+        template<typename EqualFunc>
+        std::vector<uint32_t> FindFirstEqualElements(std::span<const HashValue> hashes, EqualFunc equal)
+        {
+            const uint32_t count = static_cast<uint32_t>(hashes.size());
+
+            // Power of two at least twice the element count, so probe sequences are short.
+            size_t tableSize = 16;
+            while (tableSize < static_cast<size_t>(count) * 2)
+            {
+                tableSize *= 2;
+            }
+            const size_t tableMask = tableSize - 1;
+
+            std::vector<uint32_t> table(tableSize, InvalidVertex);
+            std::vector<uint32_t> firstEqual(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                for (size_t slot = hashes[i] & tableMask;; slot = (slot + 1) & tableMask)
+                {
+                    const uint32_t candidate = table[slot];
+                    if (candidate == InvalidVertex)
+                    {
+                        table[slot] = i;
+                        firstEqual[i] = i;
+                        break;
+                    }
+                    if (hashes[candidate] == hashes[i] && equal(candidate, i))
+                    {
+                        firstEqual[i] = candidate;
+                        break;
+                    }
+                }
+            }
+            return firstEqual;
+        }
+
+        // Face corners around each vertex, stored contiguously per vertex.
+        // Corner c is vertex c % 3 of face c / 3.
+        struct VertexCorners
+        {
+            std::vector<uint32_t> m_offsets; // Vertex count + 1
+            std::vector<uint32_t> m_corners;
+
+            std::span<const uint32_t> Get(uint32_t vertexIndex) const
+            {
+                return std::span<const uint32_t>(m_corners.data() + m_offsets[vertexIndex],
+                    m_offsets[vertexIndex + 1] - m_offsets[vertexIndex]);
+            }
+        };
+
+        // When vertex groups are provided, the corners of each vertex are stored
+        // with the group it belongs to (the first vertex of the group).
+        VertexCorners BuildVertexCorners(std::span<const Index> indices, uint32_t vertexCount, std::span<const uint32_t> vertexGroups = {})
+        {
+            auto getVertex = [&](uint32_t corner)
+            {
+                return vertexGroups.empty() ? indices[corner] : vertexGroups[indices[corner]];
+            };
+
+            VertexCorners vertexCorners;
+            vertexCorners.m_offsets.assign(vertexCount + 1, 0);
+            for (uint32_t corner = 0; corner < indices.size(); ++corner)
+            {
+                ++vertexCorners.m_offsets[getVertex(corner) + 1];
+            }
+            for (uint32_t i = 0; i < vertexCount; ++i)
+            {
+                vertexCorners.m_offsets[i + 1] += vertexCorners.m_offsets[i];
+            }
+
+            std::vector<uint32_t> cursors(vertexCorners.m_offsets.begin(), vertexCorners.m_offsets.end() - 1);
+            vertexCorners.m_corners.resize(indices.size());
+            for (uint32_t corner = 0; corner < indices.size(); ++corner)
+            {
+                vertexCorners.m_corners[cursors[getVertex(corner)]++] = corner;
+            }
+            return vertexCorners;
+        }
+
+        // Orthonormal basis for vertices whose texture coordinates don't define a tangent.
+        void CalculateAnyTangentBasis(const Math::Vector3& normal, Math::Vector3& tangent, Math::Vector3& binormal)
+        {
+            const Math::Vector3 axis = (std::abs(normal.x) < 0.9f) ? Math::Vector3(1.0f, 0.0f, 0.0f) : Math::Vector3(0.0f, 1.0f, 0.0f);
+            tangent = NormalizedOrZero(Math::Vector3::CrossProduct(axis, normal));
+            binormal = Math::Vector3::CrossProduct(normal, tangent);
+        }
+    } // namespace Internal
+
+    void GenerateSmoothNormals(std::span<VertexPNTBUv> vertices, std::span<const Index> indices, ThreadPool* threadPool)
+    {
+        if (std::none_of(vertices.begin(), vertices.end(), [](const VertexPNTBUv& vertex) { return Internal::IsZero(vertex.m_normal); }))
+        {
+            return;
+        }
+
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        const uint32_t faceCount = static_cast<uint32_t>(indices.size() / 3);
+
+        std::vector<Math::Vector3Packed> faceNormals(faceCount);
+        Internal::ParallelForRanges(threadPool, faceCount, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t face = begin; face < end; ++face)
+                {
+                    const Math::Vector3 position0(vertices[indices[face * 3 + 0]].m_position);
+                    const Math::Vector3 position1(vertices[indices[face * 3 + 1]].m_position);
+                    const Math::Vector3 position2(vertices[indices[face * 3 + 2]].m_position);
+
+                    // Degenerate faces don't contribute.
+                    Internal::NormalizedOrZero(
+                        Math::Vector3::CrossProduct(position1 - position0, position2 - position0)).Pack(&faceNormals[face]);
+                }
+            });
+
+        // Vertices with the same position are grouped, so the normal is smooth across seams.
+        std::vector<HashValue> positionHashes(vertexCount);
+        Internal::ParallelForRanges(threadPool, vertexCount, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    positionHashes[i] = HashValueOf(vertices[i].m_position);
+                }
+            });
+
+        const std::vector<uint32_t> positionGroups = Internal::FindFirstEqualElements(positionHashes,
+            [vertices](uint32_t vertexIndexA, uint32_t vertexIndexB)
+            {
+                return std::memcmp(&vertices[vertexIndexA].m_position, &vertices[vertexIndexB].m_position, sizeof(Math::Vector3Packed)) == 0;
+            });
+
+        const Internal::VertexCorners groupCorners = Internal::BuildVertexCorners(indices, vertexCount, positionGroups);
+
+        Internal::ParallelForRanges(threadPool, vertexCount, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    if (!Internal::IsZero(vertices[i].m_normal))
+                    {
+                        continue;
+                    }
+
+                    Math::Vector3 normal(0.0f);
+                    for (const uint32_t corner : groupCorners.Get(positionGroups[i]))
+                    {
+                        normal += Math::Vector3(faceNormals[corner / 3]);
+                    }
+                    Internal::NormalizedOrZero(normal).Pack(&vertices[i].m_normal);
+                }
+            });
+    }
+
+    uint32_t WeldVertices(std::span<VertexPNTBUv> vertices, std::span<Index> indices, ThreadPool* threadPool)
+    {
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+        std::vector<HashValue> vertexHashes(vertexCount);
+        Internal::ParallelForRanges(threadPool, vertexCount, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    vertexHashes[i] = HashValueOf(vertices[i]);
+                }
+            });
+
+        const std::vector<uint32_t> firstEqualVertices = Internal::FindFirstEqualElements(vertexHashes,
+            [vertices](uint32_t vertexIndexA, uint32_t vertexIndexB)
+            {
+                return std::memcmp(&vertices[vertexIndexA], &vertices[vertexIndexB], sizeof(VertexPNTBUv)) == 0;
+            });
+
+        // The first vertex of each group is kept, the others take its new index.
+        // A vertex's first equal vertex always comes before it, so it's already remapped.
+        std::vector<uint32_t> remap(vertexCount);
+        uint32_t weldedVertexCount = 0;
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            if (firstEqualVertices[i] == i)
+            {
+                vertices[weldedVertexCount] = vertices[i];
+                remap[i] = weldedVertexCount++;
+            }
+            else
+            {
+                remap[i] = remap[firstEqualVertices[i]];
+            }
+        }
+
+        Internal::ParallelForRanges(threadPool, static_cast<uint32_t>(indices.size()), [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    indices[i] = remap[indices[i]];
+                }
+            });
+
+        return weldedVertexCount;
+    }
+
+    void GenerateTangents(std::span<VertexPNTBUv> vertices, std::span<const Index> indices, ThreadPool* threadPool)
+    {
+        if (std::none_of(vertices.begin(), vertices.end(), [](const VertexPNTBUv& vertex) { return Internal::IsZero(vertex.m_tangent); }))
+        {
+            return;
+        }
+
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        const uint32_t faceCount = static_cast<uint32_t>(indices.size() / 3);
+
+        // Contribution of each face corner to the tangent and binormal of its vertex.
+        std::vector<Math::Vector3Packed> cornerTangents(faceCount * 3);
+        std::vector<Math::Vector3Packed> cornerBinormals(faceCount * 3);
+        Internal::ParallelForRanges(threadPool, faceCount, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t face = begin; face < end; ++face)
+                {
+                    const VertexPNTBUv* faceVertices[3] =
+                    {
+                        &vertices[indices[face * 3 + 0]],
+                        &vertices[indices[face * 3 + 1]],
+                        &vertices[indices[face * 3 + 2]]
+                    };
+
+                    const Math::Vector3 positions[3] =
+                    {
+                        Math::Vector3(faceVertices[0]->m_position),
+                        Math::Vector3(faceVertices[1]->m_position),
+                        Math::Vector3(faceVertices[2]->m_position)
+                    };
+
+                    const Math::Vector3 edge1 = positions[1] - positions[0];
+                    const Math::Vector3 edge2 = positions[2] - positions[0];
+                    const Math::Vector2 deltaUv1 = Math::Vector2(faceVertices[1]->m_uv) - Math::Vector2(faceVertices[0]->m_uv);
+                    const Math::Vector2 deltaUv2 = Math::Vector2(faceVertices[2]->m_uv) - Math::Vector2(faceVertices[0]->m_uv);
+
+                    // Faces without texture mapping don't contribute.
+                    const float determinant = deltaUv1.x * deltaUv2.y - deltaUv2.x * deltaUv1.y;
+                    if (determinant == 0.0f)
+                    {
+                        for (uint32_t corner = face * 3; corner < face * 3 + 3; ++corner)
+                        {
+                            Math::Vector3(0.0f).Pack(&cornerTangents[corner]);
+                            Math::Vector3(0.0f).Pack(&cornerBinormals[corner]);
+                        }
+                        continue;
+                    }
+
+                    // Only the direction is used, so the determinant is applied by its sign.
+                    const float sign = (determinant < 0.0f) ? -1.0f : 1.0f;
+                    const Math::Vector3 faceTangent = (edge1 * deltaUv2.y - edge2 * deltaUv1.y) * sign;
+                    const Math::Vector3 faceBinormal = (edge2 * deltaUv1.x - edge1 * deltaUv2.x) * sign;
+
+                    for (uint32_t i = 0; i < 3; ++i)
+                    {
+                        const Math::Vector3 normal(faceVertices[i]->m_normal);
+                        auto projectToTangentPlane = [&normal](const Math::Vector3& vector)
+                        {
+                            return Internal::NormalizedOrZero(vector - normal * Math::Vector3::DotProduct(vector, normal));
+                        };
+
+                        // Angle of the face corner in the tangent plane.
+                        const Math::Vector3 cornerEdge1 = projectToTangentPlane(positions[(i + 1) % 3] - positions[i]);
+                        const Math::Vector3 cornerEdge2 = projectToTangentPlane(positions[(i + 2) % 3] - positions[i]);
+                        const float cornerAngle = std::acos(std::clamp(Math::Vector3::DotProduct(cornerEdge1, cornerEdge2), -1.0f, 1.0f));
+
+                        (projectToTangentPlane(faceTangent) * cornerAngle).Pack(&cornerTangents[face * 3 + i]);
+                        (projectToTangentPlane(faceBinormal) * cornerAngle).Pack(&cornerBinormals[face * 3 + i]);
+                    }
+                }
+            });
+
+        const Internal::VertexCorners vertexCorners = Internal::BuildVertexCorners(indices, vertexCount);
+
+        Internal::ParallelForRanges(threadPool, vertexCount, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    VertexPNTBUv& vertex = vertices[i];
+                    if (!Internal::IsZero(vertex.m_tangent))
+                    {
+                        continue;
+                    }
+
+                    Math::Vector3 tangentSum(0.0f);
+                    Math::Vector3 binormalSum(0.0f);
+                    for (const uint32_t corner : vertexCorners.Get(i))
+                    {
+                        tangentSum += Math::Vector3(cornerTangents[corner]);
+                        binormalSum += Math::Vector3(cornerBinormals[corner]);
+                    }
+
+                    const Math::Vector3 normal(vertex.m_normal);
+                    Math::Vector3 tangent = Internal::NormalizedOrZero(tangentSum - normal * Math::Vector3::DotProduct(tangentSum, normal));
+                    Math::Vector3 binormal;
+                    if (tangent.LengthSquared() > 0.0f)
+                    {
+                        // The binormal is orthogonal to both, on the side of the texture mapping.
+                        binormal = Math::Vector3::CrossProduct(normal, tangent);
+                        if (Math::Vector3::DotProduct(binormal, binormalSum) < 0.0f)
+                        {
+                            binormal = -binormal;
+                        }
+                    }
+                    else
+                    {
+                        Internal::CalculateAnyTangentBasis(normal, tangent, binormal);
+                    }
+
+                    tangent.Pack(&vertex.m_tangent);
+                    binormal.Pack(&vertex.m_binormal);
+                }
+            });
+    }
+} // namespace DX
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Assets/Vertices.h>
+
+#include <span>
+
+namespace DX
+{
+    class ThreadPool;
+
+    // Generates the normals of the vertices that don't have one (zero normal).
+    // Each vertex gets the average of the normals of all the faces around its
+    // position, so vertices split by texture seams get the same normal.
+    // Like Assimp's GenSmoothNormals, face normals are not weighted by area.
+    // When a thread pool is provided faces and vertices are processed in parallel.
+    void GenerateSmoothNormals(std::span<VertexPNTBUv> vertices, std::span<const Index> indices,
+        ThreadPool* threadPool = nullptr);
+
+    // Merges the vertices with all attributes identical, found by hashing them.
+    // The vertices kept are moved to the front in the order they appear and
+    // indices are remapped to them. Returns the new vertex count.
+    // When a thread pool is provided hashes and indices are processed in parallel.
+    uint32_t WeldVertices(std::span<VertexPNTBUv> vertices, std::span<Index> indices,
+        ThreadPool* threadPool = nullptr);
+
+    // Generates the tangents and binormals of the vertices that don't have a tangent (zero tangent)
+    // from the texture coordinates, following MikkTSpace: the tangent of each face is projected
+    // onto the tangent plane of the vertex normal and weighted by the angle of the face corner,
+    // then the sum is orthonormalized and the binormal keeps the handedness of the texture mapping.
+    // Vertices must be welded so all faces sharing position, normal and texture coordinates
+    // contribute to the same vertex. Unlike MikkTSpace, vertices are not split when their faces
+    // have opposite handedness. Vertices without valid texture coordinates get any orthonormal basis.
+    // When a thread pool is provided faces and vertices are processed in parallel.
+    void GenerateTangents(std::span<VertexPNTBUv> vertices, std::span<const Index> indices,
+        ThreadPool* threadPool = nullptr);
+} // namespace DX
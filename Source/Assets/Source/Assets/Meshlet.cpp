@@ -0,0 +1,176 @@
+#include <Assets/Meshlet.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint8_t UnusedLocalIndex = 0xFF;
+
+        // Normal cones wider than this (dot between axis and normals) can't be culled in practice.
+        static constexpr float MeshletMinConeSpread = 0.1f;
+
+        void CalculateMeshletBounds(Meshlet& meshlet, const MeshletData& meshletData, std::span<const VertexPNTBUv> vertices)
+        {
+            auto getPosition = [&](uint32_t localIndex)
+            {
+                return Math::Vector3(vertices[meshletData.m_meshletVertices[meshlet.m_vertexOffset + localIndex]].m_position);
+            };
+
+            // Bounding sphere centered at the center of the bounding box
+            Math::Vector3 min(std::numeric_limits<float>::max());
+            Math::Vector3 max(std::numeric_limits<float>::lowest());
+            for (uint32_t i = 0; i < meshlet.m_vertexCount; ++i)
+            {
+                min = Math::Vector3::Min(min, getPosition(i));
+                max = Math::Vector3::Max(max, getPosition(i));
+            }
+
+            const Math::Vector3 center = 0.5f * (min + max);
+            float radius = 0.0f;
+            for (uint32_t i = 0; i < meshlet.m_vertexCount; ++i)
+            {
+                radius = std::max(radius, (getPosition(i) - center).Length());
+            }
+
+            meshlet.m_center = center;
+            meshlet.m_radius = radius;
+
+            // Normal cone
+            std::vector<Math::Vector3> triangleNormals;
+            std::vector<Math::Vector3> trianglePositions;
+            triangleNormals.reserve(meshlet.m_triangleCount);
+            trianglePositions.reserve(meshlet.m_triangleCount);
+
+            Math::Vector3 axis(0.0f);
+            for (uint32_t triangle = 0; triangle < meshlet.m_triangleCount; ++triangle)
+            {
+                const uint8_t* localIndices = &meshletData.m_meshletTriangles[meshlet.m_triangleOffset + triangle * 3];
+                const Math::Vector3 p0 = getPosition(localIndices[0]);
+                const Math::Vector3 p1 = getPosition(localIndices[1]);
+                const Math::Vector3 p2 = getPosition(localIndices[2]);
+
+                const Math::Vector3 normal = Math::Vector3::CrossProduct(p1 - p0, p2 - p0);
+                if (const float length = normal.Length();
+                    length > 0.0f)
+                {
+                    triangleNormals.push_back(normal / length);
+                    trianglePositions.push_back(p0);
+                    axis += normal / length;
+                }
+            }
+
+            meshlet.m_coneApex = center;
+            meshlet.m_coneAxis = Math::Vector3(0.0f, 0.0f, 1.0f);
+            meshlet.m_coneCutoff = 1.0f;
+
+            const float axisLength = axis.Length();
+            if (axisLength <= 0.0f)
+            {
+                return;
+            }
+            axis /= axisLength;
+
+            float minDot = 1.0f;
+            for (const Math::Vector3& normal : triangleNormals)
+            {
+                minDot = std::min(minDot, Math::Vector3::DotProduct(normal, axis));
+            }
+
+            meshlet.m_coneAxis = axis;
+
+            if (minDot <= MeshletMinConeSpread)
+            {
+                return;
+            }
+
+            // Move the apex back along the axis until it's behind the planes of all
+            // triangles, so the test is conservative from any position in front of it.
+            float maxOffset = 0.0f;
+            for (size_t i = 0; i < triangleNormals.size(); ++i)
+            {
+                const float offset = Math::Vector3::DotProduct(center - trianglePositions[i], triangleNormals[i]) /
+                    Math::Vector3::DotProduct(axis, triangleNormals[i]);
+                maxOffset = std::max(maxOffset, offset);
+            }
+
+            meshlet.m_coneApex = center - axis * maxOffset;
+            meshlet.m_coneCutoff = std::sqrt(1.0f - minDot * minDot); // Sine of the cone's half angle
+        }
+    } // namespace Internal
+
+    MeshletData BuildMeshlets(std::span<const Index> indices, std::span<const VertexPNTBUv> vertices,
+        uint32_t maxVertices, uint32_t maxTriangles)
+    {
+        DX_ASSERT(maxVertices >= 3 && maxVertices < Internal::UnusedLocalIndex, "Meshlet", "Invalid max vertices per meshlet %u", maxVertices);
+        DX_ASSERT(maxTriangles >= 1, "Meshlet", "Invalid max triangles per meshlet %u", maxTriangles);
+
+        MeshletData meshletData;
+        if (indices.empty())
+        {
+            return meshletData;
+        }
+
+        meshletData.m_meshlets.reserve(indices.size() / 3 / maxTriangles + 1);
+        meshletData.m_meshletVertices.reserve(indices.size());
+        meshletData.m_meshletTriangles.reserve(indices.size());
+
+        // Local index of each vertex in the current meshlet
+        std::vector<uint8_t> localIndices(vertices.size(), Internal::UnusedLocalIndex);
+
+        Meshlet meshlet;
+
+        auto finishMeshlet = [&]()
+        {
+            for (uint32_t i = 0; i < meshlet.m_vertexCount; ++i)
+            {
+                localIndices[meshletData.m_meshletVertices[meshlet.m_vertexOffset + i]] = Internal::UnusedLocalIndex;
+            }
+
+            Internal::CalculateMeshletBounds(meshlet, meshletData, vertices);
+            meshletData.m_meshlets.push_back(meshlet);
+
+            meshlet = Meshlet();
+            meshlet.m_vertexOffset = static_cast<uint32_t>(meshletData.m_meshletVertices.size());
+            meshlet.m_triangleOffset = static_cast<uint32_t>(meshletData.m_meshletTriangles.size());
+        };
+
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            const Index triangle[3] = { indices[i + 0], indices[i + 1], indices[i + 2] };
+
+            const uint32_t newVertexCount =
+                (localIndices[triangle[0]] == Internal::UnusedLocalIndex ? 1 : 0) +
+                (localIndices[triangle[1]] == Internal::UnusedLocalIndex && triangle[1] != triangle[0] ? 1 : 0) +
+                (localIndices[triangle[2]] == Internal::UnusedLocalIndex && triangle[2] != triangle[0] && triangle[2] != triangle[1] ? 1 : 0);
+
+            if (meshlet.m_vertexCount + newVertexCount > maxVertices ||
+                meshlet.m_triangleCount + 1 > maxTriangles)
+            {
+                finishMeshlet();
+            }
+
+            for (const Index vertex : triangle)
+            {
+                if (localIndices[vertex] == Internal::UnusedLocalIndex)
+                {
+                    localIndices[vertex] = static_cast<uint8_t>(meshlet.m_vertexCount++);
+                    meshletData.m_meshletVertices.push_back(vertex);
+                }
+                meshletData.m_meshletTriangles.push_back(localIndices[vertex]);
+            }
+            ++meshlet.m_triangleCount;
+        }
+
+        if (meshlet.m_triangleCount > 0)
+        {
+            finishMeshlet();
+        }
+
+        return meshletData;
+    }
+} // namespace DX
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Assets/Vertices.h>
+#include <Math/Vector3.h>
+
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    static constexpr uint32_t MeshletMaxVertices = 64;
+    static constexpr uint32_t MeshletMaxTriangles = 124;
+
+    // Cluster of triangles of a mesh, used for culling groups of triangles.
+    //
+    // Meshlet vertices are indices to the mesh vertices and meshlet triangles are
+    // 3 local indices (into the meshlet vertices) of 8 bits each.
+    struct Meshlet
+    {
+        uint32_t m_vertexOffset = 0; // First element in meshlet vertices
+        uint32_t m_triangleOffset = 0; // First element in meshlet triangles
+        uint32_t m_vertexCount = 0;
+        uint32_t m_triangleCount = 0;
+
+        // Bounding sphere in object space
+        Math::Vector3Packed m_center;
+        float m_radius = 0.0f;
+
+        // Normal cone, the meshlet is back facing from any point of view for which
+        // dot(normalize(m_coneApex - viewPosition), m_coneAxis) > m_coneCutoff.
+        // Cutoff is 1 when the triangles' normals are too spread to be culled.
+        Math::Vector3Packed m_coneApex;
+        Math::Vector3Packed m_coneAxis;
+        float m_coneCutoff = 1.0f;
+    };
+
+    struct MeshletData
+    {
+        std::vector<Meshlet> m_meshlets;
+        std::vector<uint32_t> m_meshletVertices;
+        std::vector<uint8_t> m_meshletTriangles;
+    };
+
+    // Partitions the triangles into meshlets, following the order of the indices.
+    // For best results the indices should be optimized for vertex cache first.
+    MeshletData BuildMeshlets(std::span<const Index> indices, std::span<const VertexPNTBUv> vertices,
+        uint32_t maxVertices = MeshletMaxVertices, uint32_t maxTriangles = MeshletMaxTriangles);
+} // namespace DX
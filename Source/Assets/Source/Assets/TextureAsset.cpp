@@ -0,0 +1,188 @@
+#include <Assets/TextureAsset.h>
+#include <Assets/AssetManager.h>
+#include <Assets/TextureCache.h>
+#include <Assets/TextureMipGenerator.h>
+#include <Memory/MemoryUsage.h>
+#include <Log/Log.h>
+
+#include <stb_image.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace DX
+{
+    void TextureData::SetOwnedLevelData(std::vector<uint8_t> levelData)
+    {
+        m_mappedFile.reset();
+        m_ownedData = std::move(levelData);
+        m_levelData = m_ownedData;
+
+        m_mips.resize(m_mipCount);
+        size_t offset = 0;
+        for (uint32_t mipLevel = 0; mipLevel < m_mipCount; ++mipLevel)
+        {
+            m_mips[mipLevel].m_offset = offset;
+            m_mips[mipLevel].m_size = CalculateTextureMipSize(m_format, CalculateMipSize(m_size, mipLevel));
+            offset += m_mips[mipLevel].m_size;
+        }
+    }
+
+    uint32_t TextureImportSettings::ToFlags() const
+    {
+        uint32_t flags = 0;
+        flags |= m_generateMips ? (1 << 0) : 0;
+        flags |= m_sRGB ? (1 << 1) : 0;
+        flags |= m_normalMap ? (1 << 2) : 0;
+        flags |= m_compress ? (1 << 3) : 0;
+        return flags;
+    }
+
+    TextureImportSettings TextureImportSettings::FromFlags(uint32_t flags)
+    {
+        TextureImportSettings settings;
+        settings.m_generateMips = (flags & (1 << 0)) != 0;
+        settings.m_sRGB = (flags & (1 << 1)) != 0;
+        settings.m_normalMap = (flags & (1 << 2)) != 0;
+        settings.m_compress = (flags & (1 << 3)) != 0;
+        return settings;
+    }
+
+    TextureAsset::TextureAsset(AssetId assetId, std::unique_ptr<TextureData> data)
+        : Super(assetId, std::move(data))
+    {
+    }
+
+    std::shared_ptr<TextureAsset> TextureAsset::LoadTextureAsset(const std::string& fileName, const TextureImportSettings& settings)
+    {
+        return DX::AssetManager::Get().LoadAssetAs<TextureAsset>(
+            fileName,
+            std::bind(&TextureAsset::LoadTexture, std::placeholders::_1, settings, std::placeholders::_2), settings.ToFlags());
+    }
+
+    AssetLoadHandle<TextureAsset> TextureAsset::LoadTextureAssetAsync(const std::string& fileName, const TextureImportSettings& settings)
+    {
+        return DX::AssetManager::Get().LoadAssetAsync<TextureAsset>(
+            fileName,
+            std::bind(&TextureAsset::LoadTexture, std::placeholders::_1, settings, std::placeholders::_2), settings.ToFlags());
+    }
+
+    AssetLoadHandle<TextureAsset> TextureAsset::ReloadTextureAssetAsync(const std::string& fileName, const TextureImportSettings& settings)
+    {
+        return DX::AssetManager::Get().ReloadAssetAsync<TextureAsset>(
+            fileName,
+            std::bind(&TextureAsset::LoadTexture, std::placeholders::_1, settings, std::placeholders::_2));
+    }
+
+    bool TextureAsset::CookTextureAsset(const std::string& fileName, const TextureImportSettings& settings, ThreadPool* threadPool)
+    {
+        return LoadTexture(GetAssetPath() / fileName, settings, threadPool) != nullptr;
+    }
+
+    std::unique_ptr<TextureData> TextureAsset::LoadTexture(const std::filesystem::path& fileNamePath, const TextureImportSettings& settings,
+        ThreadPool* threadPool)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        // Warm path: map the cooked texture from cache when it's up to date with the source.
+        const auto sourceHash = HashTextureSource(fileNamePath);
+        const auto cookedPath = GetCookedTexturePath(fileNamePath);
+        const TextureCacheKey cacheKey{ sourceHash.value_or(0), settings.ToFlags() };
+
+        if (sourceHash.has_value())
+        {
+            if (auto cookedTexture = LoadCookedTexture(cookedPath, cacheKey))
+            {
+                [[maybe_unused]] const float loadTimeMs =
+                    std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+                DX_LOG(Info, "TextureAsset", "Texture %s mapped from cooked cache in %.2f ms (cold import took %.2f ms).",
+                    fileNamePath.filename().generic_string().c_str(), loadTimeMs, cookedTexture->m_importTimeMs);
+
+                return std::move(cookedTexture->m_textureData);
+            }
+        }
+
+        // Cold path: decode the source, generate mips, compress and cook the result.
+        auto textureData = std::make_unique<TextureData>();
+
+        const auto sourceFile = OpenAssetFile(fileNamePath);
+        if (!sourceFile)
+        {
+            DX_LOG(Error, "TextureAsset", "Failed to open texture %s.", fileNamePath.generic_string().c_str());
+            return nullptr;
+        }
+
+        stbi_uc* texels = stbi_load_from_memory(
+            sourceFile->GetData().data(),
+            static_cast<int>(sourceFile->GetData().size()),
+            &textureData->m_size.x,
+            &textureData->m_size.y,
+            nullptr,
+            STBI_rgb_alpha);
+
+        if (!texels)
+        {
+            DX_LOG(Error, "TextureAsset", "Failed to load texture %s.", fileNamePath.generic_string().c_str());
+            return nullptr;
+        }
+
+        // Level 0 is copied into a buffer with space for all mip levels,
+        // so the whole chain can be uploaded to the image in a single copy.
+        textureData->m_mipCount = settings.m_generateMips ? CalculateMipCount(textureData->m_size) : 1;
+
+        std::vector<uint8_t> levelData(CalculateMipChainSize(textureData->m_size, textureData->m_mipCount));
+        std::memcpy(levelData.data(), texels, CalculateMipChainSize(textureData->m_size, 1));
+
+        stbi_image_free(texels);
+
+        if (textureData->m_mipCount > 1)
+        {
+            const auto mipsStartTime = std::chrono::steady_clock::now();
+
+            const TextureMipFilter filter = settings.m_normalMap ? TextureMipFilter::NormalMap
+                : (settings.m_sRGB ? TextureMipFilter::SRGB : TextureMipFilter::Linear);
+
+            GenerateMips(levelData, textureData->m_size, textureData->m_mipCount, filter);
+
+            [[maybe_unused]] const float generationTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - mipsStartTime).count();
+            DX_LOG(Verbose, "TextureAsset", "Texture %s generated %u mips in %.2f ms.",
+                fileNamePath.generic_string().c_str(), textureData->m_mipCount, generationTimeMs);
+        }
+
+        if (settings.m_compress)
+        {
+            const auto compressionStartTime = std::chrono::steady_clock::now();
+
+            const TextureFormat format = settings.m_normalMap ? TextureFormat::BC5 : TextureFormat::BC7;
+
+            std::vector<uint8_t> blocks = CompressTexture(levelData, textureData->m_size, textureData->m_mipCount,
+                format, threadPool);
+
+            [[maybe_unused]] const float compressionTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - compressionStartTime).count();
+            [[maybe_unused]] const float psnr = CalculatePSNR(levelData,
+                DecompressTexture(blocks, textureData->m_size, textureData->m_mipCount, format), format);
+            DX_LOG(Info, "TextureAsset", "Texture %s compressed to %s in %.2f ms (%.1f KB -> %.1f KB), PSNR %.2f dB.",
+                fileNamePath.generic_string().c_str(), (format == TextureFormat::BC5) ? "BC5" : "BC7", compressionTimeMs,
+                levelData.size() / 1024.0f, blocks.size() / 1024.0f, psnr);
+
+            textureData->m_format = format;
+            levelData = std::move(blocks);
+        }
+
+        textureData->SetOwnedLevelData(std::move(levelData));
+
+        const float importTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        DX_LOG(Info, "TextureAsset", "Texture %s imported in %.2f ms, peak RSS %.1f MB.",
+            fileNamePath.filename().generic_string().c_str(), importTimeMs, GetProcessPeakResidentBytes() / (1024.0f * 1024.0f));
+
+        if (sourceHash.has_value())
+        {
+            SaveCookedTexture(cookedPath, cacheKey, *textureData, importTimeMs);
+        }
+
+        return textureData;
+    }
+} // namespace DX
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Assets/Asset.h>
+#include <Assets/AssetManager.h>
+#include <Assets/TextureCompression.h>
+#include <File/MappedFile.h>
+#include <Math/Vector2.h>
+
+#include <vector>
+#include <span>
+#include <filesystem>
+
+namespace DX
+{
+    // Location of a mip level inside the level data of a texture.
+    struct TextureMip
+    {
+        size_t m_offset = 0;
+        size_t m_size = 0;
+    };
+
+    struct TextureData
+    {
+        Math::Vector2Int m_size; // Size of mip level 0
+        uint32_t m_mipCount = 1;
+        uint32_t m_arrayCount = 1;
+        TextureFormat m_format = TextureFormat::RGBA8;
+        std::vector<TextureMip> m_mips;
+
+        // Texels (or blocks) of all mip levels one after the other, starting from level 0.
+        // It's the layout Vulkan::Image expects for initial data, so it can be copied
+        // into the staging buffer as it is. It points to m_ownedData or m_mappedFile.
+        std::span<const uint8_t> m_levelData;
+
+        // Storage of the level data. Cooked textures are memory mapped instead.
+        std::vector<uint8_t> m_ownedData;
+        std::unique_ptr<MappedFile> m_mappedFile;
+
+        // Takes ownership of the level data and calculates the mip locations.
+        // Size, mip count and format must be set before.
+        void SetOwnedLevelData(std::vector<uint8_t> levelData);
+
+        std::span<const uint8_t> GetMipData(uint32_t mipLevel) const
+        {
+            return m_levelData.subspan(m_mips[mipLevel].m_offset, m_mips[mipLevel].m_size);
+        }
+    };
+
+    // Options applied when importing a texture from its source file.
+    struct TextureImportSettings
+    {
+        // Generates the full mip chain down to 1x1.
+        bool m_generateMips = true;
+
+        // Color is stored in sRGB space, mips are generated in linear space.
+        bool m_sRGB = true;
+
+        // Texture stores normals, mips are renormalized. Ignores m_sRGB.
+        bool m_normalMap = false;
+
+        // Encodes the texture into a block compressed format,
+        // BC5 for normal maps and BC7 for everything else.
+        bool m_compress = true;
+
+        // Packs the settings into bits, used to identify cooked textures.
+        uint32_t ToFlags() const;
+        static TextureImportSettings FromFlags(uint32_t flags);
+    };
+
+    // Texture formats supported: jpeg, png, bmp, psd, tga, gif, hdr, pic, and pnm
+    class TextureAsset : public Asset<TextureData>
+    {
+    public:
+        // Loads a texture from a file. The filename is relative to the assets folder.
+        // Settings are only used the first time the texture is loaded.
+        static std::shared_ptr<TextureAsset> LoadTextureAsset(const std::string& fileName,
+            const TextureImportSettings& settings = {});
+
+        // Loads a texture from a file in a worker thread. The filename is relative to the assets folder.
+        // Settings are only used the first time the texture is loaded.
+        static AssetLoadHandle<TextureAsset> LoadTextureAssetAsync(const std::string& fileName,
+            const TextureImportSettings& settings = {});
+
+        // Imports the texture again in a worker thread after its file has been modified.
+        // The new asset replaces the current one in the asset manager when it finishes successfully.
+        static AssetLoadHandle<TextureAsset> ReloadTextureAssetAsync(const std::string& fileName,
+            const TextureImportSettings& settings = {});
+
+        // Imports the texture into the cooked cache without adding it to the asset manager,
+        // a cooked texture already up to date is left as it is. Used to cook assets offline.
+        // The filename is relative to the assets folder. Returns false if the import fails.
+        // The import is parallelized in the thread pool when there is one.
+        static bool CookTextureAsset(const std::string& fileName, const TextureImportSettings& settings = {},
+            ThreadPool* threadPool = nullptr);
+
+        static inline const AssetType AssetTypeId = 0xB8FCE1BE;
+
+        AssetType GetAssetType() const override
+        {
+            return AssetTypeId;
+        }
+
+        // Only the level data owned by the texture, mapped level data is paged in and out by the OS.
+        size_t GetDataSizeInBytes() const override
+        {
+            return m_data->m_ownedData.size();
+        }
+
+    protected:
+        friend class AssetManager;
+        using Super = Asset<TextureData>;
+
+        TextureAsset(AssetId assetId, std::unique_ptr<TextureData> data);
+
+    private:
+        static std::unique_ptr<TextureData> LoadTexture(const std::filesystem::path& fileNamePath, const TextureImportSettings& settings,
+            ThreadPool* threadPool);
+    };
+} // namespace DX
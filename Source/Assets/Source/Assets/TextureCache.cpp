@@ -0,0 +1,226 @@
+#include <Assets/TextureCache.h>
+#include <Assets/TextureAsset.h>
+#include <Assets/TextureMipGenerator.h>
+#include <File/FileUtils.h>
+#include <File/MappedFile.h>
+#include <Log/Log.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t CookedTextureMagic = 0x58545844; // 'DXTX'
+
+        // Increment every time the layout of the cooked texture changes.
+        static constexpr uint32_t CookedTextureVersion = 1;
+
+        static constexpr const char* CookedTextureExtension = ".dxtex";
+
+        // Alignment of the level data inside the file.
+        static constexpr size_t CookedTextureLevelDataAlignment = 16;
+
+        // Cooked texture file layout (similar to KTX2):
+        //   CookedTextureHeader
+        //   Level index (CookedTextureLevel * mipCount)
+        //   Padding up to CookedTextureLevelDataAlignment
+        //   Level data, all mips one after the other starting from level 0
+        struct CookedTextureHeader
+        {
+            uint32_t m_magic;
+            uint32_t m_version;
+            HashValue m_sourceHash;
+            uint32_t m_settingsFlags;
+            uint32_t m_format;
+            uint32_t m_width;
+            uint32_t m_height;
+            uint32_t m_depth;
+            uint32_t m_arrayCount;
+            uint32_t m_mipCount;
+            float m_importTimeMs;
+            uint64_t m_levelDataOffset; // From the start of the file
+            uint64_t m_levelDataSize;
+        };
+
+        // Location of a mip level relative to the start of the level data.
+        struct CookedTextureLevel
+        {
+            uint64_t m_offset;
+            uint64_t m_size;
+        };
+
+        size_t CookedTextureLevelDataOffset(uint32_t mipCount)
+        {
+            const size_t indexEnd = sizeof(CookedTextureHeader) + mipCount * sizeof(CookedTextureLevel);
+            return (indexEnd + CookedTextureLevelDataAlignment - 1) & ~(CookedTextureLevelDataAlignment - 1);
+        }
+
+        bool IsValidTextureFormat(uint32_t format)
+        {
+            return format <= static_cast<uint32_t>(TextureFormat::BC7);
+        }
+    } // namespace Internal
+
+    std::optional<HashValue> HashTextureSource(const std::filesystem::path& sourcePath)
+    {
+        auto sourceFile = OpenAssetFile(sourcePath);
+        if (!sourceFile)
+        {
+            return std::nullopt;
+        }
+
+        return HashBytes(sourceFile->GetData().data(), sourceFile->GetData().size());
+    }
+
+    std::filesystem::path GetCookedTexturePath(const std::filesystem::path& sourcePath)
+    {
+        auto cookedPath = GetAssetCachePath() / sourcePath.lexically_relative(GetAssetPath());
+        cookedPath += Internal::CookedTextureExtension;
+        return cookedPath;
+    }
+
+    std::optional<CookedTexture> LoadCookedTexture(const std::filesystem::path& cookedPath, const TextureCacheKey& key)
+    {
+        if (!std::filesystem::exists(cookedPath))
+        {
+            return std::nullopt;
+        }
+
+        auto cookedFile = std::make_unique<MappedFile>();
+        if (!cookedFile->Open(cookedPath))
+        {
+            return std::nullopt;
+        }
+
+        if (cookedFile->GetSize() < sizeof(Internal::CookedTextureHeader))
+        {
+            DX_LOG(Warning, "TextureCache", "Cooked texture %s is corrupted.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        Internal::CookedTextureHeader header;
+        std::memcpy(&header, cookedFile->GetData(), sizeof(header));
+
+        if (header.m_magic != Internal::CookedTextureMagic ||
+            header.m_version != Internal::CookedTextureVersion)
+        {
+            DX_LOG(Verbose, "TextureCache", "Cooked texture %s is from a different version.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        if (header.m_sourceHash != key.m_sourceHash ||
+            header.m_settingsFlags != key.m_settingsFlags)
+        {
+            DX_LOG(Verbose, "TextureCache", "Cooked texture %s is stale.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        const Math::Vector2Int size(static_cast<int>(header.m_width), static_cast<int>(header.m_height));
+        if (!Internal::IsValidTextureFormat(header.m_format) ||
+            header.m_mipCount == 0 ||
+            header.m_mipCount > CalculateMipCount(size) ||
+            header.m_depth != 1 ||
+            header.m_arrayCount != 1 ||
+            header.m_levelDataOffset != Internal::CookedTextureLevelDataOffset(header.m_mipCount) ||
+            header.m_levelDataOffset + header.m_levelDataSize != cookedFile->GetSize())
+        {
+            DX_LOG(Warning, "TextureCache", "Cooked texture %s is corrupted.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        auto textureData = std::make_unique<TextureData>();
+        textureData->m_size = size;
+        textureData->m_mipCount = header.m_mipCount;
+        textureData->m_arrayCount = header.m_arrayCount;
+        textureData->m_format = static_cast<TextureFormat>(header.m_format);
+        textureData->m_mips.resize(header.m_mipCount);
+
+        // Mips must be tightly packed, as the whole level data is uploaded in a single copy.
+        const uint8_t* levelIndex = cookedFile->GetData() + sizeof(header);
+        size_t expectedOffset = 0;
+        for (uint32_t mipLevel = 0; mipLevel < header.m_mipCount; ++mipLevel)
+        {
+            Internal::CookedTextureLevel level;
+            std::memcpy(&level, levelIndex + mipLevel * sizeof(level), sizeof(level));
+
+            if (level.m_offset != expectedOffset ||
+                level.m_size != CalculateTextureMipSize(textureData->m_format, CalculateMipSize(size, mipLevel)))
+            {
+                DX_LOG(Warning, "TextureCache", "Cooked texture %s is corrupted.", cookedPath.generic_string().c_str());
+                return std::nullopt;
+            }
+
+            textureData->m_mips[mipLevel] = TextureMip{ static_cast<size_t>(level.m_offset), static_cast<size_t>(level.m_size) };
+            expectedOffset += level.m_size;
+        }
+
+        if (expectedOffset != header.m_levelDataSize)
+        {
+            DX_LOG(Warning, "TextureCache", "Cooked texture %s is corrupted.", cookedPath.generic_string().c_str());
+            return std::nullopt;
+        }
+
+        textureData->m_levelData = std::span<const uint8_t>(
+            cookedFile->GetData() + header.m_levelDataOffset, static_cast<size_t>(header.m_levelDataSize));
+        textureData->m_mappedFile = std::move(cookedFile);
+
+        return CookedTexture{ std::move(textureData), header.m_importTimeMs };
+    }
+
+    bool SaveCookedTexture(const std::filesystem::path& cookedPath, const TextureCacheKey& key, const TextureData& textureData, float importTimeMs)
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(cookedPath.parent_path(), errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "TextureCache", "Failed to create cache folder %s.", cookedPath.parent_path().generic_string().c_str());
+            return false;
+        }
+
+        const Internal::CookedTextureHeader header =
+        {
+            .m_magic = Internal::CookedTextureMagic,
+            .m_version = Internal::CookedTextureVersion,
+            .m_sourceHash = key.m_sourceHash,
+            .m_settingsFlags = key.m_settingsFlags,
+            .m_format = static_cast<uint32_t>(textureData.m_format),
+            .m_width = static_cast<uint32_t>(textureData.m_size.x),
+            .m_height = static_cast<uint32_t>(textureData.m_size.y),
+            .m_depth = 1,
+            .m_arrayCount = textureData.m_arrayCount,
+            .m_mipCount = textureData.m_mipCount,
+            .m_importTimeMs = importTimeMs,
+            .m_levelDataOffset = Internal::CookedTextureLevelDataOffset(textureData.m_mipCount),
+            .m_levelDataSize = textureData.m_levelData.size()
+        };
+
+        // Write into a temporary file and rename it at the end, so a
+        // partially written cooked texture is never picked up by a loader.
+        const bool written = WriteFileAtomically(cookedPath, [&](std::ofstream& file)
+            {
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                for (const TextureMip& mip : textureData.m_mips)
+                {
+                    const Internal::CookedTextureLevel level = { mip.m_offset, mip.m_size };
+                    file.write(reinterpret_cast<const char*>(&level), sizeof(level));
+                }
+
+                const size_t paddingSize = header.m_levelDataOffset -
+                    (sizeof(header) + textureData.m_mips.size() * sizeof(Internal::CookedTextureLevel));
+                const char padding[Internal::CookedTextureLevelDataAlignment] = {};
+                file.write(padding, paddingSize);
+
+                file.write(reinterpret_cast<const char*>(textureData.m_levelData.data()), textureData.m_levelData.size());
+            });
+        if (!written)
+        {
+            DX_LOG(Error, "TextureCache", "Failed to save cooked texture %s.", cookedPath.generic_string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+} // namespace DX
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Hash/Hash.h>
+
+#include <memory>
+#include <optional>
+#include <filesystem>
+
+namespace DX
+{
+    struct TextureData;
+
+    // Identifies the source a cooked texture was generated from.
+    // When any of its values differ from the ones stored in the
+    // cooked file, the cooked texture is stale and must be imported again.
+    struct TextureCacheKey
+    {
+        HashValue m_sourceHash = 0;
+        uint32_t m_settingsFlags = 0;
+    };
+
+    // Cooked texture loaded from the cache.
+    struct CookedTexture
+    {
+        std::unique_ptr<TextureData> m_textureData;
+        float m_importTimeMs = 0.0f; // Time it took to import the source when cooked
+    };
+
+    // Calculates the hash of the contents of a texture source file.
+    std::optional<HashValue> HashTextureSource(const std::filesystem::path& sourcePath);
+
+    // Returns the path of the cooked texture inside the cache folder for a source texture path.
+    std::filesystem::path GetCookedTexturePath(const std::filesystem::path& sourcePath);
+
+    // Maps a cooked texture file. The level data of the returned TextureData points
+    // directly into the mapped file, it's not read or decoded until it's used.
+    // Returns nullopt if the file doesn't exist, it's from a different
+    // version or it was cooked with a different key.
+    std::optional<CookedTexture> LoadCookedTexture(const std::filesystem::path& cookedPath, const TextureCacheKey& key);
+
+    // Writes texture data into a cooked texture file.
+    bool SaveCookedTexture(const std::filesystem::path& cookedPath, const TextureCacheKey& key, const TextureData& textureData, float importTimeMs);
+} // namespace DX
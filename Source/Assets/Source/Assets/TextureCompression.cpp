@@ -0,0 +1,947 @@
+#include <Assets/TextureCompression.h>
+#include <Assets/TextureMipGenerator.h>
+#include <Thread/ThreadPool.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr int BlockDimension = 4;
+        static constexpr int BlockTexelCount = BlockDimension * BlockDimension;
+        static constexpr uint32_t TexelSize = 4; // RGBA8
+
+        // RGBA8 texels of a 4x4 block
+        using BlockTexels = std::array<std::array<uint8_t, 4>, BlockTexelCount>;
+
+        size_t BlockSizeInBytes(TextureFormat format)
+        {
+            switch (format)
+            {
+            case TextureFormat::BC1: return 8;
+            case TextureFormat::BC3: return 16;
+            case TextureFormat::BC5: return 16;
+            case TextureFormat::BC7: return 16;
+            default:
+                DX_ASSERT(false, "TextureCompression", "Format %u is not block compressed", static_cast<uint32_t>(format));
+                return 0;
+            }
+        }
+
+        Math::Vector2Int BlockCount(const Math::Vector2Int& mipSize)
+        {
+            return Math::Vector2Int(
+                (mipSize.x + BlockDimension - 1) / BlockDimension,
+                (mipSize.y + BlockDimension - 1) / BlockDimension);
+        }
+
+        // Texels outside the image (partial blocks) replicate the last row and column.
+        BlockTexels LoadBlock(const uint8_t* texels, const Math::Vector2Int& mipSize, int blockX, int blockY)
+        {
+            BlockTexels block;
+            for (int y = 0; y < BlockDimension; ++y)
+            {
+                const int texelY = std::min(blockY * BlockDimension + y, mipSize.y - 1);
+                for (int x = 0; x < BlockDimension; ++x)
+                {
+                    const int texelX = std::min(blockX * BlockDimension + x, mipSize.x - 1);
+                    std::memcpy(block[y * BlockDimension + x].data(),
+                        texels + (static_cast<size_t>(texelY) * mipSize.x + texelX) * TexelSize, TexelSize);
+                }
+            }
+            return block;
+        }
+
+        void StoreBlock(uint8_t* texels, const Math::Vector2Int& mipSize, int blockX, int blockY, const BlockTexels& block)
+        {
+            for (int y = 0; y < BlockDimension; ++y)
+            {
+                const int texelY = blockY * BlockDimension + y;
+                for (int x = 0; x < BlockDimension; ++x)
+                {
+                    const int texelX = blockX * BlockDimension + x;
+                    if (texelX < mipSize.x && texelY < mipSize.y)
+                    {
+                        std::memcpy(texels + (static_cast<size_t>(texelY) * mipSize.x + texelX) * TexelSize,
+                            block[y * BlockDimension + x].data(), TexelSize);
+                    }
+                }
+            }
+        }
+
+        // Principal axis of the texels' channels [0, ChannelCount) using power iteration.
+        template<int ChannelCount>
+        void PrincipalAxis(const BlockTexels& block, float* mean, float* axis)
+        {
+            std::fill(mean, mean + ChannelCount, 0.0f);
+            for (const auto& texel : block)
+            {
+                for (int c = 0; c < ChannelCount; ++c)
+                {
+                    mean[c] += texel[c];
+                }
+            }
+            for (int c = 0; c < ChannelCount; ++c)
+            {
+                mean[c] /= BlockTexelCount;
+            }
+
+            float covariance[ChannelCount][ChannelCount] = {};
+            for (const auto& texel : block)
+            {
+                for (int i = 0; i < ChannelCount; ++i)
+                {
+                    for (int j = i; j < ChannelCount; ++j)
+                    {
+                        covariance[i][j] += (texel[i] - mean[i]) * (texel[j] - mean[j]);
+                    }
+                }
+            }
+            for (int i = 0; i < ChannelCount; ++i)
+            {
+                for (int j = 0; j < i; ++j)
+                {
+                    covariance[i][j] = covariance[j][i];
+                }
+            }
+
+            std::fill(axis, axis + ChannelCount, 1.0f);
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                float result[ChannelCount] = {};
+                float maxComponent = 0.0f;
+                for (int i = 0; i < ChannelCount; ++i)
+                {
+                    for (int j = 0; j < ChannelCount; ++j)
+                    {
+                        result[i] += covariance[i][j] * axis[j];
+                    }
+                    maxComponent = std::max(maxComponent, std::abs(result[i]));
+                }
+
+                if (maxComponent <= 0.0f)
+                {
+                    break; // All texels are the same
+                }
+
+                for (int i = 0; i < ChannelCount; ++i)
+                {
+                    axis[i] = result[i] / maxComponent;
+                }
+            }
+        }
+
+        // Projections of the texels along the axis, relative to the mean.
+        template<int ChannelCount>
+        void ProjectionRange(const BlockTexels& block, const float* mean, const float* axis, float& minT, float& maxT)
+        {
+            float axisLengthSq = 0.0f;
+            for (int c = 0; c < ChannelCount; ++c)
+            {
+                axisLengthSq += axis[c] * axis[c];
+            }
+
+            minT = 0.0f;
+            maxT = 0.0f;
+            if (axisLengthSq <= 0.0f)
+            {
+                return;
+            }
+
+            minT = std::numeric_limits<float>::max();
+            maxT = std::numeric_limits<float>::lowest();
+            for (const auto& texel : block)
+            {
+                float t = 0.0f;
+                for (int c = 0; c < ChannelCount; ++c)
+                {
+                    t += (texel[c] - mean[c]) * axis[c];
+                }
+                t /= axisLengthSq;
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // BC1 (color part of BC1 and BC3)
+        // ---------------------------------------------------------------------
+
+        uint16_t PackColor565(const float* color)
+        {
+            const uint32_t r = static_cast<uint32_t>(std::clamp(color[0] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            const uint32_t g = static_cast<uint32_t>(std::clamp(color[1] * 63.0f / 255.0f + 0.5f, 0.0f, 63.0f));
+            const uint32_t b = static_cast<uint32_t>(std::clamp(color[2] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        std::array<int, 3> UnpackColor565(uint16_t color)
+        {
+            const int r = (color >> 11) & 0x1F;
+            const int g = (color >> 5) & 0x3F;
+            const int b = color & 0x1F;
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+        }
+
+        std::array<std::array<int, 3>, 4> ColorPalette(uint16_t color0, uint16_t color1, bool fourColors)
+        {
+            std::array<std::array<int, 3>, 4> palette;
+            palette[0] = UnpackColor565(color0);
+            palette[1] = UnpackColor565(color1);
+            for (int c = 0; c < 3; ++c)
+            {
+                if (fourColors)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+                else
+                {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+            return palette;
+        }
+
+        // Chooses the closest palette color for each texel and returns the total squared error.
+        int ColorIndices(const BlockTexels& block, uint16_t color0, uint16_t color1, uint8_t* indices)
+        {
+            const auto palette = ColorPalette(color0, color1, true);
+
+            int totalError = 0;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                int bestError = std::numeric_limits<int>::max();
+                for (uint8_t p = 0; p < 4; ++p)
+                {
+                    int error = 0;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const int diff = block[i][c] - palette[p][c];
+                        error += diff * diff;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        indices[i] = p;
+                    }
+                }
+                totalError += bestError;
+            }
+            return totalError;
+        }
+
+        // Least squares endpoints for the given indices.
+        bool RefineColorEndpoints(const BlockTexels& block, const uint8_t* indices, float* endpoint0, float* endpoint1)
+        {
+            static constexpr float Weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f }; // Weight of endpoint 0
+
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[3] = {}, bx[3] = {};
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                const float a = Weights[indices[i]];
+                const float b = 1.0f - a;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < 3; ++c)
+                {
+                    ax[c] += a * block[i][c];
+                    bx[c] += b * block[i][c];
+                }
+            }
+
+            const float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                endpoint0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+                endpoint1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        // Always uses the 4 colors mode, valid for both BC1 and BC3.
+        void EncodeColorBlock(const BlockTexels& block, uint8_t* output)
+        {
+            float mean[3], axis[3];
+            PrincipalAxis<3>(block, mean, axis);
+
+            float minT, maxT;
+            ProjectionRange<3>(block, mean, axis, minT, maxT);
+
+            float endpoint0[3], endpoint1[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                endpoint0[c] = mean[c] + axis[c] * maxT;
+                endpoint1[c] = mean[c] + axis[c] * minT;
+            }
+
+            uint16_t color0 = PackColor565(endpoint0);
+            uint16_t color1 = PackColor565(endpoint1);
+            uint8_t indices[BlockTexelCount];
+            int error = ColorIndices(block, color0, color1, indices);
+
+            if (error > 0 && RefineColorEndpoints(block, indices, endpoint0, endpoint1))
+            {
+                const uint16_t refinedColor0 = PackColor565(endpoint0);
+                const uint16_t refinedColor1 = PackColor565(endpoint1);
+                uint8_t refinedIndices[BlockTexelCount];
+                if (const int refinedError = ColorIndices(block, refinedColor0, refinedColor1, refinedIndices);
+                    refinedError < error)
+                {
+                    color0 = refinedColor0;
+                    color1 = refinedColor1;
+                    error = refinedError;
+                    std::memcpy(indices, refinedIndices, sizeof(indices));
+                }
+            }
+
+            // Color 0 has to be greater than color 1 for the 4 colors mode
+            if (color0 < color1)
+            {
+                std::swap(color0, color1);
+                for (uint8_t& index : indices)
+                {
+                    index ^= 1; // Swaps 0 <-> 1 and 2 <-> 3
+                }
+            }
+            else if (color0 == color1)
+            {
+                std::fill(std::begin(indices), std::end(indices), static_cast<uint8_t>(0));
+            }
+
+            uint32_t packedIndices = 0;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                packedIndices |= static_cast<uint32_t>(indices[i]) << (2 * i);
+            }
+
+            std::memcpy(output + 0, &color0, sizeof(color0));
+            std::memcpy(output + 2, &color1, sizeof(color1));
+            std::memcpy(output + 4, &packedIndices, sizeof(packedIndices));
+        }
+
+        void DecodeColorBlock(const uint8_t* input, BlockTexels& block, bool forceFourColors)
+        {
+            uint16_t color0, color1;
+            uint32_t packedIndices;
+            std::memcpy(&color0, input + 0, sizeof(color0));
+            std::memcpy(&color1, input + 2, sizeof(color1));
+            std::memcpy(&packedIndices, input + 4, sizeof(packedIndices));
+
+            const bool fourColors = forceFourColors || color0 > color1;
+            const auto palette = ColorPalette(color0, color1, fourColors);
+
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                const uint32_t index = (packedIndices >> (2 * i)) & 0x3;
+                for (int c = 0; c < 3; ++c)
+                {
+                    block[i][c] = static_cast<uint8_t>(palette[index][c]);
+                }
+                block[i][3] = (!fourColors && index == 3) ? 0 : 255;
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // BC4 (alpha of BC3 and each channel of BC5)
+        // ---------------------------------------------------------------------
+
+        std::array<int, 8> SingleChannelPalette(int value0, int value1)
+        {
+            std::array<int, 8> palette;
+            palette[0] = value0;
+            palette[1] = value1;
+            if (value0 > value1)
+            {
+                for (int i = 1; i < 7; ++i)
+                {
+                    palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+                }
+            }
+            else
+            {
+                for (int i = 1; i < 5; ++i)
+                {
+                    palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+            return palette;
+        }
+
+        void EncodeSingleChannelBlock(const BlockTexels& block, int channel, uint8_t* output)
+        {
+            int minValue = 255;
+            int maxValue = 0;
+            for (const auto& texel : block)
+            {
+                minValue = std::min<int>(minValue, texel[channel]);
+                maxValue = std::max<int>(maxValue, texel[channel]);
+            }
+
+            // 8 values mode (value 0 > value 1) spanning the whole range of the block
+            const auto palette = SingleChannelPalette(maxValue, minValue);
+
+            uint64_t packedIndices = 0;
+            if (maxValue > minValue)
+            {
+                for (int i = 0; i < BlockTexelCount; ++i)
+                {
+                    uint64_t bestIndex = 0;
+                    int bestError = std::numeric_limits<int>::max();
+                    for (uint64_t p = 0; p < 8; ++p)
+                    {
+                        if (const int error = std::abs(block[i][channel] - palette[p]);
+                            error < bestError)
+                        {
+                            bestError = error;
+                            bestIndex = p;
+                        }
+                    }
+                    packedIndices |= bestIndex << (3 * i);
+                }
+            }
+
+            output[0] = static_cast<uint8_t>(maxValue);
+            output[1] = static_cast<uint8_t>(minValue);
+            for (int i = 0; i < 6; ++i)
+            {
+                output[2 + i] = static_cast<uint8_t>(packedIndices >> (8 * i));
+            }
+        }
+
+        void DecodeSingleChannelBlock(const uint8_t* input, BlockTexels& block, int channel)
+        {
+            const auto palette = SingleChannelPalette(input[0], input[1]);
+
+            uint64_t packedIndices = 0;
+            for (int i = 0; i < 6; ++i)
+            {
+                packedIndices |= static_cast<uint64_t>(input[2 + i]) << (8 * i);
+            }
+
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                block[i][channel] = static_cast<uint8_t>(palette[(packedIndices >> (3 * i)) & 0x7]);
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // BC7 (mode 6 only: 1 subset, RGBA 7.7.7.7 endpoints with unique p-bits and 4 bits indices)
+        // ---------------------------------------------------------------------
+
+        static constexpr int BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        struct BC7Endpoints
+        {
+            std::array<int, 4> m_endpoint0; // 7 bits per channel
+            std::array<int, 4> m_endpoint1;
+            int m_pBit0 = 0;
+            int m_pBit1 = 0;
+        };
+
+        // Index of the closest weight to a weight in [0,64]
+        int BC7WeightToIndex(int weight)
+        {
+            int index = 0;
+            while (index < 15 && (BC7Weights[index] + BC7Weights[index + 1]) < 2 * weight)
+            {
+                ++index;
+            }
+            return index;
+        }
+
+        int BC7Interpolate(int value0, int value1, int weight)
+        {
+            return ((64 - weight) * value0 + weight * value1 + 32) >> 6;
+        }
+
+        int BC7Indices(const BlockTexels& block, const BC7Endpoints& endpoints, uint8_t* indices)
+        {
+            std::array<std::array<int, 4>, 16> palette;
+            for (int c = 0; c < 4; ++c)
+            {
+                const int value0 = (endpoints.m_endpoint0[c] << 1) | endpoints.m_pBit0;
+                const int value1 = (endpoints.m_endpoint1[c] << 1) | endpoints.m_pBit1;
+                for (int p = 0; p < 16; ++p)
+                {
+                    palette[p][c] = BC7Interpolate(value0, value1, BC7Weights[p]);
+                }
+            }
+
+            // The palette lies on the segment between the endpoints, so the closest entry is
+            // found projecting the texel on the segment and checking only the nearest weights.
+            float direction[4];
+            float directionLengthSq = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                direction[c] = static_cast<float>(palette[15][c] - palette[0][c]);
+                directionLengthSq += direction[c] * direction[c];
+            }
+            const float projectionScale = (directionLengthSq > 0.0f) ? 64.0f / directionLengthSq : 0.0f;
+
+            int totalError = 0;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                float projection = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    projection += (block[i][c] - palette[0][c]) * direction[c];
+                }
+                const int weight = std::clamp(static_cast<int>(projection * projectionScale + 0.5f), 0, 64);
+                const int nearestIndex = BC7WeightToIndex(weight);
+
+                int bestError = std::numeric_limits<int>::max();
+                for (int p = std::max(nearestIndex - 1, 0); p <= std::min(nearestIndex + 1, 15); ++p)
+                {
+                    int error = 0;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        const int diff = block[i][c] - palette[p][c];
+                        error += diff * diff;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        indices[i] = static_cast<uint8_t>(p);
+                    }
+                }
+                totalError += bestError;
+            }
+            return totalError;
+        }
+
+        // Quantizes the endpoints trying all p-bit combinations, returns the error of the best one.
+        int BC7QuantizeEndpoints(const BlockTexels& block, const float* endpoint0, const float* endpoint1,
+            BC7Endpoints& bestEndpoints, uint8_t* bestIndices)
+        {
+            int bestError = std::numeric_limits<int>::max();
+            for (int pBits = 0; pBits < 4; ++pBits)
+            {
+                BC7Endpoints endpoints;
+                endpoints.m_pBit0 = pBits & 1;
+                endpoints.m_pBit1 = pBits >> 1;
+                for (int c = 0; c < 4; ++c)
+                {
+                    endpoints.m_endpoint0[c] = std::clamp(static_cast<int>(std::round((endpoint0[c] - endpoints.m_pBit0) * 0.5f)), 0, 127);
+                    endpoints.m_endpoint1[c] = std::clamp(static_cast<int>(std::round((endpoint1[c] - endpoints.m_pBit1) * 0.5f)), 0, 127);
+                }
+
+                uint8_t indices[BlockTexelCount];
+                if (const int error = BC7Indices(block, endpoints, indices);
+                    error < bestError)
+                {
+                    bestError = error;
+                    bestEndpoints = endpoints;
+                    std::memcpy(bestIndices, indices, sizeof(indices));
+                }
+            }
+            return bestError;
+        }
+
+        bool RefineBC7Endpoints(const BlockTexels& block, const uint8_t* indices, float* endpoint0, float* endpoint1)
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                const float b = BC7Weights[indices[i]] / 64.0f;
+                const float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < 4; ++c)
+                {
+                    ax[c] += a * block[i][c];
+                    bx[c] += b * block[i][c];
+                }
+            }
+
+            const float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoint0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+                endpoint1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        class BitWriter
+        {
+        public:
+            void Write(uint32_t value, int bitCount)
+            {
+                for (int i = 0; i < bitCount; ++i, ++m_position)
+                {
+                    m_bytes[m_position / 8] |= static_cast<uint8_t>(((value >> i) & 1) << (m_position % 8));
+                }
+            }
+
+            const std::array<uint8_t, 16>& GetBytes() const { return m_bytes; }
+
+        private:
+            std::array<uint8_t, 16> m_bytes = {};
+            int m_position = 0;
+        };
+
+        class BitReader
+        {
+        public:
+            explicit BitReader(const uint8_t* bytes) : m_bytes(bytes) {}
+
+            uint32_t Read(int bitCount)
+            {
+                uint32_t value = 0;
+                for (int i = 0; i < bitCount; ++i, ++m_position)
+                {
+                    value |= static_cast<uint32_t>((m_bytes[m_position / 8] >> (m_position % 8)) & 1) << i;
+                }
+                return value;
+            }
+
+        private:
+            const uint8_t* m_bytes;
+            int m_position = 0;
+        };
+
+        void EncodeBC7Block(const BlockTexels& block, uint8_t* output)
+        {
+            float mean[4], axis[4];
+            PrincipalAxis<4>(block, mean, axis);
+
+            float minT, maxT;
+            ProjectionRange<4>(block, mean, axis, minT, maxT);
+
+            float endpoint0[4], endpoint1[4];
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoint0[c] = mean[c] + axis[c] * minT;
+                endpoint1[c] = mean[c] + axis[c] * maxT;
+            }
+
+            BC7Endpoints endpoints;
+            uint8_t indices[BlockTexelCount];
+            int error = BC7QuantizeEndpoints(block, endpoint0, endpoint1, endpoints, indices);
+
+            for (int iteration = 0; iteration < 2 && error > 0; ++iteration)
+            {
+                if (!RefineBC7Endpoints(block, indices, endpoint0, endpoint1))
+                {
+                    break;
+                }
+
+                BC7Endpoints refinedEndpoints;
+                uint8_t refinedIndices[BlockTexelCount];
+                const int refinedError = BC7QuantizeEndpoints(block, endpoint0, endpoint1, refinedEndpoints, refinedIndices);
+                if (refinedError >= error)
+                {
+                    break;
+                }
+
+                error = refinedError;
+                endpoints = refinedEndpoints;
+                std::memcpy(indices, refinedIndices, sizeof(indices));
+            }
+
+            // The most significant bit of the first index is implicitly 0
+            if (indices[0] & 0x8)
+            {
+                std::swap(endpoints.m_endpoint0, endpoints.m_endpoint1);
+                std::swap(endpoints.m_pBit0, endpoints.m_pBit1);
+                for (uint8_t& index : indices)
+                {
+                    index = 15 - index;
+                }
+            }
+
+            BitWriter writer;
+            writer.Write(1 << 6, 7); // Mode 6
+            for (int c = 0; c < 4; ++c)
+            {
+                writer.Write(endpoints.m_endpoint0[c], 7);
+                writer.Write(endpoints.m_endpoint1[c], 7);
+            }
+            writer.Write(endpoints.m_pBit0, 1);
+            writer.Write(endpoints.m_pBit1, 1);
+            writer.Write(indices[0], 3);
+            for (int i = 1; i < BlockTexelCount; ++i)
+            {
+                writer.Write(indices[i], 4);
+            }
+
+            std::memcpy(output, writer.GetBytes().data(), writer.GetBytes().size());
+        }
+
+        // Only mode 6 blocks are decoded, which are the ones generated by the encoder.
+        void DecodeBC7Block(const uint8_t* input, BlockTexels& block)
+        {
+            BitReader reader(input);
+            if (reader.Read(7) != (1 << 6))
+            {
+                for (auto& texel : block)
+                {
+                    texel = { 0, 0, 0, 0 };
+                }
+                return;
+            }
+
+            int endpoints[2][4];
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoints[0][c] = static_cast<int>(reader.Read(7));
+                endpoints[1][c] = static_cast<int>(reader.Read(7));
+            }
+            const int pBit0 = static_cast<int>(reader.Read(1));
+            const int pBit1 = static_cast<int>(reader.Read(1));
+
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                const uint32_t index = reader.Read((i == 0) ? 3 : 4);
+                for (int c = 0; c < 4; ++c)
+                {
+                    block[i][c] = static_cast<uint8_t>(BC7Interpolate(
+                        (endpoints[0][c] << 1) | pBit0, (endpoints[1][c] << 1) | pBit1, BC7Weights[index]));
+                }
+            }
+        }
+
+        // ---------------------------------------------------------------------
+
+        void EncodeBlock(TextureFormat format, const BlockTexels& block, uint8_t* output)
+        {
+            switch (format)
+            {
+            case TextureFormat::BC1:
+                EncodeColorBlock(block, output);
+                break;
+            case TextureFormat::BC3:
+                EncodeSingleChannelBlock(block, 3, output);
+                EncodeColorBlock(block, output + 8);
+                break;
+            case TextureFormat::BC5:
+                EncodeSingleChannelBlock(block, 0, output);
+                EncodeSingleChannelBlock(block, 1, output + 8);
+                break;
+            case TextureFormat::BC7:
+                EncodeBC7Block(block, output);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void DecodeBlock(TextureFormat format, const uint8_t* input, BlockTexels& block)
+        {
+            switch (format)
+            {
+            case TextureFormat::BC1:
+                DecodeColorBlock(input, block, false);
+                break;
+            case TextureFormat::BC3:
+                DecodeColorBlock(input + 8, block, true);
+                DecodeSingleChannelBlock(input, block, 3);
+                break;
+            case TextureFormat::BC5:
+                DecodeSingleChannelBlock(input, block, 0);
+                DecodeSingleChannelBlock(input + 8, block, 1);
+                for (auto& texel : block)
+                {
+                    texel[2] = 0;
+                    texel[3] = 255;
+                }
+                break;
+            case TextureFormat::BC7:
+                DecodeBC7Block(input, block);
+                break;
+            default:
+                break;
+            }
+        }
+    } // namespace Internal
+
+    bool IsBlockCompressed(TextureFormat format)
+    {
+        return format != TextureFormat::RGBA8;
+    }
+
+    size_t CalculateTextureMipSize(TextureFormat format, const Math::Vector2Int& mipSize)
+    {
+        if (!IsBlockCompressed(format))
+        {
+            return static_cast<size_t>(mipSize.x) * mipSize.y * Internal::TexelSize;
+        }
+
+        const Math::Vector2Int blockCount = Internal::BlockCount(mipSize);
+        return static_cast<size_t>(blockCount.x) * blockCount.y * Internal::BlockSizeInBytes(format);
+    }
+
+    size_t CalculateTextureMipChainSize(TextureFormat format, const Math::Vector2Int& size, uint32_t mipCount)
+    {
+        size_t totalSize = 0;
+        for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            totalSize += CalculateTextureMipSize(format, CalculateMipSize(size, mipLevel));
+        }
+        return totalSize;
+    }
+
+    std::vector<uint8_t> CompressTexture(std::span<const uint8_t> texels, const Math::Vector2Int& size, uint32_t mipCount,
+        TextureFormat format, ThreadPool* threadPool)
+    {
+        DX_ASSERT(IsBlockCompressed(format), "TextureCompression", "Format %u is not block compressed", static_cast<uint32_t>(format));
+        DX_ASSERT(texels.size() >= CalculateTextureMipChainSize(TextureFormat::RGBA8, size, mipCount), "TextureCompression",
+            "Texels buffer (%zu bytes) is too small for %u mips", texels.size(), mipCount);
+
+        std::vector<uint8_t> blocks(CalculateTextureMipChainSize(format, size, mipCount));
+
+        const size_t blockSize = Internal::BlockSizeInBytes(format);
+        const uint8_t* srcMip = texels.data();
+        uint8_t* dstMip = blocks.data();
+
+        for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            const Math::Vector2Int mipSize = CalculateMipSize(size, mipLevel);
+            const Math::Vector2Int blockCount = Internal::BlockCount(mipSize);
+
+            auto encodeBlockRow = [&](uint32_t blockY)
+            {
+                uint8_t* dstRow = dstMip + static_cast<size_t>(blockY) * blockCount.x * blockSize;
+                for (int blockX = 0; blockX < blockCount.x; ++blockX)
+                {
+                    const Internal::BlockTexels block = Internal::LoadBlock(srcMip, mipSize, blockX, static_cast<int>(blockY));
+                    Internal::EncodeBlock(format, block, dstRow + blockX * blockSize);
+                }
+            };
+
+            if (threadPool && blockCount.y > 1)
+            {
+                threadPool->ParallelFor(static_cast<uint32_t>(blockCount.y), encodeBlockRow);
+            }
+            else
+            {
+                for (int blockY = 0; blockY < blockCount.y; ++blockY)
+                {
+                    encodeBlockRow(static_cast<uint32_t>(blockY));
+                }
+            }
+
+            srcMip += CalculateTextureMipSize(TextureFormat::RGBA8, mipSize);
+            dstMip += CalculateTextureMipSize(format, mipSize);
+        }
+
+        return blocks;
+    }
+
+    std::vector<uint8_t> DecompressTexture(std::span<const uint8_t> blocks, const Math::Vector2Int& size, uint32_t mipCount,
+        TextureFormat format)
+    {
+        std::vector<uint8_t> texels(CalculateTextureMipChainSize(TextureFormat::RGBA8, size, mipCount));
+
+        DecompressTexture(blocks, size, mipCount, format, texels);
+
+        return texels;
+    }
+
+    void DecompressTexture(std::span<const uint8_t> blocks, const Math::Vector2Int& size, uint32_t mipCount,
+        TextureFormat format, std::span<uint8_t> texels, ThreadPool* threadPool)
+    {
+        DX_ASSERT(IsBlockCompressed(format), "TextureCompression", "Format %u is not block compressed", static_cast<uint32_t>(format));
+        DX_ASSERT(blocks.size() >= CalculateTextureMipChainSize(format, size, mipCount), "TextureCompression",
+            "Blocks buffer (%zu bytes) is too small for %u mips", blocks.size(), mipCount);
+        DX_ASSERT(texels.size() >= CalculateTextureMipChainSize(TextureFormat::RGBA8, size, mipCount), "TextureCompression",
+            "Texels buffer (%zu bytes) is too small for %u mips", texels.size(), mipCount);
+
+        const size_t blockSize = Internal::BlockSizeInBytes(format);
+        const uint8_t* srcMip = blocks.data();
+        uint8_t* dstMip = texels.data();
+
+        for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            const Math::Vector2Int mipSize = CalculateMipSize(size, mipLevel);
+            const Math::Vector2Int blockCount = Internal::BlockCount(mipSize);
+
+            auto decodeBlockRow = [&](uint32_t blockY)
+            {
+                const uint8_t* srcRow = srcMip + static_cast<size_t>(blockY) * blockCount.x * blockSize;
+                for (int blockX = 0; blockX < blockCount.x; ++blockX)
+                {
+                    Internal::BlockTexels block;
+                    Internal::DecodeBlock(format, srcRow + blockX * blockSize, block);
+                    Internal::StoreBlock(dstMip, mipSize, blockX, static_cast<int>(blockY), block);
+                }
+            };
+
+            if (threadPool && blockCount.y > 1)
+            {
+                threadPool->ParallelFor(static_cast<uint32_t>(blockCount.y), decodeBlockRow);
+            }
+            else
+            {
+                for (int blockY = 0; blockY < blockCount.y; ++blockY)
+                {
+                    decodeBlockRow(static_cast<uint32_t>(blockY));
+                }
+            }
+
+            srcMip += CalculateTextureMipSize(format, mipSize);
+            dstMip += CalculateTextureMipSize(TextureFormat::RGBA8, mipSize);
+        }
+    }
+
+    float CalculatePSNR(std::span<const uint8_t> original, std::span<const uint8_t> decoded, TextureFormat format)
+    {
+        DX_ASSERT(original.size() == decoded.size(), "TextureCompression",
+            "Images of different sizes (%zu and %zu bytes)", original.size(), decoded.size());
+
+        uint32_t channelCount = 4;
+        switch (format)
+        {
+        case TextureFormat::BC1: channelCount = 3; break;
+        case TextureFormat::BC5: channelCount = 2; break;
+        default: break;
+        }
+
+        const size_t texelCount = std::min(original.size(), decoded.size()) / Internal::TexelSize;
+        if (texelCount == 0)
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+
+        double squaredError = 0.0;
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            for (uint32_t c = 0; c < channelCount; ++c)
+            {
+                const double diff = static_cast<double>(original[i * Internal::TexelSize + c]) - decoded[i * Internal::TexelSize + c];
+                squaredError += diff * diff;
+            }
+        }
+
+        const double meanSquaredError = squaredError / (static_cast<double>(texelCount) * channelCount);
+        if (meanSquaredError <= 0.0)
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+        return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / meanSquaredError));
+    }
+} // namespace DX
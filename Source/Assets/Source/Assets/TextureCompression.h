@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Math/Vector2.h>
+
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    class ThreadPool;
+
+    // Format of the texels stored in a texture asset.
+    enum class TextureFormat : uint32_t
+    {
+        RGBA8 = 0, // Uncompressed, 4 bytes per texel
+        BC1,       // RGB, 8 bytes per 4x4 block
+        BC3,       // RGBA, 16 bytes per 4x4 block
+        BC5,       // RG, 16 bytes per 4x4 block. Used for normal maps, Z is reconstructed.
+        BC7        // RGBA, 16 bytes per 4x4 block. Higher quality than BC1 and BC3.
+    };
+
+    bool IsBlockCompressed(TextureFormat format);
+
+    // Size in bytes of a mip level, partial blocks are stored as full blocks.
+    size_t CalculateTextureMipSize(TextureFormat format, const Math::Vector2Int& mipSize);
+
+    // Size in bytes of the first mipCount levels of a texture.
+    size_t CalculateTextureMipChainSize(TextureFormat format, const Math::Vector2Int& size, uint32_t mipCount);
+
+    // Encodes all mip levels of a RGBA8 texture into a block compressed format.
+    // When a thread pool is provided the blocks are encoded in parallel.
+    std::vector<uint8_t> CompressTexture(std::span<const uint8_t> texels, const Math::Vector2Int& size, uint32_t mipCount,
+        TextureFormat format, ThreadPool* threadPool = nullptr);
+
+    // Decodes all mip levels of a block compressed texture back into RGBA8.
+    // BC5 is decoded with blue set to 0 and alpha set to 255.
+    std::vector<uint8_t> DecompressTexture(std::span<const uint8_t> blocks, const Math::Vector2Int& size, uint32_t mipCount,
+        TextureFormat format);
+
+    // Same as above but decodes into the texels buffer provided, which must fit all mip levels in RGBA8.
+    // When a thread pool is provided the blocks are decoded in parallel.
+    void DecompressTexture(std::span<const uint8_t> blocks, const Math::Vector2Int& size, uint32_t mipCount,
+        TextureFormat format, std::span<uint8_t> texels, ThreadPool* threadPool = nullptr);
+
+    // Peak signal-to-noise ratio in dB between two RGBA8 images, only
+    // considering the channels stored by the format. Higher is better.
+    float CalculatePSNR(std::span<const uint8_t> original, std::span<const uint8_t> decoded, TextureFormat format);
+} // namespace DX
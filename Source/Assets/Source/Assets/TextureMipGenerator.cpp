@@ -0,0 +1,287 @@
+#include <Assets/TextureMipGenerator.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DX_MIP_GENERATOR_SSE2 1
+#include <emmintrin.h>
+#else
+#define DX_MIP_GENERATOR_SSE2 0
+#endif
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t TexelSize = 4; // RGBA8
+
+        // Precision of the table to convert from linear to sRGB.
+        static constexpr uint32_t LinearToSRGBTableSize = 4096;
+
+        struct SRGBTables
+        {
+            SRGBTables()
+            {
+                for (uint32_t i = 0; i < m_toLinear.size(); ++i)
+                {
+                    const float c = i / 255.0f;
+                    m_toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+
+                for (uint32_t i = 0; i < m_toSRGB.size(); ++i)
+                {
+                    const float c = i / static_cast<float>(LinearToSRGBTableSize - 1);
+                    const float srgb = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                    m_toSRGB[i] = static_cast<uint8_t>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+            }
+
+            std::array<float, 256> m_toLinear;
+            std::array<uint8_t, LinearToSRGBTableSize> m_toSRGB;
+        };
+
+        const SRGBTables& GetSRGBTables()
+        {
+            static const SRGBTables tables;
+            return tables;
+        }
+
+        // Source texels of the 2x2 footprint of a destination texel. Coordinates
+        // are clamped so odd and 1 texel wide dimensions are handled.
+        struct Footprint
+        {
+            const uint8_t* m_texels[4];
+        };
+
+#if DX_MIP_GENERATOR_SSE2
+        // RGBA8 texel to 4 floats in [0,255]
+        inline __m128 LoadTexel(const uint8_t* texel)
+        {
+            uint32_t value;
+            std::memcpy(&value, texel, sizeof(value));
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i bytes = _mm_cvtsi32_si128(static_cast<int>(value));
+            return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+        }
+
+        // 4 floats in [0,255] to RGBA8 texel, with rounding and saturation
+        inline void StoreTexel(uint8_t* texel, __m128 value)
+        {
+            const __m128i ints = _mm_cvtps_epi32(value);
+            const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(ints, ints), ints);
+            const uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(bytes));
+            std::memcpy(texel, &result, sizeof(result));
+        }
+
+        void DownsampleTexelLinear(uint8_t* dst, const Footprint& footprint)
+        {
+            const __m128 sum = _mm_add_ps(
+                _mm_add_ps(LoadTexel(footprint.m_texels[0]), LoadTexel(footprint.m_texels[1])),
+                _mm_add_ps(LoadTexel(footprint.m_texels[2]), LoadTexel(footprint.m_texels[3])));
+            StoreTexel(dst, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+        }
+
+        void DownsampleTexelSRGB(uint8_t* dst, const Footprint& footprint)
+        {
+            const SRGBTables& tables = GetSRGBTables();
+
+            __m128 sum = _mm_setzero_ps();
+            for (const uint8_t* texel : footprint.m_texels)
+            {
+                sum = _mm_add_ps(sum, _mm_setr_ps(
+                    tables.m_toLinear[texel[0]],
+                    tables.m_toLinear[texel[1]],
+                    tables.m_toLinear[texel[2]],
+                    texel[3] * (1.0f / 255.0f)));
+            }
+
+            // Color to linear to sRGB table index and alpha to [0,255]
+            const __m128 scale = _mm_setr_ps(
+                0.25f * (LinearToSRGBTableSize - 1), 0.25f * (LinearToSRGBTableSize - 1), 0.25f * (LinearToSRGBTableSize - 1), 0.25f * 255.0f);
+            alignas(16) int32_t values[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(values), _mm_cvtps_epi32(_mm_mul_ps(sum, scale)));
+
+            dst[0] = tables.m_toSRGB[values[0]];
+            dst[1] = tables.m_toSRGB[values[1]];
+            dst[2] = tables.m_toSRGB[values[2]];
+            dst[3] = static_cast<uint8_t>(values[3]);
+        }
+
+        void DownsampleTexelNormalMap(uint8_t* dst, const Footprint& footprint)
+        {
+            const __m128 sum = _mm_add_ps(
+                _mm_add_ps(LoadTexel(footprint.m_texels[0]), LoadTexel(footprint.m_texels[1])),
+                _mm_add_ps(LoadTexel(footprint.m_texels[2]), LoadTexel(footprint.m_texels[3])));
+
+            // Average of the normals in [-1,1]
+            const __m128 average = _mm_sub_ps(_mm_mul_ps(sum, _mm_set1_ps(0.25f * 2.0f / 255.0f)), _mm_set1_ps(1.0f));
+
+            // Squared length of xyz (alpha masked out) in all lanes
+            const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+            __m128 lengthSq = _mm_and_ps(_mm_mul_ps(average, average), xyzMask);
+            lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(2, 3, 0, 1)));
+            lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            __m128 normal;
+            if (_mm_cvtss_f32(lengthSq) > 1e-8f)
+            {
+                normal = _mm_div_ps(average, _mm_sqrt_ps(lengthSq));
+            }
+            else
+            {
+                // Normals cancel each other out, use a flat normal.
+                normal = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+            }
+
+            // Renormalized xyz with the averaged alpha, back to [0,255]
+            normal = _mm_or_ps(_mm_and_ps(xyzMask, normal), _mm_andnot_ps(xyzMask, average));
+            StoreTexel(dst, _mm_mul_ps(_mm_add_ps(normal, _mm_set1_ps(1.0f)), _mm_set1_ps(0.5f * 255.0f)));
+        }
+#else
+        void DownsampleTexelLinear(uint8_t* dst, const Footprint& footprint)
+        {
+            for (uint32_t c = 0; c < TexelSize; ++c)
+            {
+                const uint32_t sum = footprint.m_texels[0][c] + footprint.m_texels[1][c] + footprint.m_texels[2][c] + footprint.m_texels[3][c];
+                dst[c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+
+        void DownsampleTexelSRGB(uint8_t* dst, const Footprint& footprint)
+        {
+            const SRGBTables& tables = GetSRGBTables();
+
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                float sum = 0.0f;
+                for (const uint8_t* texel : footprint.m_texels)
+                {
+                    sum += tables.m_toLinear[texel[c]];
+                }
+                dst[c] = tables.m_toSRGB[static_cast<uint32_t>(sum * 0.25f * (LinearToSRGBTableSize - 1) + 0.5f)];
+            }
+
+            const uint32_t alphaSum = footprint.m_texels[0][3] + footprint.m_texels[1][3] + footprint.m_texels[2][3] + footprint.m_texels[3][3];
+            dst[3] = static_cast<uint8_t>((alphaSum + 2) / 4);
+        }
+
+        void DownsampleTexelNormalMap(uint8_t* dst, const Footprint& footprint)
+        {
+            float average[TexelSize] = {};
+            for (const uint8_t* texel : footprint.m_texels)
+            {
+                for (uint32_t c = 0; c < TexelSize; ++c)
+                {
+                    average[c] += texel[c] * (0.25f * 2.0f / 255.0f);
+                }
+            }
+            for (float& value : average)
+            {
+                value -= 1.0f;
+            }
+
+            const float lengthSq = average[0] * average[0] + average[1] * average[1] + average[2] * average[2];
+            if (lengthSq > 1e-8f)
+            {
+                const float invLength = 1.0f / std::sqrt(lengthSq);
+                average[0] *= invLength;
+                average[1] *= invLength;
+                average[2] *= invLength;
+            }
+            else
+            {
+                // Normals cancel each other out, use a flat normal.
+                average[0] = 0.0f;
+                average[1] = 0.0f;
+                average[2] = 1.0f;
+            }
+
+            for (uint32_t c = 0; c < TexelSize; ++c)
+            {
+                dst[c] = static_cast<uint8_t>(std::clamp((average[c] + 1.0f) * 0.5f * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        }
+#endif
+
+        template<void (*DownsampleTexel)(uint8_t*, const Footprint&)>
+        void DownsampleMip(const uint8_t* src, const Math::Vector2Int& srcSize, uint8_t* dst, const Math::Vector2Int& dstSize)
+        {
+            const size_t srcRowPitch = static_cast<size_t>(srcSize.x) * TexelSize;
+
+            for (int y = 0; y < dstSize.y; ++y)
+            {
+                const uint8_t* srcRow0 = src + std::min(2 * y, srcSize.y - 1) * srcRowPitch;
+                const uint8_t* srcRow1 = src + std::min(2 * y + 1, srcSize.y - 1) * srcRowPitch;
+                uint8_t* dstRow = dst + static_cast<size_t>(y) * dstSize.x * TexelSize;
+
+                for (int x = 0; x < dstSize.x; ++x)
+                {
+                    const size_t x0 = static_cast<size_t>(std::min(2 * x, srcSize.x - 1)) * TexelSize;
+                    const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, srcSize.x - 1)) * TexelSize;
+
+                    const Footprint footprint = { { srcRow0 + x0, srcRow0 + x1, srcRow1 + x0, srcRow1 + x1 } };
+                    DownsampleTexel(dstRow + x * TexelSize, footprint);
+                }
+            }
+        }
+    } // namespace Internal
+
+    uint32_t CalculateMipCount(const Math::Vector2Int& size)
+    {
+        const uint32_t maxDimension = static_cast<uint32_t>(std::max({ size.x, size.y, 1 }));
+        return static_cast<uint32_t>(std::bit_width(maxDimension));
+    }
+
+    Math::Vector2Int CalculateMipSize(const Math::Vector2Int& size, uint32_t mipLevel)
+    {
+        return Math::Vector2Int(std::max(1, size.x >> mipLevel), std::max(1, size.y >> mipLevel));
+    }
+
+    size_t CalculateMipChainSize(const Math::Vector2Int& size, uint32_t mipCount)
+    {
+        size_t totalSize = 0;
+        for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            const Math::Vector2Int mipSize = CalculateMipSize(size, mipLevel);
+            totalSize += static_cast<size_t>(mipSize.x) * mipSize.y * Internal::TexelSize;
+        }
+        return totalSize;
+    }
+
+    void GenerateMips(std::span<uint8_t> texels, const Math::Vector2Int& size, uint32_t mipCount, TextureMipFilter filter)
+    {
+        DX_ASSERT(mipCount <= CalculateMipCount(size), "TextureMipGenerator",
+            "Mip count %u is larger than full mip chain of %dx%d texture", mipCount, size.x, size.y);
+        DX_ASSERT(texels.size() >= CalculateMipChainSize(size, mipCount), "TextureMipGenerator",
+            "Texels buffer (%zu bytes) is too small for %u mips", texels.size(), mipCount);
+
+        uint8_t* src = texels.data();
+        for (uint32_t mipLevel = 1; mipLevel < mipCount; ++mipLevel)
+        {
+            const Math::Vector2Int srcSize = CalculateMipSize(size, mipLevel - 1);
+            const Math::Vector2Int dstSize = CalculateMipSize(size, mipLevel);
+            uint8_t* dst = src + static_cast<size_t>(srcSize.x) * srcSize.y * Internal::TexelSize;
+
+            switch (filter)
+            {
+            case TextureMipFilter::SRGB:
+                Internal::DownsampleMip<Internal::DownsampleTexelSRGB>(src, srcSize, dst, dstSize);
+                break;
+            case TextureMipFilter::NormalMap:
+                Internal::DownsampleMip<Internal::DownsampleTexelNormalMap>(src, srcSize, dst, dstSize);
+                break;
+            case TextureMipFilter::Linear:
+            default:
+                Internal::DownsampleMip<Internal::DownsampleTexelLinear>(src, srcSize, dst, dstSize);
+                break;
+            }
+
+            src = dst;
+        }
+    }
+} // namespace DX
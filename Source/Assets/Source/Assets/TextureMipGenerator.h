@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Math/Vector2.h>
+
+#include <span>
+
+namespace DX
+{
+    // How texels are averaged when downsampling a mip level.
+    enum class TextureMipFilter
+    {
+        Linear = 0, // Texels are averaged as they are
+        SRGB,       // Color channels are averaged in linear space (gamma-correct)
+        NormalMap   // Normals are averaged and renormalized
+    };
+
+    // Number of mip levels of a full chain, down to 1x1.
+    uint32_t CalculateMipCount(const Math::Vector2Int& size);
+
+    // Size of a mip level, halving the size for each level without going below 1.
+    Math::Vector2Int CalculateMipSize(const Math::Vector2Int& size, uint32_t mipLevel);
+
+    // Size in bytes of the first mipCount levels of a RGBA8 texture.
+    size_t CalculateMipChainSize(const Math::Vector2Int& size, uint32_t mipCount);
+
+    // Generates the mip levels of a RGBA8 texture by 2x2 box filtering each level into the next.
+    // Texels must have space for all levels one after the other (same layout as Vulkan::Image
+    // expects for initial data) with level 0 already filled in.
+    void GenerateMips(std::span<uint8_t> texels, const Math::Vector2Int& size, uint32_t mipCount, TextureMipFilter filter);
+} // namespace DX
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Math/Vector2.h>
+#include <Math/Vector3.h>
+#include <Math/Color.h>
+
+namespace DX
+{
+    using Index = uint32_t;
+    using Index16 = uint16_t;
+
+    // Size in bytes of the indices of a mesh in index buffers and cooked files.
+    // Meshes with fewer than 65536 vertices use 16-bit indices.
+    inline uint32_t CalculateIndexSize(uint32_t vertexCount)
+    {
+        return (vertexCount < 65536) ? sizeof(Index16) : sizeof(Index);
+    }
+
+    struct VertexPC
+    {
+        Math::Vector3Packed m_position;
+        Math::ColorPacked m_color;
+    };
+
+    struct VertexPUv
+    {
+        Math::Vector3Packed m_position;
+        Math::Vector2Packed m_uv;
+    };
+
+    struct VertexPNTBUv
+    {
+        Math::Vector3Packed m_position;
+        Math::Vector3Packed m_normal;
+        Math::Vector3Packed m_tangent;
+        Math::Vector3Packed m_binormal;
+        Math::Vector2Packed m_uv;
+    };
+
+    // Quantized version of VertexPNTBUv, 16 bytes instead of 56.
+    //
+    // - Position: 16 bits unsigned normalized per component, relative to the mesh bounds.
+    //   The 4th component is padding to keep the attribute aligned.
+    // - QTangent: tangent frame (tangent, binormal and normal) encoded as a quaternion of
+    //   8 bits signed normalized components. The sign of w is the handedness of the binormal.
+    // - UV: half floats.
+    struct VertexCompact
+    {
+        uint16_t m_position[4];
+        int8_t m_qtangent[4];
+        uint16_t m_uv[2];
+    };
+
+    static_assert(sizeof(VertexCompact) == 16, "Unexpected size of VertexCompact");
+
+    enum class VertexFormat : uint32_t
+    {
+        PNTBUv = 0,
+        Compact
+    };
+} // namespace DX
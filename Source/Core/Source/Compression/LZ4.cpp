@@ -0,0 +1,253 @@
+#include <Compression/LZ4.h>
+
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Constraints of the LZ4 block format.
+        static constexpr size_t LZ4MinMatch = 4;
+        static constexpr size_t LZ4LastLiterals = 5; // The last bytes are always literals
+        static constexpr size_t LZ4MatchFindLimit = 12; // Matches can't start in the last bytes
+        static constexpr size_t LZ4MaxOffset = 65535;
+        static constexpr uint8_t LZ4LengthMask = 15;
+
+        static constexpr int LZ4HashBits = 16;
+
+        // Consecutive misses before the search starts skipping bytes.
+        // It keeps compression fast on data that doesn't compress.
+        static constexpr uint32_t LZ4SkipTrigger = 6;
+
+        uint32_t LZ4Read32(const uint8_t* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        uint32_t LZ4HashSequence(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - LZ4HashBits);
+        }
+
+        void LZ4WriteLength(std::vector<uint8_t>& output, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                output.push_back(255);
+            }
+            output.push_back(static_cast<uint8_t>(length));
+        }
+
+        bool LZ4ReadLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+        {
+            uint8_t byte = 0;
+            do
+            {
+                if (input == inputEnd)
+                {
+                    return false;
+                }
+                byte = *input++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        // Writes a sequence of literals followed by a match. The last sequence has no match.
+        void LZ4WriteSequence(std::vector<uint8_t>& output, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+        {
+            const size_t tokenIndex = output.size();
+            output.push_back(0);
+
+            uint8_t token = 0;
+            if (literalCount >= LZ4LengthMask)
+            {
+                token = LZ4LengthMask << 4;
+                LZ4WriteLength(output, literalCount - LZ4LengthMask);
+            }
+            else
+            {
+                token = static_cast<uint8_t>(literalCount << 4);
+            }
+            output.insert(output.end(), literals, literals + literalCount);
+
+            if (matchLength > 0)
+            {
+                output.push_back(static_cast<uint8_t>(offset & 0xFF));
+                output.push_back(static_cast<uint8_t>(offset >> 8));
+
+                const size_t matchLengthCode = matchLength - LZ4MinMatch;
+                if (matchLengthCode >= LZ4LengthMask)
+                {
+                    token |= LZ4LengthMask;
+                    LZ4WriteLength(output, matchLengthCode - LZ4LengthMask);
+                }
+                else
+                {
+                    token |= static_cast<uint8_t>(matchLengthCode);
+                }
+            }
+
+            output[tokenIndex] = token;
+        }
+    } // namespace Internal
+
+    size_t LZ4CompressBound(size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    size_t LZ4DecompressBound(size_t compressedSize)
+    {
+        // The longest output per input byte comes from match length bytes,
+        // each one extends the match by 255 bytes.
+        return compressedSize * 255;
+    }
+
+    std::vector<uint8_t> LZ4Compress(std::span<const uint8_t> data)
+    {
+        const uint8_t* source = data.data();
+        const size_t size = data.size();
+
+        std::vector<uint8_t> output;
+        output.reserve(LZ4CompressBound(size));
+
+        size_t anchor = 0; // Start of the literals not written yet
+
+        if (size > Internal::LZ4MatchFindLimit)
+        {
+            // Last position seen for each hashed 4 byte sequence.
+            std::vector<uint32_t> hashTable(size_t{ 1 } << Internal::LZ4HashBits, 0);
+
+            const size_t matchFindEnd = size - Internal::LZ4MatchFindLimit;
+            const size_t matchEnd = size - Internal::LZ4LastLiterals;
+
+            size_t position = 0;
+            uint32_t missCount = 0;
+            while (position < matchFindEnd)
+            {
+                const uint32_t sequence = Internal::LZ4Read32(source + position);
+                uint32_t& hashEntry = hashTable[Internal::LZ4HashSequence(sequence)];
+                size_t candidate = hashEntry;
+                hashEntry = static_cast<uint32_t>(position);
+
+                if (candidate >= position ||
+                    position - candidate > Internal::LZ4MaxOffset ||
+                    Internal::LZ4Read32(source + candidate) != sequence)
+                {
+                    position += 1 + (missCount++ >> Internal::LZ4SkipTrigger);
+                    continue;
+                }
+
+                // Extend the match backwards into the pending literals and then forwards.
+                while (position > anchor && candidate > 0 && source[position - 1] == source[candidate - 1])
+                {
+                    --position;
+                    --candidate;
+                }
+
+                size_t matchLength = Internal::LZ4MinMatch;
+                while (position + matchLength < matchEnd && source[position + matchLength] == source[candidate + matchLength])
+                {
+                    ++matchLength;
+                }
+
+                Internal::LZ4WriteSequence(output, source + anchor, position - anchor, position - candidate, matchLength);
+
+                position += matchLength;
+                anchor = position;
+                missCount = 0;
+            }
+        }
+
+        Internal::LZ4WriteSequence(output, source + anchor, size - anchor, 0, 0);
+
+        return output;
+    }
+
+    bool LZ4Decompress(std::span<const uint8_t> compressedData, std::span<uint8_t> output)
+    {
+        const uint8_t* input = compressedData.data();
+        const uint8_t* const inputEnd = input + compressedData.size();
+        uint8_t* outputPosition = output.data();
+        uint8_t* const outputEnd = outputPosition + output.size();
+
+        while (input < inputEnd)
+        {
+            const uint8_t token = *input++;
+
+            // Literals
+            size_t literalCount = token >> 4;
+            if (literalCount == Internal::LZ4LengthMask &&
+                !Internal::LZ4ReadLength(input, inputEnd, literalCount))
+            {
+                return false;
+            }
+            if (literalCount > static_cast<size_t>(inputEnd - input) ||
+                literalCount > static_cast<size_t>(outputEnd - outputPosition))
+            {
+                return false;
+            }
+            if (literalCount > 0)
+            {
+                std::memcpy(outputPosition, input, literalCount);
+            }
+            input += literalCount;
+            outputPosition += literalCount;
+
+            // The last sequence only has literals.
+            if (input == inputEnd)
+            {
+                break;
+            }
+
+            // Match
+            if (inputEnd - input < 2)
+            {
+                return false;
+            }
+            const size_t offset = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8);
+            input += 2;
+            if (offset == 0 || offset > static_cast<size_t>(outputPosition - output.data()))
+            {
+                return false;
+            }
+
+            size_t matchLength = token & Internal::LZ4LengthMask;
+            if (matchLength == Internal::LZ4LengthMask &&
+                !Internal::LZ4ReadLength(input, inputEnd, matchLength))
+            {
+                return false;
+            }
+            matchLength += Internal::LZ4MinMatch;
+            if (matchLength > static_cast<size_t>(outputEnd - outputPosition))
+            {
+                return false;
+            }
+
+            // Matches can overlap the output being written, which repeats a pattern.
+            const uint8_t* match = outputPosition - offset;
+            if (offset >= matchLength)
+            {
+                std::memcpy(outputPosition, match, matchLength);
+            }
+            else if (offset == 1)
+            {
+                // Runs of the same byte, common in filtered data like delta encoded streams.
+                std::memset(outputPosition, *match, matchLength);
+            }
+            else
+            {
+                for (size_t i = 0; i < matchLength; ++i)
+                {
+                    outputPosition[i] = match[i];
+                }
+            }
+            outputPosition += matchLength;
+        }
+
+        return outputPosition == outputEnd;
+    }
+} // namespace DX
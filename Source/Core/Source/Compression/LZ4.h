@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    // Compression using the LZ4 block format.
+    //
+    // Blocks are compatible with the reference LZ4 implementation, but they don't
+    // store the uncompressed size, which must be kept alongside to decompress.
+    // Decompression is very fast and it's safe against corrupted input.
+
+    // Maximum size of the compressed data for an input of this size.
+    size_t LZ4CompressBound(size_t size);
+
+    // Maximum size an LZ4 block of this size can decompress to.
+    size_t LZ4DecompressBound(size_t compressedSize);
+
+    // Compresses the data into an LZ4 block.
+    std::vector<uint8_t> LZ4Compress(std::span<const uint8_t> data);
+
+    // Decompresses an LZ4 block. The output must have the exact uncompressed size.
+    // Returns false if the block is corrupted or it doesn't decompress to the output size.
+    bool LZ4Decompress(std::span<const uint8_t> compressedData, std::span<uint8_t> output);
+} // namespace DX
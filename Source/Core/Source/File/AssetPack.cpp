@@ -0,0 +1,347 @@
+#include <File/AssetPack.h>
+#include <Compression/LZ4.h>
+#include <File/FileUtils.h>
+#include <Hash/Hash.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr uint32_t AssetPackMagic = 0x4B505844; // 'DXPK'
+
+        // Increment every time the layout of the asset pack changes.
+        static constexpr uint32_t AssetPackVersion = 1;
+
+        // Alignment of the file data inside the pack, the size of a memory page.
+        static constexpr size_t AssetPackEntryAlignment = 4096;
+
+        enum class AssetPackCompression : uint32_t
+        {
+            None = 0,
+            LZ4
+        };
+
+        // Asset pack file layout:
+        //   AssetPackHeader
+        //   Table of contents (AssetPack::Entry * entryCount), sorted by name hash
+        //   File names, one after the other without null terminators
+        //   File data, each file aligned to AssetPackEntryAlignment
+        struct AssetPackHeader
+        {
+            uint32_t m_magic;
+            uint32_t m_version;
+            uint32_t m_entryCount;
+            uint32_t m_namesSize;
+            uint64_t m_tocOffset; // From the start of the file
+            uint64_t m_namesOffset;
+        };
+
+        size_t AlignAssetPackOffset(size_t offset)
+        {
+            return (offset + AssetPackEntryAlignment - 1) & ~(AssetPackEntryAlignment - 1);
+        }
+    } // namespace Internal
+
+    struct AssetPack::Entry
+    {
+        HashValue m_nameHash;
+        uint64_t m_offset; // From the start of the file
+        uint64_t m_size; // Size stored in the pack
+        uint64_t m_uncompressedSize;
+        uint32_t m_nameOffset; // From the start of the names
+        uint32_t m_nameSize;
+        uint32_t m_compression;
+        uint32_t m_padding;
+    };
+
+    AssetPack::AssetPack() = default;
+
+    AssetPack::~AssetPack()
+    {
+        Close();
+    }
+
+    bool AssetPack::Open(const std::filesystem::path& packPath)
+    {
+        Close();
+
+        if (!m_packFile.Open(packPath))
+        {
+            return false;
+        }
+
+        const uint8_t* packData = m_packFile.GetData();
+        const size_t packSize = m_packFile.GetSize();
+
+        Internal::AssetPackHeader header;
+        if (packSize < sizeof(header))
+        {
+            DX_LOG(Error, "AssetPack", "Asset pack %s is corrupted.", packPath.generic_string().c_str());
+            Close();
+            return false;
+        }
+        std::memcpy(&header, packData, sizeof(header));
+
+        if (header.m_magic != Internal::AssetPackMagic ||
+            header.m_version != Internal::AssetPackVersion)
+        {
+            DX_LOG(Error, "AssetPack", "Asset pack %s is from a different version.", packPath.generic_string().c_str());
+            Close();
+            return false;
+        }
+
+        // Offsets are checked against the sizes first to avoid overflowing when adding them.
+        if (header.m_tocOffset % alignof(Entry) != 0 ||
+            header.m_tocOffset > packSize ||
+            header.m_entryCount > (packSize - header.m_tocOffset) / sizeof(Entry) ||
+            header.m_namesOffset > packSize ||
+            header.m_namesSize > packSize - header.m_namesOffset)
+        {
+            DX_LOG(Error, "AssetPack", "Asset pack %s is corrupted.", packPath.generic_string().c_str());
+            Close();
+            return false;
+        }
+
+        const Entry* entries = reinterpret_cast<const Entry*>(packData + header.m_tocOffset);
+        for (uint32_t entryIndex = 0; entryIndex < header.m_entryCount; ++entryIndex)
+        {
+            const Entry& entry = entries[entryIndex];
+            // The uncompressed size is checked so a corrupted entry doesn't make ReadFile allocate any size.
+            const bool validCompression =
+                (entry.m_compression == static_cast<uint32_t>(Internal::AssetPackCompression::None) && entry.m_size == entry.m_uncompressedSize) ||
+                (entry.m_compression == static_cast<uint32_t>(Internal::AssetPackCompression::LZ4) && entry.m_size <= packSize &&
+                    entry.m_uncompressedSize <= LZ4DecompressBound(static_cast<size_t>(entry.m_size)));
+
+            if (!validCompression ||
+                entry.m_nameOffset > header.m_namesSize ||
+                entry.m_nameSize > header.m_namesSize - entry.m_nameOffset ||
+                entry.m_offset > packSize ||
+                entry.m_size > packSize - entry.m_offset ||
+                (entryIndex > 0 && entries[entryIndex - 1].m_nameHash > entry.m_nameHash))
+            {
+                DX_LOG(Error, "AssetPack", "Asset pack %s is corrupted.", packPath.generic_string().c_str());
+                Close();
+                return false;
+            }
+        }
+
+        m_entries = entries;
+        m_entryCount = header.m_entryCount;
+        m_names = reinterpret_cast<const char*>(packData + header.m_namesOffset);
+
+        DX_LOG(Info, "AssetPack", "Asset pack %s mapped with %u files.", packPath.generic_string().c_str(), m_entryCount);
+
+        return true;
+    }
+
+    void AssetPack::Close()
+    {
+        m_packFile.Close();
+        m_entries = nullptr;
+        m_entryCount = 0;
+        m_names = nullptr;
+    }
+
+    bool AssetPack::Contains(std::string_view fileName) const
+    {
+        return FindEntry(fileName) != nullptr;
+    }
+
+    std::optional<std::span<const uint8_t>> AssetPack::GetFileView(std::string_view fileName) const
+    {
+        const Entry* entry = FindEntry(fileName);
+        if (!entry || entry->m_compression != static_cast<uint32_t>(Internal::AssetPackCompression::None))
+        {
+            return std::nullopt;
+        }
+
+        return std::span<const uint8_t>(m_packFile.GetData() + entry->m_offset, static_cast<size_t>(entry->m_size));
+    }
+
+    void AssetPack::PrefetchFile(std::string_view fileName) const
+    {
+        if (const Entry* entry = FindEntry(fileName))
+        {
+            m_packFile.Prefetch(static_cast<size_t>(entry->m_offset), static_cast<size_t>(entry->m_size));
+        }
+    }
+
+    std::optional<std::vector<uint8_t>> AssetPack::ReadFile(std::string_view fileName) const
+    {
+        const Entry* entry = FindEntry(fileName);
+        if (!entry)
+        {
+            return std::nullopt;
+        }
+
+        const std::span<const uint8_t> storedData(m_packFile.GetData() + entry->m_offset, static_cast<size_t>(entry->m_size));
+
+        if (entry->m_compression == static_cast<uint32_t>(Internal::AssetPackCompression::None))
+        {
+            return std::vector<uint8_t>(storedData.begin(), storedData.end());
+        }
+
+        std::vector<uint8_t> data(static_cast<size_t>(entry->m_uncompressedSize));
+        if (!LZ4Decompress(storedData, data))
+        {
+            DX_LOG(Error, "AssetPack", "Failed to decompress %.*s from asset pack.", static_cast<int>(fileName.size()), fileName.data());
+            return std::nullopt;
+        }
+        return data;
+    }
+
+    const AssetPack::Entry* AssetPack::FindEntry(std::string_view fileName) const
+    {
+        const HashValue nameHash = HashString(fileName);
+
+        const Entry* entriesEnd = m_entries + m_entryCount;
+        const Entry* entry = std::lower_bound(m_entries, entriesEnd, nameHash,
+            [](const Entry& entry, HashValue hash)
+            {
+                return entry.m_nameHash < hash;
+            });
+
+        // Names are compared in case of hash collisions.
+        for (; entry != entriesEnd && entry->m_nameHash == nameHash; ++entry)
+        {
+            if (std::string_view(m_names + entry->m_nameOffset, entry->m_nameSize) == fileName)
+            {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    bool WriteAssetPack(const std::filesystem::path& packPath, const std::filesystem::path& sourceFolder,
+        std::span<const std::string> fileNames, bool compress)
+    {
+        struct PackedFile
+        {
+            std::string m_name;
+            HashValue m_nameHash = 0;
+            std::vector<uint8_t> m_data; // As stored in the pack
+            uint64_t m_uncompressedSize = 0;
+            Internal::AssetPackCompression m_compression = Internal::AssetPackCompression::None;
+        };
+
+        std::vector<PackedFile> packedFiles;
+        packedFiles.reserve(fileNames.size());
+
+        for (const std::string& fileName : fileNames)
+        {
+            const auto filePath = sourceFolder / fileName;
+
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+            {
+                DX_LOG(Error, "AssetPack", "Failed to open %s.", filePath.generic_string().c_str());
+                return false;
+            }
+
+            PackedFile& packedFile = packedFiles.emplace_back();
+            packedFile.m_name = std::filesystem::path(fileName).generic_string();
+            packedFile.m_nameHash = HashString(packedFile.m_name);
+
+            packedFile.m_data.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0, std::ios::beg);
+            if (!file.read(reinterpret_cast<char*>(packedFile.m_data.data()), packedFile.m_data.size()))
+            {
+                DX_LOG(Error, "AssetPack", "Failed to read %s.", filePath.generic_string().c_str());
+                return false;
+            }
+            packedFile.m_uncompressedSize = packedFile.m_data.size();
+
+            // Files already compressed (png, jpg...) are stored as they are,
+            // so they can be used directly from the mapped pack.
+            if (compress)
+            {
+                std::vector<uint8_t> compressedData = LZ4Compress(packedFile.m_data);
+                if (compressedData.size() < packedFile.m_data.size() - packedFile.m_data.size() / 8)
+                {
+                    packedFile.m_data = std::move(compressedData);
+                    packedFile.m_compression = Internal::AssetPackCompression::LZ4;
+                }
+            }
+        }
+
+        std::ranges::sort(packedFiles, [](const PackedFile& lhs, const PackedFile& rhs)
+            {
+                return lhs.m_nameHash < rhs.m_nameHash;
+            });
+
+        Internal::AssetPackHeader header =
+        {
+            .m_magic = Internal::AssetPackMagic,
+            .m_version = Internal::AssetPackVersion,
+            .m_entryCount = static_cast<uint32_t>(packedFiles.size()),
+            .m_namesSize = 0,
+            .m_tocOffset = sizeof(Internal::AssetPackHeader),
+            .m_namesOffset = sizeof(Internal::AssetPackHeader) + packedFiles.size() * sizeof(AssetPack::Entry)
+        };
+
+        std::vector<AssetPack::Entry> entries;
+        entries.reserve(packedFiles.size());
+        std::string names;
+        for (const PackedFile& packedFile : packedFiles)
+        {
+            AssetPack::Entry& entry = entries.emplace_back();
+            entry.m_nameHash = packedFile.m_nameHash;
+            entry.m_size = packedFile.m_data.size();
+            entry.m_uncompressedSize = packedFile.m_uncompressedSize;
+            entry.m_nameOffset = static_cast<uint32_t>(names.size());
+            entry.m_nameSize = static_cast<uint32_t>(packedFile.m_name.size());
+            entry.m_compression = static_cast<uint32_t>(packedFile.m_compression);
+            entry.m_padding = 0;
+
+            names += packedFile.m_name;
+        }
+        header.m_namesSize = static_cast<uint32_t>(names.size());
+
+        size_t offset = Internal::AlignAssetPackOffset(header.m_namesOffset + names.size());
+        for (size_t fileIndex = 0; fileIndex < packedFiles.size(); ++fileIndex)
+        {
+            entries[fileIndex].m_offset = offset;
+            offset = Internal::AlignAssetPackOffset(offset + packedFiles[fileIndex].m_data.size());
+        }
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(packPath.parent_path(), errorCode);
+
+        // Write into a temporary file and rename it at the end, so a
+        // partially written pack is never picked up by the application.
+        const bool written = WriteFileAtomically(packPath, [&](std::ofstream& file)
+            {
+                const char padding[Internal::AssetPackEntryAlignment] = {};
+                const auto writePaddingTo = [&file, &padding](size_t offset)
+                {
+                    const size_t position = static_cast<size_t>(file.tellp());
+                    file.write(padding, offset - position);
+                };
+
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AssetPack::Entry));
+                file.write(names.data(), names.size());
+
+                for (size_t fileIndex = 0; fileIndex < packedFiles.size(); ++fileIndex)
+                {
+                    writePaddingTo(entries[fileIndex].m_offset);
+                    file.write(reinterpret_cast<const char*>(packedFiles[fileIndex].m_data.data()), packedFiles[fileIndex].m_data.size());
+                }
+            });
+        if (!written)
+        {
+            DX_LOG(Error, "AssetPack", "Failed to save asset pack %s.", packPath.generic_string().c_str());
+            return false;
+        }
+
+        DX_LOG(Info, "AssetPack", "Asset pack %s written with %u files (%.1f MB).",
+            packPath.generic_string().c_str(), header.m_entryCount, offset / (1024.0f * 1024.0f));
+
+        return true;
+    }
+} // namespace DX
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <File/MappedFile.h>
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <optional>
+#include <filesystem>
+
+namespace DX
+{
+    // Read-only archive with many asset files in a single file.
+    //
+    // The pack is memory mapped once and files are located with a binary
+    // search in its table of contents, sorted by the hash of the file names.
+    // Entries are aligned to pages, so uncompressed files are accessed directly
+    // from the mapping without copies. Files can be LZ4 compressed individually.
+    //
+    // File names are relative to the assets folder, using '/' as separator.
+    class AssetPack
+    {
+    public:
+        AssetPack();
+        ~AssetPack();
+
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        // Maps the pack file and validates its table of contents. Returns false if it fails.
+        bool Open(const std::filesystem::path& packPath);
+        void Close();
+
+        bool IsOpen() const { return m_packFile.IsOpen(); }
+
+        uint32_t GetFileCount() const { return m_entryCount; }
+
+        bool Contains(std::string_view fileName) const;
+
+        // Data of an uncompressed file, pointing directly into the mapped pack.
+        // Returns nullopt if the file is not in the pack or it's compressed.
+        std::optional<std::span<const uint8_t>> GetFileView(std::string_view fileName) const;
+
+        // Reads a file, decompressing it if needed.
+        // Returns nullopt if the file is not in the pack or it's corrupted.
+        std::optional<std::vector<uint8_t>> ReadFile(std::string_view fileName) const;
+
+        // Starts reading the data of a file from disk in the background.
+        // It does nothing if the file is not in the pack.
+        void PrefetchFile(std::string_view fileName) const;
+
+    private:
+        friend bool WriteAssetPack(const std::filesystem::path& packPath, const std::filesystem::path& sourceFolder,
+            std::span<const std::string> fileNames, bool compress);
+
+        struct Entry;
+        const Entry* FindEntry(std::string_view fileName) const;
+
+        MappedFile m_packFile;
+        const Entry* m_entries = nullptr;
+        uint32_t m_entryCount = 0;
+        const char* m_names = nullptr;
+    };
+
+    // Writes an asset pack with the files passed, whose names are relative to the source folder.
+    // When compress is true, files are LZ4 compressed if it reduces their size noticeably.
+    bool WriteAssetPack(const std::filesystem::path& packPath, const std::filesystem::path& sourceFolder,
+        std::span<const std::string> fileNames, bool compress);
+} // namespace DX
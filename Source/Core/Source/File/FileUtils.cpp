@@ -1,18 +1,93 @@
 #include <File/FileUtils.h>
+#include <File/AssetPack.h>
 #include <Log/Log.h>
 
 #include <array>
+#include <atomic>
 #include <fstream>
+#include <random>
 #include <sstream>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 namespace DX
 {
+    namespace Internal
+    {
+        static std::unique_ptr<AssetPack> MountedAssetPack;
+
+        // Name of the file inside the asset pack, relative to the assets folder and using '/' as separator.
+        std::string GetAssetPackFileName(const std::filesystem::path& filePath)
+        {
+            if (filePath.is_absolute())
+            {
+                return filePath.lexically_relative(GetAssetPath()).generic_string();
+            }
+            return filePath.lexically_normal().generic_string();
+        }
+
+        std::filesystem::path FindAssetPath()
+        {
+            auto execPath = GetExecutablePath();
+            execPath /= "Assets";
+            if (std::filesystem::exists(execPath))
+            {
+                return execPath;
+            }
+
+            // If the Assets folder is not in the same location as the executable,
+            // that could be because the executable is being run from a build folder
+            // (for example from Visual Studio). Try to find the 'build' folder to
+            // extract the project path and use that to look for the Assets folder.
+            if (auto it = execPath.generic_string().find("build");
+                it != std::string::npos)
+            {
+                std::filesystem::path projectPath = execPath.generic_string().substr(0, it);
+                projectPath /= "Assets";
+                if (std::filesystem::exists(projectPath))
+                {
+                    return projectPath;
+                }
+            }
+
+            DX_LOG(Error, "FileUtils", "Assets path not found.");
+            return {};
+        }
+
+        // Path next to the file unique to this process and call, so threads and
+        // processes writing the same file at the same time use different temporary files.
+        std::filesystem::path CreateTemporaryPath(const std::filesystem::path& filePath)
+        {
+            static const uint64_t ProcessSalt = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+            static std::atomic<uint64_t> TemporaryFileCount = 0;
+
+            const uint64_t threadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+            std::ostringstream suffix;
+            suffix << '.' << std::hex << (ProcessSalt ^ threadHash) << '.' << TemporaryFileCount++ << ".tmp";
+
+            auto temporaryPath = filePath;
+            temporaryPath += suffix.str();
+            return temporaryPath;
+        }
+    } // namespace Internal
+
     std::optional<std::string> ReadAssetTextFile(const std::string& fileName)
     {
+        if (Internal::MountedAssetPack)
+        {
+            if (auto data = Internal::MountedAssetPack->ReadFile(Internal::GetAssetPackFileName(fileName)))
+            {
+                return std::string(data->begin(), data->end());
+            }
+        }
+
         auto fileNamePath = GetAssetPath() / fileName;
         if (!std::filesystem::exists(fileNamePath))
         {
@@ -38,6 +113,14 @@ namespace DX
 
     std::optional<std::vector<uint8_t>> ReadAssetBinaryFile(const std::string& fileName)
     {
+        if (Internal::MountedAssetPack)
+        {
+            if (auto data = Internal::MountedAssetPack->ReadFile(Internal::GetAssetPackFileName(fileName)))
+            {
+                return data;
+            }
+        }
+
         auto fileNamePath = GetAssetPath() / fileName;
         if (!std::filesystem::exists(fileNamePath))
         {
@@ -72,31 +155,155 @@ namespace DX
         }
     }
 
-    std::filesystem::path GetAssetPath()
+    AssetFile::AssetFile() = default;
+    AssetFile::~AssetFile() = default;
+    AssetFile::AssetFile(AssetFile&&) = default;
+    AssetFile& AssetFile::operator=(AssetFile&&) = default;
+
+    std::optional<AssetFile> OpenAssetFile(const std::filesystem::path& filePath)
+    {
+        AssetFile assetFile;
+
+        if (Internal::MountedAssetPack)
+        {
+            const std::string packFileName = Internal::GetAssetPackFileName(filePath);
+
+            // Uncompressed files are used directly from the mapped pack.
+            if (auto fileView = Internal::MountedAssetPack->GetFileView(packFileName))
+            {
+                assetFile.m_data = *fileView;
+                return assetFile;
+            }
+            else if (auto fileData = Internal::MountedAssetPack->ReadFile(packFileName))
+            {
+                assetFile.m_decompressedData = std::move(*fileData);
+                assetFile.m_data = assetFile.m_decompressedData;
+                return assetFile;
+            }
+        }
+
+        const auto fileNamePath = filePath.is_absolute() ? filePath : GetAssetPath() / filePath;
+
+        assetFile.m_mappedFile = std::make_unique<MappedFile>();
+        if (!assetFile.m_mappedFile->Open(fileNamePath))
+        {
+            return std::nullopt;
+        }
+        assetFile.m_data = std::span<const uint8_t>(assetFile.m_mappedFile->GetData(), assetFile.m_mappedFile->GetSize());
+
+        return assetFile;
+    }
+
+    void PrefetchAssetFile(const std::filesystem::path& filePath)
     {
-        auto execPath = GetExecutablePath();
-        execPath /= "Assets";
-        if (std::filesystem::exists(execPath))
+        if (Internal::MountedAssetPack)
         {
-            return execPath;
+            const std::string packFileName = Internal::GetAssetPackFileName(filePath);
+            if (Internal::MountedAssetPack->Contains(packFileName))
+            {
+                Internal::MountedAssetPack->PrefetchFile(packFileName);
+                return;
+            }
         }
 
-        // If the Assets folder is not in the same location as the executable,
-        // that could be because the executable is being run from a build folder
-        // (for example from Visual Studio). Try to find the 'build' folder to
-        // extract the project path and use that to look for the Assets folder.
-        if (auto it = execPath.generic_string().find("build");
-            it != std::string::npos)
+        [[maybe_unused]] const auto fileNamePath = filePath.is_absolute() ? filePath : GetAssetPath() / filePath;
+
+#ifdef __linux__
+        // Readahead of the whole file into the page cache, it returns without waiting for it.
+        const int fileDescriptor = open(fileNamePath.c_str(), O_RDONLY);
+        if (fileDescriptor >= 0)
         {
-            std::filesystem::path projectPath = execPath.generic_string().substr(0, it);
-            projectPath /= "Assets";
-            if (std::filesystem::exists(projectPath))
+            posix_fadvise(fileDescriptor, 0, 0, POSIX_FADV_WILLNEED);
+            close(fileDescriptor);
+        }
+#endif
+        // Other platforms rely on the asset being loaded in the background to bring it into memory.
+    }
+
+    bool AssetFileExists(const std::filesystem::path& filePath)
+    {
+        if (Internal::MountedAssetPack &&
+            Internal::MountedAssetPack->Contains(Internal::GetAssetPackFileName(filePath)))
+        {
+            return true;
+        }
+
+        return std::filesystem::exists(filePath.is_absolute() ? filePath : GetAssetPath() / filePath);
+    }
+
+    bool WriteFileAtomically(const std::filesystem::path& filePath, const std::function<void(std::ofstream& file)>& writeFunc)
+    {
+        const auto temporaryPath = Internal::CreateTemporaryPath(filePath);
+
+        std::error_code errorCode;
+        if (std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.is_open())
+        {
+            writeFunc(file);
+
+            if (!file.good())
             {
-                return projectPath;
+                DX_LOG(Error, "FileUtils", "Failed to write file %s.", temporaryPath.generic_string().c_str());
+                file.close();
+                std::filesystem::remove(temporaryPath, errorCode);
+                return false;
             }
         }
+        else
+        {
+            DX_LOG(Error, "FileUtils", "Failed to open file %s for writing.", temporaryPath.generic_string().c_str());
+            return false;
+        }
 
-        DX_LOG(Error, "FileUtils", "Assets path not found.");
+        std::filesystem::rename(temporaryPath, filePath, errorCode);
+        if (errorCode)
+        {
+            DX_LOG(Error, "FileUtils", "Failed to rename %s to %s.",
+                temporaryPath.generic_string().c_str(), filePath.generic_string().c_str());
+            std::filesystem::remove(temporaryPath, errorCode);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MountAssetPack(const std::filesystem::path& packPath)
+    {
+        auto assetPack = std::make_unique<AssetPack>();
+        if (!assetPack->Open(packPath))
+        {
+            DX_LOG(Error, "FileUtils", "Failed to mount asset pack %s.", packPath.generic_string().c_str());
+            return false;
+        }
+
+        Internal::MountedAssetPack = std::move(assetPack);
+        return true;
+    }
+
+    void UnmountAssetPack()
+    {
+        Internal::MountedAssetPack.reset();
+    }
+
+    const AssetPack* GetMountedAssetPack()
+    {
+        return Internal::MountedAssetPack.get();
+    }
+
+    std::filesystem::path GetAssetPath()
+    {
+        // The location of the assets folder doesn't change while running.
+        static const std::filesystem::path AssetPath = Internal::FindAssetPath();
+        return AssetPath;
+    }
+
+    std::filesystem::path GetAssetCachePath()
+    {
+        if (auto assetPath = GetAssetPath();
+            !assetPath.empty())
+        {
+            return assetPath.parent_path() / "Cache";
+        }
         return {};
     }
 
@@ -107,6 +314,10 @@ namespace DX
         GetModuleFileName(NULL, path, MAX_PATH);
         std::filesystem::path execPath(path);
         return execPath.remove_filename();
+#elif defined(__linux__)
+        std::error_code errorCode;
+        std::filesystem::path execPath = std::filesystem::read_symlink("/proc/self/exe", errorCode);
+        return execPath.remove_filename();
 #else
         #error "Renderer::GetExecutablePath: Unsupported platform."
         return {};
@@ -1,12 +1,20 @@
 #pragma once
 
+#include <File/MappedFile.h>
+
 #include <vector>
 #include <string>
+#include <span>
+#include <memory>
 #include <filesystem>
+#include <functional>
+#include <iosfwd>
 #include <optional>
 
 namespace DX
 {
+    class AssetPack;
+
     // Reads the content of a text file.
     // The filename is relative to the assets folder.
     std::optional<std::string> ReadAssetTextFile(const std::string& fileName);
@@ -15,9 +23,64 @@ namespace DX
     // The filename is relative to the assets folder.
     std::optional<std::vector<uint8_t>> ReadAssetBinaryFile(const std::string& fileName);
 
+    // Read-only content of an asset file, mapped from the assets folder
+    // or from the mounted asset pack, where it might be decompressed.
+    class AssetFile
+    {
+    public:
+        AssetFile();
+        ~AssetFile();
+
+        AssetFile(AssetFile&&);
+        AssetFile& operator=(AssetFile&&);
+
+        AssetFile(const AssetFile&) = delete;
+        AssetFile& operator=(const AssetFile&) = delete;
+
+        std::span<const uint8_t> GetData() const { return m_data; }
+
+    private:
+        friend std::optional<AssetFile> OpenAssetFile(const std::filesystem::path& filePath);
+
+        std::span<const uint8_t> m_data;
+        std::vector<uint8_t> m_decompressedData;
+        std::unique_ptr<MappedFile> m_mappedFile;
+    };
+
+    // Opens an asset file, looking for it in the mounted asset pack first and then in the assets folder.
+    // The path is either relative to the assets folder or an absolute path inside it.
+    std::optional<AssetFile> OpenAssetFile(const std::filesystem::path& filePath);
+
+    // Hints the OS to start reading an asset file from disk in the background, so opening it
+    // later doesn't block on I/O. It doesn't wait for it and it does nothing if the file doesn't exist.
+    // The path is either relative to the assets folder or an absolute path inside it.
+    void PrefetchAssetFile(const std::filesystem::path& filePath);
+
+    // Returns whether the asset file exists in the mounted asset pack or in the assets folder.
+    // The path is either relative to the assets folder or an absolute path inside it.
+    bool AssetFileExists(const std::filesystem::path& filePath);
+
+    // Writes a binary file through writeFunc into a uniquely named temporary file next to it,
+    // which is renamed over the file once fully written. Readers never see a partially written
+    // file and concurrent writers don't clobber each other's temporary file.
+    // Returns false and leaves the existing file untouched if it fails.
+    bool WriteFileAtomically(const std::filesystem::path& filePath, const std::function<void(std::ofstream& file)>& writeFunc);
+
+    // Maps an asset pack and resolves asset files against it from now on.
+    // It must be mounted before any asset is loaded. Returns false if it fails.
+    bool MountAssetPack(const std::filesystem::path& packPath);
+    void UnmountAssetPack();
+
+    // Returns the mounted asset pack or null if there is none.
+    const AssetPack* GetMountedAssetPack();
+
     // Returns the path to the assets folder.
     std::filesystem::path GetAssetPath();
 
+    // Returns the path to the folder where cooked assets are stored.
+    // It's located next to the assets folder and it's not guaranteed to exist.
+    std::filesystem::path GetAssetCachePath();
+
     // Returns the path to the executable folder.
     std::filesystem::path GetExecutablePath();
 } // namespace DX
@@ -0,0 +1,240 @@
+#include <File/FileWatcher.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace DX
+{
+    namespace Internal
+    {
+#ifdef __linux__
+        static constexpr uint32_t FileWatcherEventMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+#else
+        // Scanning the whole folder is not cheap, so it's not done on every poll.
+        static constexpr auto FileWatcherScanInterval = std::chrono::milliseconds(500);
+#endif
+    } // namespace Internal
+
+    FileWatcher::FileWatcher() = default;
+
+    FileWatcher::~FileWatcher()
+    {
+        Stop();
+    }
+
+#ifdef __linux__
+    bool FileWatcher::Start(const std::filesystem::path& folderPath)
+    {
+        Stop();
+
+        m_inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyDescriptor < 0)
+        {
+            DX_LOG(Error, "FileWatcher", "Failed to initialize inotify.");
+            return false;
+        }
+
+        m_folderPath = folderPath;
+        AddWatches({});
+        if (m_watchedFolders.empty())
+        {
+            DX_LOG(Error, "FileWatcher", "Failed to watch folder %s.", folderPath.generic_string().c_str());
+            Stop();
+            return false;
+        }
+
+        DX_LOG(Info, "FileWatcher", "Watching %zu folders in %s.", m_watchedFolders.size(), folderPath.generic_string().c_str());
+
+        return true;
+    }
+
+    void FileWatcher::Stop()
+    {
+        if (m_inotifyDescriptor >= 0)
+        {
+            // Closing the descriptor removes all its watches.
+            close(m_inotifyDescriptor);
+            m_inotifyDescriptor = -1;
+        }
+        m_watchedFolders.clear();
+        m_folderPath.clear();
+    }
+
+    std::vector<std::string> FileWatcher::PollChanges()
+    {
+        std::vector<std::string> modifiedFiles;
+        if (m_inotifyDescriptor < 0)
+        {
+            return modifiedFiles;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            const ssize_t readSize = read(m_inotifyDescriptor, buffer, sizeof(buffer));
+            if (readSize <= 0)
+            {
+                if (readSize < 0 && errno != EAGAIN)
+                {
+                    DX_LOG(Error, "FileWatcher", "Failed to read file events.");
+                }
+                break;
+            }
+
+            for (ssize_t offset = 0; offset < readSize;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    DX_LOG(Warning, "FileWatcher", "Too many file events, some modifications have been missed.");
+                    continue;
+                }
+
+                auto folderIt = m_watchedFolders.find(event->wd);
+                if (folderIt == m_watchedFolders.end())
+                {
+                    continue;
+                }
+
+                if (event->mask & IN_IGNORED)
+                {
+                    // The folder has been deleted or moved out.
+                    m_watchedFolders.erase(folderIt);
+                    continue;
+                }
+
+                if (event->len == 0)
+                {
+                    continue;
+                }
+
+                const std::filesystem::path relativePath = folderIt->second / event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    // New folders are watched too. Files are created after the watch
+                    // is added, so they'll be reported when they are closed.
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        AddWatches(relativePath);
+                    }
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    modifiedFiles.push_back(relativePath.generic_string());
+                }
+            }
+        }
+
+        // Saving a file can generate several events.
+        std::ranges::sort(modifiedFiles);
+        const auto duplicates = std::ranges::unique(modifiedFiles);
+        modifiedFiles.erase(duplicates.begin(), duplicates.end());
+
+        return modifiedFiles;
+    }
+
+    void FileWatcher::AddWatches(const std::filesystem::path& relativeFolderPath)
+    {
+        const auto folderPath = m_folderPath / relativeFolderPath;
+
+        const int watchDescriptor = inotify_add_watch(m_inotifyDescriptor, folderPath.c_str(), Internal::FileWatcherEventMask);
+        if (watchDescriptor < 0)
+        {
+            DX_LOG(Warning, "FileWatcher", "Failed to watch folder %s.", folderPath.generic_string().c_str());
+            return;
+        }
+        m_watchedFolders[watchDescriptor] = relativeFolderPath;
+
+        std::error_code errorCode;
+        for (const auto& entry : std::filesystem::directory_iterator(folderPath, errorCode))
+        {
+            if (entry.is_directory(errorCode))
+            {
+                AddWatches(relativeFolderPath / entry.path().filename());
+            }
+        }
+    }
+#else
+    bool FileWatcher::Start(const std::filesystem::path& folderPath)
+    {
+        Stop();
+
+        std::error_code errorCode;
+        if (!std::filesystem::is_directory(folderPath, errorCode))
+        {
+            DX_LOG(Error, "FileWatcher", "Failed to watch folder %s.", folderPath.generic_string().c_str());
+            return false;
+        }
+
+        m_folderPath = folderPath;
+        ScanFiles(nullptr);
+
+        DX_LOG(Info, "FileWatcher", "Watching %zu files in %s.", m_fileWriteTimes.size(), folderPath.generic_string().c_str());
+
+        return true;
+    }
+
+    void FileWatcher::Stop()
+    {
+        m_fileWriteTimes.clear();
+        m_folderPath.clear();
+    }
+
+    std::vector<std::string> FileWatcher::PollChanges()
+    {
+        std::vector<std::string> modifiedFiles;
+        if (!IsWatching())
+        {
+            return modifiedFiles;
+        }
+
+        if (const auto now = std::chrono::steady_clock::now();
+            now - m_lastScanTime >= Internal::FileWatcherScanInterval)
+        {
+            ScanFiles(&modifiedFiles);
+        }
+
+        return modifiedFiles;
+    }
+
+    void FileWatcher::ScanFiles(std::vector<std::string>* modifiedFiles)
+    {
+        m_lastScanTime = std::chrono::steady_clock::now();
+
+        std::error_code errorCode;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(m_folderPath, errorCode))
+        {
+            if (!entry.is_regular_file(errorCode))
+            {
+                continue;
+            }
+
+            const auto writeTime = entry.last_write_time(errorCode);
+            if (errorCode)
+            {
+                continue;
+            }
+
+            const std::string relativePath = entry.path().lexically_relative(m_folderPath).generic_string();
+            // New files are also reported as modified.
+            auto [it, inserted] = m_fileWriteTimes.try_emplace(relativePath, writeTime);
+            if (inserted || it->second != writeTime)
+            {
+                it->second = writeTime;
+                if (modifiedFiles)
+                {
+                    modifiedFiles->push_back(relativePath);
+                }
+            }
+        }
+    }
+#endif
+} // namespace DX
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+#include <chrono>
+
+namespace DX
+{
+    // Watches the files of a folder and its subfolders for modifications.
+    //
+    // On Linux it uses inotify, files are reported once they are closed after
+    // being written or moved into the folder. On other platforms the folder is
+    // scanned periodically for changes in the last write time of the files.
+    class FileWatcher
+    {
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // Starts watching the folder and its subfolders. Returns false if it fails.
+        bool Start(const std::filesystem::path& folderPath);
+        void Stop();
+
+        bool IsWatching() const { return !m_folderPath.empty(); }
+
+        // Returns the files modified since the last poll without blocking. Filenames
+        // are relative to the watched folder, using '/' as separator, and reported once.
+        std::vector<std::string> PollChanges();
+
+    private:
+        std::filesystem::path m_folderPath;
+
+#ifdef __linux__
+        // Watches the folder and all its subfolders. The path is relative to the watched folder.
+        void AddWatches(const std::filesystem::path& relativeFolderPath);
+
+        int m_inotifyDescriptor = -1;
+
+        // Relative path of the folder watched by each watch descriptor.
+        std::unordered_map<int, std::filesystem::path> m_watchedFolders;
+#else
+        // Updates the last write time of all files, adding the ones modified to the output.
+        void ScanFiles(std::vector<std::string>* modifiedFiles);
+
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_fileWriteTimes;
+        std::chrono::steady_clock::time_point m_lastScanTime;
+#endif
+    };
+} // namespace DX
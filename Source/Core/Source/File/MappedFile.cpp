@@ -0,0 +1,156 @@
+#include <File/MappedFile.h>
+#include <Log/Log.h>
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DX
+{
+    MappedFile::MappedFile() = default;
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const std::filesystem::path& filePath)
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE fileHandle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            DX_LOG(Error, "MappedFile", "Failed to open file %s.", filePath.generic_string().c_str());
+            return false;
+        }
+        m_fileHandle = fileHandle;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize))
+        {
+            DX_LOG(Error, "MappedFile", "Failed to get size of file %s.", filePath.generic_string().c_str());
+            Close();
+            return false;
+        }
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+
+        // Empty files cannot be mapped, but they are valid files.
+        if (m_size > 0)
+        {
+            HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mappingHandle)
+            {
+                DX_LOG(Error, "MappedFile", "Failed to create file mapping of %s.", filePath.generic_string().c_str());
+                Close();
+                return false;
+            }
+            m_mappingHandle = mappingHandle;
+
+            m_data = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            if (!m_data)
+            {
+                DX_LOG(Error, "MappedFile", "Failed to map view of file %s.", filePath.generic_string().c_str());
+                Close();
+                return false;
+            }
+        }
+#else
+        m_fileDescriptor = open(filePath.c_str(), O_RDONLY);
+        if (m_fileDescriptor < 0)
+        {
+            DX_LOG(Error, "MappedFile", "Failed to open file %s.", filePath.generic_string().c_str());
+            return false;
+        }
+
+        struct stat fileStat;
+        if (fstat(m_fileDescriptor, &fileStat) != 0)
+        {
+            DX_LOG(Error, "MappedFile", "Failed to get size of file %s.", filePath.generic_string().c_str());
+            Close();
+            return false;
+        }
+        m_size = static_cast<size_t>(fileStat.st_size);
+
+        // Empty files cannot be mapped, but they are valid files.
+        if (m_size > 0)
+        {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+            if (data == MAP_FAILED)
+            {
+                DX_LOG(Error, "MappedFile", "Failed to map file %s.", filePath.generic_string().c_str());
+                Close();
+                return false;
+            }
+            m_data = static_cast<const uint8_t*>(data);
+        }
+#endif
+
+        m_isOpen = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle)
+        {
+            CloseHandle(m_mappingHandle);
+            m_mappingHandle = nullptr;
+        }
+        if (m_fileHandle)
+        {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = nullptr;
+        }
+#else
+        if (m_data)
+        {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+        if (m_fileDescriptor >= 0)
+        {
+            close(m_fileDescriptor);
+            m_fileDescriptor = -1;
+        }
+#endif
+
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+    }
+
+    void MappedFile::Prefetch(size_t offset, size_t size) const
+    {
+        if (!m_data || offset >= m_size)
+        {
+            return;
+        }
+        size = std::min(size, m_size - offset);
+
+#ifdef _WIN32
+        WIN32_MEMORY_RANGE_ENTRY memoryRange;
+        memoryRange.VirtualAddress = const_cast<uint8_t*>(m_data + offset);
+        memoryRange.NumberOfBytes = size;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &memoryRange, 0);
+#else
+        // madvise needs the address aligned to the page size.
+        static const size_t PageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t alignedOffset = offset & ~(PageSize - 1);
+        madvise(const_cast<uint8_t*>(m_data + alignedOffset), size + (offset - alignedOffset), MADV_WILLNEED);
+#endif
+    }
+} // namespace DX
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+
+namespace DX
+{
+    // Read-only memory mapped file.
+    //
+    // The content of the file is accessible through GetData() without
+    // copying it into memory first, pages are brought in by the OS on demand.
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Opens and maps the entire file. Returns false if it fails.
+        bool Open(const std::filesystem::path& filePath);
+        void Close();
+
+        bool IsOpen() const { return m_isOpen; }
+
+        const uint8_t* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+        // Hints the OS to start reading a range of the file in the background,
+        // so accessing it later doesn't block on disk I/O. It doesn't wait for it.
+        void Prefetch(size_t offset, size_t size) const;
+
+    private:
+        bool m_isOpen = false;
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#else
+        int m_fileDescriptor = -1;
+#endif
+    };
+} // namespace DX
@@ -0,0 +1,38 @@
+#include <Hash/Hash.h>
+
+#include <cstring>
+
+namespace DX
+{
+    namespace Internal
+    {
+        static constexpr HashValue HashPrime = 0x00000100000001B3ull;
+    }
+
+    HashValue HashBytes(const void* data, size_t size, HashValue seed)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        HashValue hash = seed ^ size;
+
+        // Main loop consuming 8 bytes at a time
+        const size_t wordCount = size / sizeof(uint64_t);
+        for (size_t i = 0; i < wordCount; ++i)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+
+            hash ^= word;
+            hash *= Internal::HashPrime;
+            hash ^= hash >> 32;
+        }
+
+        // Remaining bytes
+        for (size_t i = wordCount * sizeof(uint64_t); i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= Internal::HashPrime;
+        }
+
+        return hash;
+    }
+} // namespace DX
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace DX
+{
+    using HashValue = uint64_t;
+
+    // Offset basis of the 64-bit FNV-1a hash, used as default seed.
+    inline constexpr HashValue HashSeed = 0xCBF29CE484222325ull;
+
+    // Calculates a 64-bit non-cryptographic hash of a block of memory.
+    // It's a variant of FNV-1a that consumes 8 bytes per step, good
+    // enough to detect changes in asset files while being fast to compute.
+    HashValue HashBytes(const void* data, size_t size, HashValue seed = HashSeed);
+
+    inline HashValue HashString(std::string_view string, HashValue seed = HashSeed)
+    {
+        return HashBytes(string.data(), string.size(), seed);
+    }
+
+    template<typename T>
+    HashValue HashValueOf(const T& value, HashValue seed = HashSeed)
+    {
+        return HashBytes(&value, sizeof(T), seed);
+    }
+
+    // Combines two hashes into one. Order of the operands matters.
+    inline HashValue HashCombine(HashValue hash, HashValue value)
+    {
+        return hash ^ (value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2));
+    }
+} // namespace DX
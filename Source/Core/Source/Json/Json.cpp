@@ -0,0 +1,406 @@
+#include <Json/Json.h>
+
+#include <charconv>
+#include <cmath>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Nesting limit to protect the recursive parser from malicious documents.
+        static constexpr uint32_t JsonMaxDepth = 256;
+
+        static const JsonValue JsonNullValue;
+
+        void AppendUtf8(std::string& output, uint32_t codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                output.push_back(static_cast<char>(codePoint));
+            }
+            else if (codePoint < 0x800)
+            {
+                output.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else if (codePoint < 0x10000)
+            {
+                output.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                output.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+    }
+
+    class JsonParser
+    {
+    public:
+        explicit JsonParser(std::string_view text)
+            : m_text(text)
+        {
+        }
+
+        bool ParseDocument(JsonValue& value)
+        {
+            SkipWhitespace();
+            if (!ParseValue(value, 0))
+            {
+                return false;
+            }
+            SkipWhitespace();
+            return m_position == m_text.size();
+        }
+
+    private:
+        std::string_view m_text;
+        size_t m_position = 0;
+
+        bool IsEnd() const
+        {
+            return m_position >= m_text.size();
+        }
+
+        char Peek() const
+        {
+            return IsEnd() ? '\0' : m_text[m_position];
+        }
+
+        void SkipWhitespace()
+        {
+            while (!IsEnd())
+            {
+                const char c = m_text[m_position];
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+                {
+                    break;
+                }
+                ++m_position;
+            }
+        }
+
+        bool Consume(char expected)
+        {
+            if (Peek() != expected)
+            {
+                return false;
+            }
+            ++m_position;
+            return true;
+        }
+
+        bool ConsumeLiteral(std::string_view literal)
+        {
+            if (m_text.substr(m_position, literal.size()) != literal)
+            {
+                return false;
+            }
+            m_position += literal.size();
+            return true;
+        }
+
+        bool ParseValue(JsonValue& value, uint32_t depth)
+        {
+            if (depth > Internal::JsonMaxDepth)
+            {
+                return false;
+            }
+
+            switch (Peek())
+            {
+            case '{':
+                return ParseObject(value, depth);
+            case '[':
+                return ParseArray(value, depth);
+            case '"':
+                value.m_type = JsonValue::Type::String;
+                return ParseString(value.m_string);
+            case 't':
+                value.m_type = JsonValue::Type::Bool;
+                value.m_bool = true;
+                return ConsumeLiteral("true");
+            case 'f':
+                value.m_type = JsonValue::Type::Bool;
+                value.m_bool = false;
+                return ConsumeLiteral("false");
+            case 'n':
+                value.m_type = JsonValue::Type::Null;
+                return ConsumeLiteral("null");
+            default:
+                value.m_type = JsonValue::Type::Number;
+                return ParseNumber(value.m_number);
+            }
+        }
+
+        bool ParseObject(JsonValue& value, uint32_t depth)
+        {
+            value.m_type = JsonValue::Type::Object;
+            ++m_position; // '{'
+
+            SkipWhitespace();
+            if (Consume('}'))
+            {
+                return true;
+            }
+
+            do
+            {
+                SkipWhitespace();
+                JsonValue::Member& member = value.m_members.emplace_back();
+                if (!ParseString(member.first))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (!Consume(':'))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (!ParseValue(member.second, depth + 1))
+                {
+                    return false;
+                }
+                SkipWhitespace();
+            } while (Consume(','));
+
+            return Consume('}');
+        }
+
+        bool ParseArray(JsonValue& value, uint32_t depth)
+        {
+            value.m_type = JsonValue::Type::Array;
+            ++m_position; // '['
+
+            SkipWhitespace();
+            if (Consume(']'))
+            {
+                return true;
+            }
+
+            do
+            {
+                SkipWhitespace();
+                if (!ParseValue(value.m_elements.emplace_back(), depth + 1))
+                {
+                    return false;
+                }
+                SkipWhitespace();
+            } while (Consume(','));
+
+            return Consume(']');
+        }
+
+        bool ParseHex4(uint32_t& codeUnit)
+        {
+            if (m_position + 4 > m_text.size())
+            {
+                return false;
+            }
+
+            const char* begin = m_text.data() + m_position;
+            const auto result = std::from_chars(begin, begin + 4, codeUnit, 16);
+            if (result.ec != std::errc() || result.ptr != begin + 4)
+            {
+                return false;
+            }
+            m_position += 4;
+            return true;
+        }
+
+        bool ParseString(std::string& output)
+        {
+            if (!Consume('"'))
+            {
+                return false;
+            }
+
+            while (!IsEnd())
+            {
+                const char c = m_text[m_position++];
+                if (c == '"')
+                {
+                    return true;
+                }
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    return false; // Control characters must be escaped
+                }
+                if (c != '\\')
+                {
+                    output.push_back(c);
+                    continue;
+                }
+
+                if (IsEnd())
+                {
+                    return false;
+                }
+
+                switch (m_text[m_position++])
+                {
+                case '"': output.push_back('"'); break;
+                case '\\': output.push_back('\\'); break;
+                case '/': output.push_back('/'); break;
+                case 'b': output.push_back('\b'); break;
+                case 'f': output.push_back('\f'); break;
+                case 'n': output.push_back('\n'); break;
+                case 'r': output.push_back('\r'); break;
+                case 't': output.push_back('\t'); break;
+                case 'u':
+                {
+                    uint32_t codePoint = 0;
+                    if (!ParseHex4(codePoint))
+                    {
+                        return false;
+                    }
+
+                    // Characters outside the basic plane are encoded as a surrogate pair
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                    {
+                        uint32_t lowSurrogate = 0;
+                        if (!ConsumeLiteral("\\u") ||
+                            !ParseHex4(lowSurrogate) ||
+                            lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+                        {
+                            return false;
+                        }
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                    }
+                    else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+                    {
+                        return false;
+                    }
+
+                    Internal::AppendUtf8(output, codePoint);
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        bool ParseNumber(double& number)
+        {
+            // Validate the JSON number grammar, which is stricter than from_chars.
+            const size_t start = m_position;
+            Consume('-');
+            if (!Consume('0'))
+            {
+                if (!(Peek() >= '1' && Peek() <= '9'))
+                {
+                    return false;
+                }
+                while (Peek() >= '0' && Peek() <= '9') { ++m_position; }
+            }
+
+            if (Consume('.'))
+            {
+                if (!(Peek() >= '0' && Peek() <= '9'))
+                {
+                    return false;
+                }
+                while (Peek() >= '0' && Peek() <= '9') { ++m_position; }
+            }
+
+            if (Peek() == 'e' || Peek() == 'E')
+            {
+                ++m_position;
+                if (Peek() == '+' || Peek() == '-')
+                {
+                    ++m_position;
+                }
+                if (!(Peek() >= '0' && Peek() <= '9'))
+                {
+                    return false;
+                }
+                while (Peek() >= '0' && Peek() <= '9') { ++m_position; }
+            }
+
+            const char* begin = m_text.data() + start;
+            const char* end = m_text.data() + m_position;
+            const auto result = std::from_chars(begin, end, number);
+            return result.ec == std::errc() && result.ptr == end;
+        }
+    };
+
+    bool JsonValue::GetBool(bool defaultValue) const
+    {
+        return IsBool() ? m_bool : defaultValue;
+    }
+
+    double JsonValue::GetNumber(double defaultValue) const
+    {
+        return IsNumber() ? m_number : defaultValue;
+    }
+
+    float JsonValue::GetFloat(float defaultValue) const
+    {
+        return IsNumber() ? static_cast<float>(m_number) : defaultValue;
+    }
+
+    uint32_t JsonValue::GetUint(uint32_t defaultValue) const
+    {
+        if (!IsNumber() ||
+            m_number < 0.0 ||
+            m_number > static_cast<double>(UINT32_MAX) ||
+            std::floor(m_number) != m_number)
+        {
+            return defaultValue;
+        }
+        return static_cast<uint32_t>(m_number);
+    }
+
+    std::string_view JsonValue::GetString(std::string_view defaultValue) const
+    {
+        return IsString() ? std::string_view(m_string) : defaultValue;
+    }
+
+    size_t JsonValue::GetSize() const
+    {
+        switch (m_type)
+        {
+        case Type::Array: return m_elements.size();
+        case Type::Object: return m_members.size();
+        default: return 0;
+        }
+    }
+
+    const JsonValue& JsonValue::operator[](size_t index) const
+    {
+        return (index < m_elements.size()) ? m_elements[index] : Internal::JsonNullValue;
+    }
+
+    const JsonValue* JsonValue::Find(std::string_view key) const
+    {
+        for (const Member& member : m_members)
+        {
+            if (member.first == key)
+            {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+
+    std::optional<JsonValue> ParseJson(std::string_view text)
+    {
+        JsonValue value;
+        if (JsonParser parser(text); !parser.ParseDocument(value))
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+} // namespace DX
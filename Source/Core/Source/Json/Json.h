@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <optional>
+
+namespace DX
+{
+    // Read-only JSON document value.
+    //
+    // It only supports what asset formats need: values are parsed into a tree
+    // and accessed by key or index. Accessing a value with the wrong type returns
+    // the default value, so missing or malformed properties can be handled in one place.
+    class JsonValue
+    {
+    public:
+        enum class Type
+        {
+            Null,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        using Member = std::pair<std::string, JsonValue>;
+
+        JsonValue() = default;
+
+        Type GetType() const { return m_type; }
+
+        bool IsNull() const { return m_type == Type::Null; }
+        bool IsBool() const { return m_type == Type::Bool; }
+        bool IsNumber() const { return m_type == Type::Number; }
+        bool IsString() const { return m_type == Type::String; }
+        bool IsArray() const { return m_type == Type::Array; }
+        bool IsObject() const { return m_type == Type::Object; }
+
+        bool GetBool(bool defaultValue = false) const;
+        double GetNumber(double defaultValue = 0.0) const;
+        float GetFloat(float defaultValue = 0.0f) const;
+        // Returns the default value if the number is not a non-negative integer that fits.
+        uint32_t GetUint(uint32_t defaultValue = 0) const;
+        std::string_view GetString(std::string_view defaultValue = {}) const;
+
+        // Number of elements of an array or members of an object, 0 otherwise.
+        size_t GetSize() const;
+
+        // Element of an array. Returns a null value if it's out of range or not an array.
+        const JsonValue& operator[](size_t index) const;
+
+        // Member of an object. Returns null if it doesn't exist or it's not an object.
+        const JsonValue* Find(std::string_view key) const;
+
+        const std::vector<JsonValue>& GetElements() const { return m_elements; }
+        const std::vector<Member>& GetMembers() const { return m_members; }
+
+    private:
+        friend class JsonParser;
+
+        Type m_type = Type::Null;
+        bool m_bool = false;
+        double m_number = 0.0;
+        std::string m_string;
+        std::vector<JsonValue> m_elements;
+        std::vector<Member> m_members;
+    };
+
+    // Parses a JSON document. Returns an empty optional if the text is not valid JSON.
+    std::optional<JsonValue> ParseJson(std::string_view text);
+} // namespace DX
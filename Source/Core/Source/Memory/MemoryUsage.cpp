@@ -0,0 +1,64 @@
+#include <Memory/MemoryUsage.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+namespace DX
+{
+    size_t GetProcessResidentBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS memoryCounters = {};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+        {
+            return 0;
+        }
+        return memoryCounters.WorkingSetSize;
+#elif defined(__linux__)
+        // Second field of statm is the number of resident pages.
+        FILE* statmFile = std::fopen("/proc/self/statm", "r");
+        if (!statmFile)
+        {
+            return 0;
+        }
+        unsigned long totalPages = 0;
+        unsigned long residentPages = 0;
+        const int fieldsRead = std::fscanf(statmFile, "%lu %lu", &totalPages, &residentPages);
+        std::fclose(statmFile);
+        if (fieldsRead != 2)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    size_t GetProcessPeakResidentBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS memoryCounters = {};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+        {
+            return 0;
+        }
+        return memoryCounters.PeakWorkingSetSize;
+#elif defined(__linux__)
+        rusage usage = {};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(usage.ru_maxrss) * 1024; // In kilobytes
+#else
+        return 0;
+#endif
+    }
+} // namespace DX
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace DX
+{
+    // Physical memory used by the process (resident set size) in bytes.
+    // Returns 0 if it cannot be queried in the platform.
+    size_t GetProcessResidentBytes();
+
+    // Highest physical memory used by the process since it started in bytes.
+    // Returns 0 if it cannot be queried in the platform.
+    size_t GetProcessPeakResidentBytes();
+} // namespace DX
@@ -0,0 +1,152 @@
+#include <Thread/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace DX
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        }
+
+        m_threads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::Submit(Job job)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t index)>& func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (count == 1 || m_threads.empty())
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                func(i);
+            }
+            return;
+        }
+
+        // Shared with the helper jobs, which might start after
+        // all indices were processed and this function returned.
+        struct ParallelForState
+        {
+            std::atomic<uint32_t> m_nextIndex = 0;
+            std::atomic<uint32_t> m_completedCount = 0;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+
+            // First exception thrown by func, guarded by m_mutex.
+            // Once set, the indices left are skipped.
+            std::exception_ptr m_exception;
+            std::atomic<bool> m_failed = false;
+        };
+        auto state = std::make_shared<ParallelForState>();
+
+        // Indices are claimed one by one, so a job that starts late
+        // won't find any work left and won't access func at all.
+        auto processIndices = [state, count, &func]()
+        {
+            for (uint32_t index = state->m_nextIndex++; index < count; index = state->m_nextIndex++)
+            {
+                // An exception escaping a helper job would terminate the application, and one escaping
+                // the calling thread would return while helpers still use func. The index counts as
+                // completed anyway, the exception is rethrown once all indices are done.
+                if (!state->m_failed)
+                {
+                    try
+                    {
+                        func(index);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lock(state->m_mutex);
+                        if (!state->m_exception)
+                        {
+                            state->m_exception = std::current_exception();
+                        }
+                        state->m_failed = true;
+                    }
+                }
+
+                if (++state->m_completedCount == count)
+                {
+                    std::lock_guard lock(state->m_mutex);
+                    state->m_condition.notify_all();
+                }
+            }
+        };
+
+        const uint32_t helperJobCount = std::min(GetThreadCount(), count - 1);
+        for (uint32_t i = 0; i < helperJobCount; ++i)
+        {
+            Submit(processIndices);
+        }
+
+        processIndices();
+
+        std::unique_lock lock(state->m_mutex);
+        state->m_condition.wait(lock, [&state, count]() { return state->m_completedCount == count; });
+
+        if (state->m_exception)
+        {
+            std::rethrow_exception(state->m_exception);
+        }
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+                // Keep working until the queue is empty, even when stopping.
+                if (m_jobs.empty())
+                {
+                    return;
+                }
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop();
+            }
+
+            job();
+        }
+    }
+} // namespace DX
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace DX
+{
+    // Pool of worker threads that execute jobs in FIFO order.
+    //
+    // Jobs must not block waiting for other jobs submitted to the pool, as
+    // all workers could end up waiting. Use ParallelFor instead, which is
+    // safe to call from within a job.
+    class ThreadPool
+    {
+    public:
+        using Job = std::function<void()>;
+
+        // When thread count is 0 it uses one thread less than the
+        // hardware concurrency available, with a minimum of 1 thread.
+        explicit ThreadPool(uint32_t threadCount = 0);
+
+        // Finishes all the jobs in the queue before destroying the threads.
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+        // Adds a job to the queue. It'll be executed by the next worker available.
+        void Submit(Job job);
+
+        // Calls func(index) for each index in [0, count) distributing them between
+        // the workers and the calling thread. It returns when all calls are done.
+        // The calling thread participates, so it's safe to call it from a job.
+        // If func throws, the indices not started yet are skipped and the first
+        // exception is rethrown in the calling thread once all calls are done.
+        void ParallelFor(uint32_t count, const std::function<void(uint32_t index)>& func);
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::queue<Job> m_jobs;
+        bool m_stopping = false;
+    };
+} // namespace DX
@@ -1,10 +1,13 @@
 #include <Application.h>
 
 #include <Assets/AssetManager.h>
+#include <Assets/MeshAsset.h>
+#include <Assets/TextureAsset.h>
 #include <Window/WindowManager.h>
 #include <Renderer/RendererManager.h>
 #include <Renderer/Object.h>
 #include <Camera/Camera.h>
+#include <File/FileUtils.h>
 
 #include <Math/Transform.h>
 
@@ -16,8 +19,61 @@ namespace DX
 
     bool Application::Initialize(const Math::Vector2Int& windowSize, int refreshRate, bool fullScreen, bool vSync)
     {
+        // When the assets are shipped in a pack, mount it before any asset is loaded.
+        // Asset files are resolved against the pack first and then against the assets folder.
+        if (const auto assetPackPath = GetExecutablePath() / "Assets.pack";
+            std::filesystem::exists(assetPackPath))
+        {
+            MountAssetPack(assetPackPath);
+        }
+
         // Asset Manager initialization
-        AssetManager::Get();
+        // Meshes are only needed until uploaded to GPU. Textures are kept while within
+        // budget, their mips are streamed from the asset data while objects use them.
+        AssetManager::Get().SetResidencyPolicy(MeshAsset::AssetTypeId, AssetResidency::DropAfterUpload);
+        AssetManager::Get().SetResidencyPolicy(TextureAsset::AssetTypeId, AssetResidency::Cache);
+
+        // Assets requested in the last session are read from disk and loaded in the background
+        // right away, so their I/O and decoding overlap with the window and device creation.
+        AssetManager::Get().SetPrefetchLoader(MeshAsset::AssetTypeId, [](const std::string& fileName, uint32_t loadFlags)
+            {
+                MeshAsset::LoadMeshAssetAsync(fileName, MeshImportSettings::FromFlags(loadFlags));
+            });
+        AssetManager::Get().SetPrefetchLoader(TextureAsset::AssetTypeId, [](const std::string& fileName, uint32_t loadFlags)
+            {
+                TextureAsset::LoadTextureAssetAsync(fileName, TextureImportSettings::FromFlags(loadFlags));
+            });
+        AssetManager::Get().PrefetchManifest(GetAssetManifestPath());
+
+        // The helmet uses compact vertices, which are quantized to 16 bytes per vertex.
+        MeshImportSettings compactMeshSettings;
+        compactMeshSettings.m_compactVertices = true;
+
+        // Start loading all meshes and textures in parallel while the window and
+        // renderer are initialized. Render objects will wait for them when created.
+        MeshAsset::LoadMeshAssetAsync("Models/Jack/Jack.fbx");
+        MeshAsset::LoadMeshAssetAsync("Models/DamagedHelmet/DamagedHelmet.gltf", compactMeshSettings);
+        MeshAsset::LoadMeshAssetAsync("Models/Lantern/Lantern.gltf");
+        for (const char* textureFileName : {
+            "Textures/Wall_Stone_Albedo.png",
+            "Models/DamagedHelmet/Default_albedo.jpg",
+            "Models/DamagedHelmet/Default_emissive.jpg",
+            "Models/Lantern/Lantern_baseColor.png",
+            "Models/Lantern/Lantern_emissive.png" })
+        {
+            TextureAsset::LoadTextureAssetAsync(textureFileName);
+        }
+
+        // Normal maps must be loaded with the same settings used by render objects.
+        TextureImportSettings normalMapSettings;
+        normalMapSettings.m_normalMap = true;
+        for (const char* textureFileName : {
+            "Textures/Wall_Stone_Normal.png",
+            "Models/DamagedHelmet/Default_normal.jpg",
+            "Models/Lantern/Lantern_normal.png" })
+        {
+            TextureAsset::LoadTextureAssetAsync(textureFileName, normalMapSettings);
+        }
 
         // Window Manager initialization
         m_window = WindowManager::Get().CreateWindowWithTitle("Vulkan Course", windowSize, refreshRate, fullScreen, vSync);
@@ -54,7 +110,8 @@ namespace DX
             "Models/DamagedHelmet/DamagedHelmet.gltf",
             "Models/DamagedHelmet/Default_albedo.jpg",
             "Models/DamagedHelmet/Default_normal.jpg",
-            "Models/DamagedHelmet/Default_emissive.jpg"));
+            "Models/DamagedHelmet/Default_emissive.jpg",
+            compactMeshSettings));
         m_objects.push_back(std::make_unique<Mesh>(
             Math::Transform{ {-1.5f, 0.0f, 0.0f}, Math::Quaternion::identity, Math::Vector3(0.1f) },
             "Models/Lantern/Lantern.gltf",
@@ -64,6 +121,11 @@ namespace DX
 
         std::ranges::for_each(m_objects, [this](auto& object) { m_renderer->AddObject(object.get()); });
 
+        [[maybe_unused]] auto residencyStats = AssetManager::Get().GetResidencyStats();
+        DX_LOG(Info, "Application", "Assets resident in CPU memory: %u meshes (%.1f KB), %u textures (%.1f KB).",
+            residencyStats[MeshAsset::AssetTypeId].m_assetCount, residencyStats[MeshAsset::AssetTypeId].m_residentBytes / 1024.0f,
+            residencyStats[TextureAsset::AssetTypeId].m_assetCount, residencyStats[TextureAsset::AssetTypeId].m_residentBytes / 1024.0f);
+
         return true;
     }
 
@@ -114,9 +176,17 @@ namespace DX
         // Clear render objects before destroying renderer manager
         m_objects.clear();
 
+        // Record the assets requested in this session to prefetch them on the next startup.
+        AssetManager::Get().SaveManifest(GetAssetManifestPath());
+
+        // Cancel the queued asset loads and wait for the running ones before destroying the asset manager.
+        AssetManager::Get().Shutdown();
+
         // Destroy managers
         RendererManager::Destroy();
         WindowManager::Destroy();
         AssetManager::Destroy();
+
+        UnmountAssetPack();
     }
 }
@@ -270,25 +270,24 @@ namespace Vulkan
         vkCmdDrawIndexed(m_vkCommandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
     }
 
-    void CommandBuffer::CopyBuffer(Buffer* dstBuffer, Buffer* srcBuffer)
+    void CommandBuffer::CopyBufferRegion(Buffer* dstBuffer, uint64_t dstOffset, Buffer* srcBuffer, uint64_t srcOffset, uint64_t size)
     {
-        DX_ASSERT(srcBuffer->GetBufferDesc().m_elementSizeInBytes == dstBuffer->GetBufferDesc().m_elementSizeInBytes,
-            "Command Buffer", "Cannot copy buffers with different element size");
-        DX_ASSERT(srcBuffer->GetBufferDesc().m_elementCount <= dstBuffer->GetBufferDesc().m_elementCount,
-            "Command Buffer", "Trying to copy %d elements into a buffer with %d elements",
-            srcBuffer->GetBufferDesc().m_elementCount, dstBuffer->GetBufferDesc().m_elementCount);
+        DX_ASSERT(srcOffset + size <= static_cast<uint64_t>(srcBuffer->GetBufferDesc().m_elementSizeInBytes) * srcBuffer->GetBufferDesc().m_elementCount,
+            "Command Buffer", "Trying to copy outside of the source buffer");
+        DX_ASSERT(dstOffset + size <= static_cast<uint64_t>(dstBuffer->GetBufferDesc().m_elementSizeInBytes) * dstBuffer->GetBufferDesc().m_elementCount,
+            "Command Buffer", "Trying to copy outside of the destination buffer");
 
         // Region of data to copy from and to
         const VkBufferCopy vkBufferCopyRegion = {
-            .srcOffset = 0,
-            .dstOffset = 0,
-            .size = srcBuffer->GetBufferDesc().m_elementSizeInBytes * srcBuffer->GetBufferDesc().m_elementCount
+            .srcOffset = srcOffset,
+            .dstOffset = dstOffset,
+            .size = size
         };
 
         vkCmdCopyBuffer(m_vkCommandBuffer, srcBuffer->GetVkBuffer(), dstBuffer->GetVkBuffer(), 1, &vkBufferCopyRegion);
     }
 
-    void CommandBuffer::CopyBufferToImage(Image* dstImage, Buffer* srcBuffer)
+    void CommandBuffer::CopyBufferToImage(Image* dstImage, Buffer* srcBuffer, uint64_t srcOffset)
     {
         // Generate image regions (one per mip level) to copy
         std::vector<VkBufferImageCopy> vkBufferImageCopyRegions;
@@ -299,13 +298,13 @@ namespace Vulkan
 
             vkBufferImageCopyRegions.resize(imageMipCount);
 
-            uint32_t bufferOffset = 0;
+            uint64_t bufferOffset = srcOffset;
             for (uint32_t mipLevel = 0; mipLevel < imageMipCount; ++mipLevel)
             {
                 const uint32_t mipSizeX = std::max<uint32_t>(1, imageDimensions.x >> mipLevel);
                 const uint32_t mipSizeY = std::max<uint32_t>(1, imageDimensions.y >> mipLevel);
                 const uint32_t mipSizeZ = std::max<uint32_t>(1, imageDimensions.z >> mipLevel);
-                const uint32_t mipBytes = ResourceFormatSize(imageFormat, mipSizeX * mipSizeY * mipSizeZ);
+                const uint32_t mipBytes = ResourceFormatImageSize(imageFormat, mipSizeX, mipSizeY, mipSizeZ);
 
                 vkBufferImageCopyRegions[mipLevel] = VkBufferImageCopy{
                     .bufferOffset = bufferOffset,
@@ -324,9 +323,9 @@ namespace Vulkan
                 bufferOffset += mipBytes;
             }
 
-            DX_ASSERT(srcBuffer->GetBufferDesc().m_elementSizeInBytes * srcBuffer->GetBufferDesc().m_elementCount <= bufferOffset,
-                "Command Buffer", "Trying to copy %d bytes into a texture with %d bytes",
-                srcBuffer->GetBufferDesc().m_elementSizeInBytes * srcBuffer->GetBufferDesc().m_elementCount, bufferOffset);
+            DX_ASSERT(bufferOffset <= static_cast<uint64_t>(srcBuffer->GetBufferDesc().m_elementSizeInBytes) * srcBuffer->GetBufferDesc().m_elementCount,
+                "Command Buffer", "Trying to copy %llu bytes from a buffer with %u bytes",
+                static_cast<unsigned long long>(bufferOffset), srcBuffer->GetBufferDesc().m_elementSizeInBytes * srcBuffer->GetBufferDesc().m_elementCount);
         }
 
         // How is the image memory set to be read and written to.
@@ -395,6 +394,24 @@ namespace Vulkan
             1, &vkImageMemoryBarrier); // Image memory barriers
     }
 
+    void CommandBuffer::PipelineMemoryBarrier(
+        int srcPipelineStage, int srcAccessMask,
+        int dstPipelineStage, int dstAccessMask)
+    {
+        VkMemoryBarrier vkMemoryBarrier = {};
+        vkMemoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        vkMemoryBarrier.pNext = nullptr;
+        vkMemoryBarrier.srcAccessMask = srcAccessMask; // Memory operation (in src stage) indicating "after this point"
+        vkMemoryBarrier.dstAccessMask = dstAccessMask; // Memory operation (in dst stage) indicating "before this point"
+
+        vkCmdPipelineBarrier(m_vkCommandBuffer,
+            srcPipelineStage, dstPipelineStage,
+            0, // Dependency flags
+            1, &vkMemoryBarrier, // Global memory barriers
+            0, nullptr, // Buffer memory barriers
+            0, nullptr); // Image memory barriers
+    }
+
     bool CommandBuffer::AllocateVkCommandBuffer()
     {
         VkCommandBufferAllocateInfo vkCommandBufferAllocateInfo = {};
@@ -81,8 +81,10 @@ namespace Vulkan
 
         // -- Transfer commands --
 
-        void CopyBuffer(Buffer* dstBuffer, Buffer* srcBuffer);
-        void CopyBufferToImage(Image* dstImage, Buffer* srcBuffer);
+        void CopyBufferRegion(Buffer* dstBuffer, uint64_t dstOffset, Buffer* srcBuffer, uint64_t srcOffset, uint64_t size);
+
+        // Copies all the mips of the image, tightly packed in the buffer starting at srcOffset.
+        void CopyBufferToImage(Image* dstImage, Buffer* srcBuffer, uint64_t srcOffset = 0);
 
         // -- Barrier commands --
 
@@ -91,6 +93,11 @@ namespace Vulkan
             int srcPipelineStage, int srcAccessMask,
             int dstPipelineStage, int dstAccessMask);
 
+        // Barrier for all memory, not only the one of a resource.
+        void PipelineMemoryBarrier(
+            int srcPipelineStage, int srcAccessMask,
+            int dstPipelineStage, int dstAccessMask);
+
     private:
         Device* m_device = nullptr;
         VkCommandPool m_vkCommandPool = nullptr;
@@ -1,6 +1,8 @@
 #include <RHI/Device/Device.h>
 
 #include <RHI/Device/Instance.h>
+#include <RHI/Device/DeviceMemoryAllocator.h>
+#include <RHI/Device/StagingRing.h>
 #include <RHI/SwapChain/SwapChain.h>
 
 #include <Log/Log.h>
@@ -216,6 +218,18 @@ namespace Vulkan
             return false;
         }
 
+        if (!CreateMemoryAllocator())
+        {
+            Terminate();
+            return false;
+        }
+
+        if (!CreateStagingRing())
+        {
+            Terminate();
+            return false;
+        }
+
         return true;
     }
 
@@ -223,6 +237,10 @@ namespace Vulkan
     {
         DX_LOG(Info, "Vulkan Device", "Terminating Vulkan Device...");
 
+        // The staging ring waits for its uploads and frees its buffer before the allocator goes away.
+        m_stagingRing.reset();
+        m_memoryAllocator.reset();
+
         vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
         m_vkDescriptorPool = nullptr;
 
@@ -288,11 +306,26 @@ namespace Vulkan
         return m_vkDescriptorPool;
     }
 
+    DeviceMemoryAllocator* Device::GetMemoryAllocator()
+    {
+        return m_memoryAllocator.get();
+    }
+
+    StagingRing* Device::GetStagingRing()
+    {
+        return m_stagingRing.get();
+    }
+
     const QueueFamilyInfo& Device::GetQueueFamilyInfo() const
     {
         return m_queueFamilyInfo;
     }
 
+    bool Device::IsTextureCompressionBCSupported() const
+    {
+        return m_textureCompressionBCSupported;
+    }
+
     const VkPhysicalDeviceProperties* Device::GetVkPhysicalDeviceProperties() const
     {
         return m_vkPhysicalDeviceProperties.get();
@@ -388,9 +421,15 @@ namespace Vulkan
                 return vkDeviceGraphicsQueueCreateInfo;
             });
 
+        // Optional features supported by the physical device
+        VkPhysicalDeviceFeatures vkSupportedPhysicalDeviceFeatures;
+        vkGetPhysicalDeviceFeatures(m_vkPhysicalDevice, &vkSupportedPhysicalDeviceFeatures);
+        m_textureCompressionBCSupported = vkSupportedPhysicalDeviceFeatures.textureCompressionBC == VK_TRUE;
+
         // Physical device features that the logical device will be using
         VkPhysicalDeviceFeatures vkPhysicalDeviceFeatures = {};
         vkPhysicalDeviceFeatures.samplerAnisotropy = VK_TRUE; // Enable Anisotropy
+        vkPhysicalDeviceFeatures.textureCompressionBC = m_textureCompressionBCSupported ? VK_TRUE : VK_FALSE; // Enable BC formats when available
 
         VkDeviceCreateInfo vkDeviceCreateInfo = {};
         vkDeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -521,4 +560,28 @@ namespace Vulkan
 
         return true;
     }
+
+    bool Device::CreateMemoryAllocator()
+    {
+        m_memoryAllocator = std::make_unique<DeviceMemoryAllocator>(this);
+        if (!m_memoryAllocator->Initialize())
+        {
+            DX_LOG(Error, "Vulkan Device", "Failed to initialize device memory allocator.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Device::CreateStagingRing()
+    {
+        m_stagingRing = std::make_unique<StagingRing>(this);
+        if (!m_stagingRing->Initialize())
+        {
+            DX_LOG(Error, "Vulkan Device", "Failed to initialize staging ring.");
+            return false;
+        }
+
+        return true;
+    }
 } // namespace Vulkan
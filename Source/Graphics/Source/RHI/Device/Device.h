@@ -14,6 +14,8 @@ struct VkPhysicalDeviceProperties;
 namespace Vulkan
 {
     class Instance;
+    class DeviceMemoryAllocator;
+    class StagingRing;
 
     // MaxFrameDraws needs to be lower than number of images in swap chain,
     // that way it'll block until there are images available for drawing and
@@ -78,10 +80,19 @@ namespace Vulkan
         VkCommandPool GetVkCommandPool(QueueFamilyType queueFamilyType, int index);
         VkDescriptorPool GetVkDescriptorPool();
 
+        // Allocator of the device memory of buffers and images.
+        DeviceMemoryAllocator* GetMemoryAllocator();
+
+        // Ring of staging memory for uploading data to device local resources.
+        StagingRing* GetStagingRing();
+
         const VkPhysicalDeviceProperties* GetVkPhysicalDeviceProperties() const;
 
         const QueueFamilyInfo& GetQueueFamilyInfo() const;
 
+        // Whether images can use BC1-BC7 block compressed formats.
+        bool IsTextureCompressionBCSupported() const;
+
         // Resetting a command pool recycles all of the resources from all of the
         // command buffers allocated from the command pool back to the command pool.
         // In addition, all command buffers that have been allocated from the command
@@ -96,15 +107,21 @@ namespace Vulkan
         bool CreateVkDevice();
         bool CreateVkCommandPools();
         bool CreateVkDescriptorPool();
+        bool CreateMemoryAllocator();
+        bool CreateStagingRing();
 
         VkPhysicalDevice m_vkPhysicalDevice = nullptr;
         std::unique_ptr<VkPhysicalDeviceProperties> m_vkPhysicalDeviceProperties;
         QueueFamilyInfo m_queueFamilyInfo;
         VkDevice m_vkDevice = nullptr;
         std::array<VkQueue, QueueFamilyType_Count> m_vkQueues;
+        bool m_textureCompressionBCSupported = false;
 
         std::array<std::vector<VkCommandPool>, QueueFamilyType_Count> m_vkCommandPools;
 
         VkDescriptorPool m_vkDescriptorPool = nullptr;
+
+        std::unique_ptr<DeviceMemoryAllocator> m_memoryAllocator;
+        std::unique_ptr<StagingRing> m_stagingRing;
     };
 } // namespace Vulkan
@@ -0,0 +1,266 @@
+#include <RHI/Device/DeviceMemoryAllocator.h>
+
+#include <RHI/Device/Device.h>
+#include <RHI/Device/MemoryBlockAllocator.h>
+#include <RHI/Vulkan/Utils.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <vulkan/vulkan.h>
+
+#include <limits>
+
+namespace Vulkan
+{
+    namespace Utils
+    {
+        // Size of the blocks of device memory, smaller for small heaps.
+        static constexpr uint64_t DeviceMemoryBlockSize = 64ull * 1024 * 1024;
+        static constexpr uint64_t SmallHeapSize = 1024ull * 1024 * 1024;
+    } // namespace Utils
+
+    struct DeviceMemoryBlock
+    {
+        DeviceMemoryBlock(uint64_t size, uint32_t poolIndex)
+            : m_allocator(size)
+            , m_poolIndex(poolIndex)
+        {
+        }
+
+        MemoryBlockAllocator m_allocator;
+        uint32_t m_poolIndex = 0;
+
+        VkDeviceMemory m_vkDeviceMemory = nullptr;
+        void* m_mappedData = nullptr;
+    };
+
+    DeviceMemoryAllocator::DeviceMemoryAllocator(Device* device)
+        : m_device(device)
+    {
+    }
+
+    DeviceMemoryAllocator::~DeviceMemoryAllocator()
+    {
+        Terminate();
+    }
+
+    bool DeviceMemoryAllocator::Initialize()
+    {
+        if (m_vkMemoryProperties)
+        {
+            return true; // Already initialized
+        }
+
+        DX_LOG(Info, "Vulkan Memory", "Initializing Vulkan Memory Allocator...");
+
+        // Memory properties of the physical device don't change, query them only once.
+        m_vkMemoryProperties = std::make_unique<VkPhysicalDeviceMemoryProperties>();
+        vkGetPhysicalDeviceMemoryProperties(m_device->GetVkPhysicalDevice(), m_vkMemoryProperties.get());
+
+        m_bufferImageGranularity = m_device->GetVkPhysicalDeviceProperties()->limits.bufferImageGranularity;
+
+        m_pools.resize(m_vkMemoryProperties->memoryTypeCount * static_cast<uint32_t>(DeviceMemoryResourceType::Count));
+
+        DX_LOG(Verbose, "Vulkan Memory", "Memory types: %u Buffer image granularity: %llu",
+            m_vkMemoryProperties->memoryTypeCount, static_cast<unsigned long long>(m_bufferImageGranularity));
+
+        return true;
+    }
+
+    void DeviceMemoryAllocator::Terminate()
+    {
+        if (!m_vkMemoryProperties)
+        {
+            return;
+        }
+
+        DX_LOG(Info, "Vulkan Memory", "Terminating Vulkan Memory Allocator...");
+
+        for (MemoryPool& pool : m_pools)
+        {
+            for (auto& block : pool.m_blocks)
+            {
+                if (!block->m_allocator.IsEmpty())
+                {
+                    DX_LOG(Warning, "Vulkan Memory", "Device memory block terminated with %llu bytes still allocated.",
+                        static_cast<unsigned long long>(block->m_allocator.GetAllocatedSize()));
+                }
+                FreeVkDeviceMemory(block->m_vkDeviceMemory);
+            }
+        }
+        m_pools.clear();
+
+        if (m_vkDeviceMemoryCount > 0)
+        {
+            DX_LOG(Warning, "Vulkan Memory", "%u device memory allocations not freed.", m_vkDeviceMemoryCount);
+        }
+
+        m_vkMemoryProperties.reset();
+    }
+
+    uint32_t DeviceMemoryAllocator::FindMemoryTypeIndex(uint32_t allowedMemoryTypes, uint32_t vkMemoryPropertyFlags) const
+    {
+        return FindCompatibleMemoryTypeIndex(*m_vkMemoryProperties, allowedMemoryTypes, vkMemoryPropertyFlags);
+    }
+
+    bool DeviceMemoryAllocator::Allocate(const VkMemoryRequirements& vkMemoryRequirements, uint32_t vkMemoryPropertyFlags,
+        DeviceMemoryResourceType resourceType, DeviceMemoryAllocation& allocationOut)
+    {
+        const uint32_t memoryTypeIndex = FindMemoryTypeIndex(vkMemoryRequirements.memoryTypeBits, vkMemoryPropertyFlags);
+        if (memoryTypeIndex == std::numeric_limits<uint32_t>::max())
+        {
+            DX_LOG(Error, "Vulkan Memory", "No memory type compatible with the resource.");
+            return false;
+        }
+
+        const uint64_t blockSize = GetBlockSize(memoryTypeIndex);
+
+        std::lock_guard lock(m_mutex);
+
+        allocationOut = DeviceMemoryAllocation();
+
+        // Big resources get their own device memory.
+        if (vkMemoryRequirements.size > blockSize / 2)
+        {
+            allocationOut.m_vkDeviceMemory = AllocateVkDeviceMemory(vkMemoryRequirements.size, memoryTypeIndex, &allocationOut.m_mappedData);
+            allocationOut.m_size = vkMemoryRequirements.size;
+            return allocationOut.IsValid();
+        }
+
+        MemoryPool& pool = m_pools[GetPoolIndex(memoryTypeIndex, resourceType)];
+
+        DeviceMemoryBlock* block = nullptr;
+        uint32_t rangeIndex = MemoryBlockAllocator::InvalidRange;
+        for (auto& poolBlock : pool.m_blocks)
+        {
+            rangeIndex = poolBlock->m_allocator.Allocate(vkMemoryRequirements.size, vkMemoryRequirements.alignment);
+            if (rangeIndex != MemoryBlockAllocator::InvalidRange)
+            {
+                block = poolBlock.get();
+                break;
+            }
+        }
+
+        // All blocks are full, add a new one.
+        if (!block)
+        {
+            auto newBlock = std::make_unique<DeviceMemoryBlock>(blockSize, GetPoolIndex(memoryTypeIndex, resourceType));
+            newBlock->m_vkDeviceMemory = AllocateVkDeviceMemory(blockSize, memoryTypeIndex, &newBlock->m_mappedData);
+            if (!newBlock->m_vkDeviceMemory)
+            {
+                return false;
+            }
+
+            DX_LOG(Verbose, "Vulkan Memory", "Device memory block of %llu MB created for memory type %u (%u device allocations).",
+                static_cast<unsigned long long>(blockSize / (1024 * 1024)), memoryTypeIndex, m_vkDeviceMemoryCount);
+
+            rangeIndex = newBlock->m_allocator.Allocate(vkMemoryRequirements.size, vkMemoryRequirements.alignment);
+            DX_ASSERT(rangeIndex != MemoryBlockAllocator::InvalidRange, "Vulkan Memory", "Allocation doesn't fit in an empty block.");
+
+            block = newBlock.get();
+            pool.m_blocks.push_back(std::move(newBlock));
+        }
+
+        const uint64_t offset = block->m_allocator.GetOffset(rangeIndex);
+
+        allocationOut.m_vkDeviceMemory = block->m_vkDeviceMemory;
+        allocationOut.m_offset = offset;
+        allocationOut.m_size = vkMemoryRequirements.size;
+        allocationOut.m_mappedData = block->m_mappedData ? static_cast<uint8_t*>(block->m_mappedData) + offset : nullptr;
+        allocationOut.m_block = block;
+        allocationOut.m_rangeIndex = rangeIndex;
+
+        return true;
+    }
+
+    void DeviceMemoryAllocator::Free(DeviceMemoryAllocation& allocation)
+    {
+        if (!allocation.IsValid())
+        {
+            return;
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        if (DeviceMemoryBlock* block = allocation.m_block)
+        {
+            block->m_allocator.Free(allocation.m_rangeIndex);
+
+            // Release empty blocks, but keep the last one of the pool to avoid
+            // allocating device memory again and again when resources are recreated.
+            MemoryPool& pool = m_pools[block->m_poolIndex];
+            if (block->m_allocator.IsEmpty() && pool.m_blocks.size() > 1)
+            {
+                FreeVkDeviceMemory(block->m_vkDeviceMemory);
+
+                std::erase_if(pool.m_blocks, [block](const auto& poolBlock)
+                    {
+                        return poolBlock.get() == block;
+                    });
+            }
+        }
+        else
+        {
+            FreeVkDeviceMemory(allocation.m_vkDeviceMemory);
+        }
+
+        allocation = DeviceMemoryAllocation();
+    }
+
+    uint32_t DeviceMemoryAllocator::GetPoolIndex(uint32_t memoryTypeIndex, DeviceMemoryResourceType resourceType) const
+    {
+        // Without granularity restrictions all resources share the same blocks.
+        const uint32_t resourceTypeIndex = (m_bufferImageGranularity > 1) ? static_cast<uint32_t>(resourceType) : 0;
+
+        return memoryTypeIndex * static_cast<uint32_t>(DeviceMemoryResourceType::Count) + resourceTypeIndex;
+    }
+
+    uint64_t DeviceMemoryAllocator::GetBlockSize(uint32_t memoryTypeIndex) const
+    {
+        const uint32_t heapIndex = m_vkMemoryProperties->memoryTypes[memoryTypeIndex].heapIndex;
+        const uint64_t heapSize = m_vkMemoryProperties->memoryHeaps[heapIndex].size;
+
+        return (heapSize <= Utils::SmallHeapSize) ? heapSize / 8 : Utils::DeviceMemoryBlockSize;
+    }
+
+    VkDeviceMemory DeviceMemoryAllocator::AllocateVkDeviceMemory(uint64_t size, uint32_t memoryTypeIndex, void** mappedDataOut)
+    {
+        VkMemoryAllocateInfo vkMemoryAllocateInfo = {};
+        vkMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        vkMemoryAllocateInfo.pNext = nullptr;
+        vkMemoryAllocateInfo.allocationSize = size;
+        vkMemoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+        VkDeviceMemory vkDeviceMemory = nullptr;
+        if (vkAllocateMemory(m_device->GetVkDevice(), &vkMemoryAllocateInfo, nullptr, &vkDeviceMemory) != VK_SUCCESS)
+        {
+            DX_LOG(Error, "Vulkan Memory", "Failed to allocate %llu bytes of device memory.", static_cast<unsigned long long>(size));
+            return nullptr;
+        }
+        ++m_vkDeviceMemoryCount;
+
+        // Device memory can only be mapped once at a time, so host visible memory
+        // is mapped whole for its entire life and shared by all its resources.
+        *mappedDataOut = nullptr;
+        if (m_vkMemoryProperties->memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            if (vkMapMemory(m_device->GetVkDevice(), vkDeviceMemory, 0, VK_WHOLE_SIZE, 0, mappedDataOut) != VK_SUCCESS)
+            {
+                DX_LOG(Error, "Vulkan Memory", "Failed to map device memory.");
+                FreeVkDeviceMemory(vkDeviceMemory);
+                *mappedDataOut = nullptr;
+                return nullptr;
+            }
+        }
+
+        return vkDeviceMemory;
+    }
+
+    void DeviceMemoryAllocator::FreeVkDeviceMemory(VkDeviceMemory vkDeviceMemory)
+    {
+        // Freeing device memory unmaps it as well.
+        vkFreeMemory(m_device->GetVkDevice(), vkDeviceMemory, nullptr);
+        --m_vkDeviceMemoryCount;
+    }
+} // namespace Vulkan
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+typedef struct VkDeviceMemory_T* VkDeviceMemory;
+struct VkMemoryRequirements;
+struct VkPhysicalDeviceMemoryProperties;
+
+namespace Vulkan
+{
+    class Device;
+    struct DeviceMemoryBlock;
+
+    // Linear resources (buffers and images with linear tiling) and optimal resources
+    // (images with optimal tiling) can't share a page of bufferImageGranularity bytes.
+    // They are placed in different blocks when the device has such restriction.
+    enum class DeviceMemoryResourceType
+    {
+        Linear = 0,
+        Optimal,
+
+        Count
+    };
+
+    // Range of device memory assigned to a resource.
+    struct DeviceMemoryAllocation
+    {
+        VkDeviceMemory m_vkDeviceMemory = nullptr;
+        uint64_t m_offset = 0;
+        uint64_t m_size = 0;
+
+        // Memory mapped at m_offset when it's host visible, null otherwise.
+        void* m_mappedData = nullptr;
+
+        // Block the range belongs to, null when the resource has its own device memory.
+        DeviceMemoryBlock* m_block = nullptr;
+        uint32_t m_rangeIndex = 0;
+
+        bool IsValid() const { return m_vkDeviceMemory != nullptr; }
+    };
+
+    // Allocates device memory in large blocks per memory type and sub-allocates
+    // resources from them, instead of allocating device memory per resource.
+    // Resources bigger than half a block get their own device memory.
+    // Host visible blocks are persistently mapped.
+    //
+    // Allocate and Free are thread safe, resources can be created and destroyed
+    // from any thread. Initialize and Terminate are not.
+    class DeviceMemoryAllocator
+    {
+    public:
+        DeviceMemoryAllocator(Device* device);
+        ~DeviceMemoryAllocator();
+
+        DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+        DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+
+        bool Initialize();
+        void Terminate();
+
+        // Finds the index of the memory type which is in the allowed list and has
+        // all the properties passed by argument, using the cached memory properties.
+        uint32_t FindMemoryTypeIndex(uint32_t allowedMemoryTypes, uint32_t vkMemoryPropertyFlags) const;
+
+        bool Allocate(const VkMemoryRequirements& vkMemoryRequirements, uint32_t vkMemoryPropertyFlags,
+            DeviceMemoryResourceType resourceType, DeviceMemoryAllocation& allocationOut);
+
+        // Frees the allocation and resets it. Does nothing with an invalid allocation.
+        void Free(DeviceMemoryAllocation& allocation);
+
+    private:
+        Device* m_device = nullptr;
+
+    private:
+        // Blocks of a memory type and resource type.
+        struct MemoryPool
+        {
+            std::vector<std::unique_ptr<DeviceMemoryBlock>> m_blocks;
+        };
+
+        uint32_t GetPoolIndex(uint32_t memoryTypeIndex, DeviceMemoryResourceType resourceType) const;
+        uint64_t GetBlockSize(uint32_t memoryTypeIndex) const;
+
+        VkDeviceMemory AllocateVkDeviceMemory(uint64_t size, uint32_t memoryTypeIndex, void** mappedDataOut);
+        void FreeVkDeviceMemory(VkDeviceMemory vkDeviceMemory);
+
+        std::unique_ptr<VkPhysicalDeviceMemoryProperties> m_vkMemoryProperties;
+        uint64_t m_bufferImageGranularity = 1;
+
+        // Guards the pools and the device memory count.
+        std::mutex m_mutex;
+
+        std::vector<MemoryPool> m_pools;
+
+        // Number of device memory allocations alive, limited by maxMemoryAllocationCount.
+        uint32_t m_vkDeviceMemoryCount = 0;
+    };
+} // namespace Vulkan
@@ -0,0 +1,269 @@
+#include <RHI/Device/MemoryBlockAllocator.h>
+
+#include <Debug/Debug.h>
+
+#include <bit>
+
+namespace Vulkan
+{
+    namespace Utils
+    {
+        // Free space left after an allocation smaller than this stays part of the allocation,
+        // instead of becoming a free range too small to be useful.
+        static constexpr uint64_t MinFreeRangeSize = 256;
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    } // namespace Utils
+
+    MemoryBlockAllocator::MemoryBlockAllocator(uint64_t size)
+        : m_size(size)
+    {
+        m_secondLevelMasks.fill(0);
+        for (auto& freeLists : m_freeLists)
+        {
+            freeLists.fill(InvalidRange);
+        }
+
+        // The whole block starts as a single free range.
+        const uint32_t rangeIndex = CreateRange();
+        m_ranges[rangeIndex].m_offset = 0;
+        m_ranges[rangeIndex].m_size = size;
+        InsertFreeRange(rangeIndex);
+    }
+
+    uint32_t MemoryBlockAllocator::Allocate(uint64_t size, uint64_t alignment)
+    {
+        DX_ASSERT(size > 0, "MemoryBlockAllocator", "Allocation of size 0.");
+        DX_ASSERT(std::has_single_bit(alignment), "MemoryBlockAllocator",
+            "Alignment %llu is not a power of two.", static_cast<unsigned long long>(alignment));
+
+        // The first free range of the list found is big enough, but it might not be
+        // once aligned. In that case look for one big enough for any alignment.
+        uint32_t rangeIndex = FindFreeRange(size);
+        if (rangeIndex != InvalidRange)
+        {
+            const Range& range = m_ranges[rangeIndex];
+            if (Utils::AlignUp(range.m_offset, alignment) + size > range.m_offset + range.m_size)
+            {
+                rangeIndex = FindFreeRange(size + alignment - 1);
+            }
+        }
+        if (rangeIndex == InvalidRange)
+        {
+            return InvalidRange;
+        }
+
+        RemoveFreeRange(rangeIndex);
+
+        // The padding needed for alignment goes to the previous range, which is in use
+        // because free ranges are always merged with their free neighbors.
+        // It's given back when that range is freed.
+        const uint64_t padding = Utils::AlignUp(m_ranges[rangeIndex].m_offset, alignment) - m_ranges[rangeIndex].m_offset;
+        if (padding > 0)
+        {
+            Range& previousRange = m_ranges[m_ranges[rangeIndex].m_previousPhysical];
+            previousRange.m_size += padding;
+            m_allocatedSize += padding;
+
+            m_ranges[rangeIndex].m_offset += padding;
+            m_ranges[rangeIndex].m_size -= padding;
+        }
+
+        // Split the space left into a new free range.
+        if (m_ranges[rangeIndex].m_size - size >= Utils::MinFreeRangeSize)
+        {
+            const uint32_t remainderIndex = CreateRange(); // Invalidates references to m_ranges
+
+            Range& range = m_ranges[rangeIndex];
+            Range& remainder = m_ranges[remainderIndex];
+            remainder.m_offset = range.m_offset + size;
+            remainder.m_size = range.m_size - size;
+            remainder.m_previousPhysical = rangeIndex;
+            remainder.m_nextPhysical = range.m_nextPhysical;
+            if (range.m_nextPhysical != InvalidRange)
+            {
+                m_ranges[range.m_nextPhysical].m_previousPhysical = remainderIndex;
+            }
+            range.m_nextPhysical = remainderIndex;
+            range.m_size = size;
+
+            InsertFreeRange(remainderIndex);
+        }
+
+        m_allocatedSize += m_ranges[rangeIndex].m_size;
+
+        return rangeIndex;
+    }
+
+    void MemoryBlockAllocator::Free(uint32_t rangeIndex)
+    {
+        DX_ASSERT(rangeIndex < m_ranges.size() && !m_ranges[rangeIndex].m_free,
+            "MemoryBlockAllocator", "Freeing an invalid range.");
+
+        m_allocatedSize -= m_ranges[rangeIndex].m_size;
+
+        // Merge with the previous range if it's free
+        if (const uint32_t previousIndex = m_ranges[rangeIndex].m_previousPhysical;
+            previousIndex != InvalidRange && m_ranges[previousIndex].m_free)
+        {
+            RemoveFreeRange(previousIndex);
+
+            Range& previousRange = m_ranges[previousIndex];
+            previousRange.m_size += m_ranges[rangeIndex].m_size;
+            previousRange.m_nextPhysical = m_ranges[rangeIndex].m_nextPhysical;
+            if (previousRange.m_nextPhysical != InvalidRange)
+            {
+                m_ranges[previousRange.m_nextPhysical].m_previousPhysical = previousIndex;
+            }
+
+            DestroyRange(rangeIndex);
+            rangeIndex = previousIndex;
+        }
+
+        // Merge with the next range if it's free
+        if (const uint32_t nextIndex = m_ranges[rangeIndex].m_nextPhysical;
+            nextIndex != InvalidRange && m_ranges[nextIndex].m_free)
+        {
+            RemoveFreeRange(nextIndex);
+
+            Range& range = m_ranges[rangeIndex];
+            range.m_size += m_ranges[nextIndex].m_size;
+            range.m_nextPhysical = m_ranges[nextIndex].m_nextPhysical;
+            if (range.m_nextPhysical != InvalidRange)
+            {
+                m_ranges[range.m_nextPhysical].m_previousPhysical = rangeIndex;
+            }
+
+            DestroyRange(nextIndex);
+        }
+
+        InsertFreeRange(rangeIndex);
+    }
+
+    void MemoryBlockAllocator::MapSize(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+    {
+        if (size < (1ull << SmallSizeBits))
+        {
+            firstLevel = 0;
+            secondLevel = static_cast<uint32_t>(size >> (SmallSizeBits - SecondLevelBits));
+        }
+        else
+        {
+            const uint32_t mostSignificantBit = static_cast<uint32_t>(std::bit_width(size)) - 1;
+            firstLevel = mostSignificantBit - SmallSizeBits + 1;
+            secondLevel = static_cast<uint32_t>(size >> (mostSignificantBit - SecondLevelBits)) & (SecondLevelCount - 1);
+        }
+    }
+
+    uint32_t MemoryBlockAllocator::FindFreeRange(uint64_t size) const
+    {
+        // Round up to the next list, so any range in the list found is big enough.
+        if (size < (1ull << SmallSizeBits))
+        {
+            size += (1ull << (SmallSizeBits - SecondLevelBits)) - 1;
+        }
+        else
+        {
+            const uint32_t mostSignificantBit = static_cast<uint32_t>(std::bit_width(size)) - 1;
+            size += (1ull << (mostSignificantBit - SecondLevelBits)) - 1;
+        }
+
+        uint32_t firstLevel = 0;
+        uint32_t secondLevel = 0;
+        MapSize(size, firstLevel, secondLevel);
+
+        // First non-empty list in the same first level, or else in the next first levels.
+        uint32_t secondLevelMask = m_secondLevelMasks[firstLevel] & (~0u << secondLevel);
+        if (secondLevelMask == 0)
+        {
+            const uint64_t firstLevelMask = m_firstLevelMask & (~0ull << (firstLevel + 1));
+            if (firstLevelMask == 0)
+            {
+                return InvalidRange;
+            }
+
+            firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMask));
+            secondLevelMask = m_secondLevelMasks[firstLevel];
+        }
+        secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMask));
+
+        return m_freeLists[firstLevel][secondLevel];
+    }
+
+    void MemoryBlockAllocator::InsertFreeRange(uint32_t rangeIndex)
+    {
+        uint32_t firstLevel = 0;
+        uint32_t secondLevel = 0;
+        MapSize(m_ranges[rangeIndex].m_size, firstLevel, secondLevel);
+
+        Range& range = m_ranges[rangeIndex];
+        range.m_free = true;
+        range.m_previousFree = InvalidRange;
+        range.m_nextFree = m_freeLists[firstLevel][secondLevel];
+        if (range.m_nextFree != InvalidRange)
+        {
+            m_ranges[range.m_nextFree].m_previousFree = rangeIndex;
+        }
+
+        m_freeLists[firstLevel][secondLevel] = rangeIndex;
+        m_firstLevelMask |= 1ull << firstLevel;
+        m_secondLevelMasks[firstLevel] |= 1u << secondLevel;
+    }
+
+    void MemoryBlockAllocator::RemoveFreeRange(uint32_t rangeIndex)
+    {
+        uint32_t firstLevel = 0;
+        uint32_t secondLevel = 0;
+        MapSize(m_ranges[rangeIndex].m_size, firstLevel, secondLevel);
+
+        Range& range = m_ranges[rangeIndex];
+        if (range.m_previousFree != InvalidRange)
+        {
+            m_ranges[range.m_previousFree].m_nextFree = range.m_nextFree;
+        }
+        else
+        {
+            m_freeLists[firstLevel][secondLevel] = range.m_nextFree;
+        }
+        if (range.m_nextFree != InvalidRange)
+        {
+            m_ranges[range.m_nextFree].m_previousFree = range.m_previousFree;
+        }
+
+        if (m_freeLists[firstLevel][secondLevel] == InvalidRange)
+        {
+            m_secondLevelMasks[firstLevel] &= ~(1u << secondLevel);
+            if (m_secondLevelMasks[firstLevel] == 0)
+            {
+                m_firstLevelMask &= ~(1ull << firstLevel);
+            }
+        }
+
+        range.m_free = false;
+        range.m_previousFree = InvalidRange;
+        range.m_nextFree = InvalidRange;
+    }
+
+    uint32_t MemoryBlockAllocator::CreateRange()
+    {
+        if (m_unusedRanges.empty())
+        {
+            m_ranges.emplace_back();
+            return static_cast<uint32_t>(m_ranges.size() - 1);
+        }
+
+        const uint32_t rangeIndex = m_unusedRanges.back();
+        m_unusedRanges.pop_back();
+        m_ranges[rangeIndex] = Range();
+        return rangeIndex;
+    }
+
+    void MemoryBlockAllocator::DestroyRange(uint32_t rangeIndex)
+    {
+        m_ranges[rangeIndex] = Range();
+        m_unusedRanges.push_back(rangeIndex);
+    }
+} // namespace Vulkan
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+namespace Vulkan
+{
+    // Sub-allocates ranges of a block of memory of a fixed size using TLSF
+    // (Two-Level Segregated Fit). Free ranges are kept in lists segregated by size,
+    // found with two levels of bitmasks, so allocating and freeing are constant time.
+    // Adjacent free ranges are merged when freed.
+    // It only deals with offsets, it doesn't own any memory.
+    class MemoryBlockAllocator
+    {
+    public:
+        static constexpr uint32_t InvalidRange = std::numeric_limits<uint32_t>::max();
+
+        explicit MemoryBlockAllocator(uint64_t size);
+
+        MemoryBlockAllocator(const MemoryBlockAllocator&) = delete;
+        MemoryBlockAllocator& operator=(const MemoryBlockAllocator&) = delete;
+
+        // Allocates a range of size bytes with its offset aligned to alignment,
+        // which must be a power of two. Returns InvalidRange if there is no space.
+        uint32_t Allocate(uint64_t size, uint64_t alignment);
+
+        // Frees a range returned by Allocate.
+        void Free(uint32_t rangeIndex);
+
+        uint64_t GetOffset(uint32_t rangeIndex) const { return m_ranges[rangeIndex].m_offset; }
+
+        uint64_t GetSize() const { return m_size; }
+        uint64_t GetAllocatedSize() const { return m_allocatedSize; }
+        bool IsEmpty() const { return m_allocatedSize == 0; }
+
+    private:
+        // Each second level splits the first level size range in 16 lists.
+        static constexpr uint32_t SecondLevelBits = 4;
+        static constexpr uint32_t SecondLevelCount = 1 << SecondLevelBits;
+
+        // Sizes below this are all in the first level 0, split linearly.
+        static constexpr uint32_t SmallSizeBits = 8;
+
+        static constexpr uint32_t FirstLevelCount = 64 - SmallSizeBits + 1;
+
+        struct Range
+        {
+            uint64_t m_offset = 0;
+            uint64_t m_size = 0;
+
+            // Neighbor ranges in the block
+            uint32_t m_previousPhysical = InvalidRange;
+            uint32_t m_nextPhysical = InvalidRange;
+
+            // Neighbor ranges in the free list, for free ranges
+            uint32_t m_previousFree = InvalidRange;
+            uint32_t m_nextFree = InvalidRange;
+
+            bool m_free = false;
+        };
+
+        static void MapSize(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+        uint32_t FindFreeRange(uint64_t size) const;
+        void InsertFreeRange(uint32_t rangeIndex);
+        void RemoveFreeRange(uint32_t rangeIndex);
+
+        uint32_t CreateRange();
+        void DestroyRange(uint32_t rangeIndex);
+
+        uint64_t m_size = 0;
+        uint64_t m_allocatedSize = 0;
+
+        // Ranges are referenced by index, unused slots are reused.
+        std::vector<Range> m_ranges;
+        std::vector<uint32_t> m_unusedRanges;
+
+        uint64_t m_firstLevelMask = 0;
+        std::array<uint32_t, FirstLevelCount> m_secondLevelMasks;
+        std::array<std::array<uint32_t, SecondLevelCount>, FirstLevelCount> m_freeLists;
+    };
+} // namespace Vulkan
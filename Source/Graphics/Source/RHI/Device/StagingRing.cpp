@@ -0,0 +1,251 @@
+#include <RHI/Device/StagingRing.h>
+
+#include <RHI/Device/Device.h>
+#include <RHI/CommandBuffer/CommandBuffer.h>
+#include <RHI/Resource/Buffer/Buffer.h>
+
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <vulkan/vulkan.h>
+
+#include <limits>
+
+namespace Vulkan
+{
+    namespace Utils
+    {
+        // Uploads bigger than the ring use their own staging buffer.
+        static constexpr uint32_t StagingRingSize = 64 * 1024 * 1024;
+    } // namespace Utils
+
+    StagingRing::StagingRing(Device* device)
+        : m_device(device)
+    {
+    }
+
+    StagingRing::~StagingRing()
+    {
+        Terminate();
+    }
+
+    bool StagingRing::Initialize()
+    {
+        if (m_buffer)
+        {
+            return true; // Already initialized
+        }
+
+        DX_LOG(Info, "Vulkan StagingRing", "Initializing Vulkan Staging Ring...");
+
+        BufferDesc bufferDesc = {};
+        bufferDesc.m_elementSizeInBytes = Utils::StagingRingSize;
+        bufferDesc.m_elementCount = 1;
+        bufferDesc.m_usageFlags = BufferUsage_TransferSrc;
+        bufferDesc.m_memoryProperty = ResourceMemoryProperty::HostVisible;
+        bufferDesc.m_persistentlyMapped = true;
+
+        m_buffer = std::make_unique<Buffer>(m_device, bufferDesc);
+        if (!m_buffer->Initialize())
+        {
+            DX_LOG(Error, "Vulkan StagingRing", "Failed to create staging ring buffer.");
+            Terminate();
+            return false;
+        }
+
+        m_size = Utils::StagingRingSize;
+        m_head = 0;
+        m_tail = 0;
+
+        return true;
+    }
+
+    void StagingRing::Terminate()
+    {
+        DX_LOG(Info, "Vulkan StagingRing", "Terminating Vulkan Staging Ring...");
+
+        WaitUntilIdle();
+
+        for (VkFence vkFence : m_freeFences)
+        {
+            vkDestroyFence(m_device->GetVkDevice(), vkFence, nullptr);
+        }
+        m_freeFences.clear();
+
+        m_buffer.reset();
+        m_size = 0;
+    }
+
+    std::optional<StagingRegion> StagingRing::Allocate(uint64_t size, uint64_t alignment)
+    {
+        if (!m_buffer || size > m_size)
+        {
+            return std::nullopt;
+        }
+
+        RetireSubmissions(false);
+
+        // Start from the beginning when there is nothing in use,
+        // so an upload as big as the ring fits.
+        if (m_submissions.empty() && m_head == m_tail)
+        {
+            m_head = 0;
+            m_tail = 0;
+        }
+
+        while (true)
+        {
+            // Regions are contiguous, when it doesn't fit until the end
+            // of the buffer it skips to the beginning.
+            const uint64_t offset = m_head % m_size;
+            uint64_t padding = ((offset + alignment - 1) & ~(alignment - 1)) - offset;
+            if (offset + padding + size > m_size)
+            {
+                padding = m_size - offset;
+            }
+
+            if (m_head + padding + size - m_tail <= m_size)
+            {
+                const uint64_t regionOffset = (m_head + padding) % m_size;
+                m_head += padding + size;
+
+                return StagingRegion{
+                    .m_offset = regionOffset,
+                    .m_mappedData = static_cast<uint8_t*>(m_buffer->GetMappedData()) + regionOffset
+                };
+            }
+
+            // The space is used by regions not submitted yet.
+            if (m_submissions.empty())
+            {
+                return std::nullopt;
+            }
+
+            RetireSubmissions(true);
+        }
+    }
+
+    std::unique_ptr<CommandBuffer> StagingRing::BeginUpload()
+    {
+        // By Vulkan standards, graphical queues also support transfer commands.
+        auto commandBuffer = std::make_unique<CommandBuffer>(m_device,
+            m_device->GetVkCommandPool(QueueFamilyType_Graphics, ResourceTransferCommandPoolIndex));
+        if (!commandBuffer->Initialize() ||
+            !commandBuffer->Begin(CommandBufferUsage_OneTimeSubmit))
+        {
+            DX_LOG(Error, "Vulkan StagingRing", "Failed to begin upload command buffer.");
+            return nullptr;
+        }
+
+        return commandBuffer;
+    }
+
+    bool StagingRing::SubmitUpload(std::unique_ptr<CommandBuffer> commandBuffer, bool waitUntilFinished)
+    {
+        commandBuffer->End();
+
+        VkFence vkFence = AcquireFence();
+        if (!vkFence)
+        {
+            return false;
+        }
+
+        VkCommandBuffer vkCommandBuffer = commandBuffer->GetVkCommandBuffer();
+
+        VkSubmitInfo vkSubmitInfo = {};
+        vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        vkSubmitInfo.pNext = nullptr;
+        vkSubmitInfo.pWaitDstStageMask = nullptr;
+        vkSubmitInfo.waitSemaphoreCount = 0;
+        vkSubmitInfo.pWaitSemaphores = nullptr;
+        vkSubmitInfo.commandBufferCount = 1;
+        vkSubmitInfo.pCommandBuffers = &vkCommandBuffer;
+        vkSubmitInfo.signalSemaphoreCount = 0;
+        vkSubmitInfo.pSignalSemaphores = nullptr;
+
+        // Submit command buffer to queue for execution by the GPU,
+        // the fence signals when it has finished.
+        if (vkQueueSubmit(m_device->GetVkQueue(QueueFamilyType_Graphics), 1, &vkSubmitInfo, vkFence) != VK_SUCCESS)
+        {
+            DX_LOG(Error, "Vulkan StagingRing", "Failed to submit transfer work to the queue.");
+            m_freeFences.push_back(vkFence);
+            return false;
+        }
+
+        // The command buffer can't be destroyed until the GPU has executed it.
+        m_submissions.push_back({ vkFence, std::move(commandBuffer), m_head, ++m_submittedUploadCount });
+
+        // Unlike vkQueueWaitIdle, it only waits for this upload and not for the frames being rendered.
+        if (waitUntilFinished)
+        {
+            vkWaitForFences(m_device->GetVkDevice(), 1, &vkFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+            RetireSubmissions(false);
+        }
+
+        return true;
+    }
+
+    bool StagingRing::IsUploadFinished(uint64_t upload)
+    {
+        RetireSubmissions(false);
+        return upload <= m_finishedUploadCount;
+    }
+
+    void StagingRing::WaitUntilIdle()
+    {
+        while (!m_submissions.empty())
+        {
+            RetireSubmissions(true);
+        }
+    }
+
+    void StagingRing::RetireSubmissions(bool waitOldest)
+    {
+        while (!m_submissions.empty())
+        {
+            Submission& submission = m_submissions.front();
+
+            if (waitOldest)
+            {
+                vkWaitForFences(m_device->GetVkDevice(), 1, &submission.m_vkFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+                waitOldest = false;
+            }
+            else if (vkGetFenceStatus(m_device->GetVkDevice(), submission.m_vkFence) != VK_SUCCESS)
+            {
+                break; // Submissions finish in order, the next ones are not finished either.
+            }
+
+            m_tail = submission.m_end;
+            m_finishedUploadCount = submission.m_upload;
+
+            vkResetFences(m_device->GetVkDevice(), 1, &submission.m_vkFence);
+            m_freeFences.push_back(submission.m_vkFence);
+
+            m_submissions.pop_front();
+        }
+    }
+
+    VkFence StagingRing::AcquireFence()
+    {
+        if (!m_freeFences.empty())
+        {
+            VkFence vkFence = m_freeFences.back();
+            m_freeFences.pop_back();
+            return vkFence;
+        }
+
+        VkFenceCreateInfo vkFenceCreateInfo = {};
+        vkFenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        vkFenceCreateInfo.pNext = nullptr;
+        vkFenceCreateInfo.flags = 0;
+
+        VkFence vkFence = nullptr;
+        if (vkCreateFence(m_device->GetVkDevice(), &vkFenceCreateInfo, nullptr, &vkFence) != VK_SUCCESS)
+        {
+            DX_LOG(Error, "Vulkan StagingRing", "Failed to create Vulkan fence.");
+            return nullptr;
+        }
+
+        return vkFence;
+    }
+} // namespace Vulkan
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cstdint>
+
+typedef struct VkFence_T* VkFence;
+
+namespace Vulkan
+{
+    class Device;
+    class Buffer;
+    class CommandBuffer;
+
+    // Range of the staging ring reserved for an upload.
+    struct StagingRegion
+    {
+        uint64_t m_offset = 0; // Offset in the staging ring buffer
+        void* m_mappedData = nullptr;
+    };
+
+    // Persistently mapped host visible buffer used as a ring to stage the data
+    // uploaded to device local resources. Uploads reserve a region, write into it
+    // and submit the transfer commands without waiting for them. Regions are recycled
+    // once the fence of their submission signals, waiting for the oldest submissions
+    // only when the ring is full.
+    class StagingRing
+    {
+    public:
+        // Alignment enough for the source offset of any copy command,
+        // including images with block compressed formats.
+        static constexpr uint64_t CopyAlignment = 16;
+
+        StagingRing(Device* device);
+        ~StagingRing();
+
+        StagingRing(const StagingRing&) = delete;
+        StagingRing& operator=(const StagingRing&) = delete;
+
+        bool Initialize();
+        void Terminate();
+
+        Buffer* GetBuffer() { return m_buffer.get(); }
+
+        // Reserves size bytes with the offset aligned to alignment (power of two).
+        // Returns nullopt if the data doesn't fit in the ring, then the upload
+        // needs its own staging buffer.
+        std::optional<StagingRegion> Allocate(uint64_t size, uint64_t alignment);
+
+        // Command buffer in recording state for the transfer commands of an upload.
+        std::unique_ptr<CommandBuffer> BeginUpload();
+
+        // Ends and submits the transfer commands reading from the regions allocated
+        // since the last submission, which are recycled once the GPU has executed them.
+        // Commands submitted later to the graphics queue will see the uploaded data
+        // as long as the upload ends with a barrier for it.
+        bool SubmitUpload(std::unique_ptr<CommandBuffer> commandBuffer, bool waitUntilFinished = false);
+
+        // Identifies the last upload submitted, uploads are numbered in submission order.
+        uint64_t GetLastUpload() const { return m_submittedUploadCount; }
+
+        // Whether the GPU has executed the upload, so the resources it reads from can be destroyed.
+        bool IsUploadFinished(uint64_t upload);
+
+        // Waits for all the uploads submitted.
+        void WaitUntilIdle();
+
+    private:
+        Device* m_device = nullptr;
+
+    private:
+        struct Submission
+        {
+            VkFence m_vkFence = nullptr;
+            std::unique_ptr<CommandBuffer> m_commandBuffer;
+            uint64_t m_end = 0; // Ring position after the regions of the submission
+            uint64_t m_upload = 0;
+        };
+
+        // Recycles the regions of finished submissions, waiting for the oldest one when asked.
+        void RetireSubmissions(bool waitOldest);
+
+        VkFence AcquireFence();
+
+        std::unique_ptr<Buffer> m_buffer;
+        uint64_t m_size = 0;
+
+        // Positions grow forever, the offset in the buffer is the position modulo the size.
+        // Bytes from m_tail to m_head are in use by uploads not finished yet.
+        uint64_t m_head = 0;
+        uint64_t m_tail = 0;
+
+        std::deque<Submission> m_submissions;
+        uint64_t m_submittedUploadCount = 0;
+        uint64_t m_finishedUploadCount = 0;
+        std::vector<VkFence> m_freeFences;
+    };
+} // namespace Vulkan
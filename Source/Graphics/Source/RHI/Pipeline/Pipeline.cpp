@@ -78,11 +78,13 @@ namespace Vulkan
         }
     } // namespace Utils
 
-    Pipeline::Pipeline(Device* device, RenderPass* renderPass, uint32_t subpassIndex, const Math::Rectangle& viewport)
+    Pipeline::Pipeline(Device* device, RenderPass* renderPass, uint32_t subpassIndex, const Math::Rectangle& viewport,
+        VertexInputLayout vertexInputLayout)
         : m_device(device)
         , m_renderPass(renderPass)
         , m_subpassIndex(subpassIndex)
         , m_viewport(viewport)
+        , m_vertexInputLayout(vertexInputLayout)
     {
     }
 
@@ -164,6 +166,11 @@ namespace Vulkan
         return m_subpassIndex;
     }
 
+    VertexInputLayout Pipeline::GetVertexInputLayout() const
+    {
+        return m_vertexInputLayout;
+    }
+
     VkPipeline Pipeline::GetVkPipeline()
     {
         return m_vkPipeline;
@@ -201,6 +208,51 @@ namespace Vulkan
         return nullptr;
     }
 
+    bool Pipeline::UsesShader(std::string_view shaderFilename) const
+    {
+        return shaderFilename == GetVertexShaderFilename() ||
+            shaderFilename == GetFragmentShaderFilename();
+    }
+
+    bool Pipeline::ReloadShaders(VkPipeline& retiredVkPipeline)
+    {
+        DX_ASSERT(m_vkPipeline, "Vulkan Pipeline", "Pipeline not initialized");
+
+        const VkPipeline previousVkPipeline = m_vkPipeline;
+        m_vkPipeline = nullptr;
+
+        const bool created = (m_subpassIndex == 0)
+            ? CreateVkPipelineSubpass0()
+            : CreateVkPipelineSubpass1();
+        if (!created)
+        {
+            m_vkPipeline = previousVkPipeline;
+            return false;
+        }
+
+        retiredVkPipeline = previousVkPipeline;
+        return true;
+    }
+
+    const char* Pipeline::GetVertexShaderFilename() const
+    {
+        if (m_subpassIndex == 0)
+        {
+            // Compact vertices are decoded in their own vertex shader, the fragment shader is shared.
+            return (m_vertexInputLayout == VertexInputLayout::Compact)
+                ? "Shaders/ShaderCompact.vert.spv"
+                : "Shaders/Shader.vert.spv";
+        }
+        return "Shaders/PostShader.vert.spv";
+    }
+
+    const char* Pipeline::GetFragmentShaderFilename() const
+    {
+        return (m_subpassIndex == 0)
+            ? "Shaders/Shader.frag.spv"
+            : "Shaders/PostShader.frag.spv";
+    }
+
     bool Pipeline::CreateVkPipelineLayoutSubpass0()
     {
         // TODO: Obtain this from the shaders.
@@ -363,8 +415,8 @@ namespace Vulkan
             // 
             // TODO: Look into https://github.com/KhronosGroup/SPIRV-Reflect and https://github.com/KhronosGroup/glslang 
             //       to be able to obtain reflection data from the shaders.
-            const char* vertexShaderFilename = "Shaders/Shader.vert.spv";
-            const char* fragmentShaderFilename = "Shaders/Shader.frag.spv";
+            const char* vertexShaderFilename = GetVertexShaderFilename();
+            const char* fragmentShaderFilename = GetFragmentShaderFilename();
 
             // Read Shader ByteCode (SPIR-V)
             const auto vertexShaderByteCode = DX::ReadAssetBinaryFile(vertexShaderFilename);
@@ -375,7 +427,7 @@ namespace Vulkan
             }
 
             const auto fragmentShaderByteCode = DX::ReadAssetBinaryFile(fragmentShaderFilename);
-            if (!vertexShaderByteCode.has_value())
+            if (!fragmentShaderByteCode.has_value())
             {
                 DX_LOG(Error, "Renderer", "Failed to read fragment shader file %s.", fragmentShaderFilename);
                 return false;
@@ -417,19 +469,41 @@ namespace Vulkan
             vkPipelineShaderStagesCreateInfo[1].pSpecializationInfo = nullptr;
 
             // Pipeline Vertex Input State (Input Layout)
-            const VkVertexInputBindingDescription vkVertexInputBindingDesc = {
-                .binding = 0, // Stream
-                .stride = (3 + 3 + 3 + 3 + 2) * 4, // sizeof(VertexPNTBUv)
-                .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
-            };
-
-            const std::vector<VkVertexInputAttributeDescription> vkVertexInputAttributesDesc = {
-                {.location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = 0},
-                {.location = 1, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = (3) * 4 /*offsetof(VertexPNTBUv, m_normal)*/},
-                {.location = 2, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = (3 + 3) * 4 /*offsetof(VertexPNTBUv, m_tangent)*/},
-                {.location = 3, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = (3 + 3 + 3) * 4 /*offsetof(VertexPNTBUv, m_binormal)*/},
-                {.location = 4, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = (3 + 3 + 3 + 3) * 4 /*offsetof(VertexPNTBUv, m_uv)*/},
-            };
+            VkVertexInputBindingDescription vkVertexInputBindingDesc = {};
+            std::vector<VkVertexInputAttributeDescription> vkVertexInputAttributesDesc;
+            switch (m_vertexInputLayout)
+            {
+            case VertexInputLayout::Compact:
+                vkVertexInputBindingDesc = {
+                    .binding = 0, // Stream
+                    .stride = 2 * 4 + 1 * 4 + 2 * 2, // sizeof(VertexCompact)
+                    .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+                };
+
+                vkVertexInputAttributesDesc = {
+                    {.location = 0, .binding = 0, .format = VK_FORMAT_R16G16B16A16_UNORM, .offset = 0},
+                    {.location = 1, .binding = 0, .format = VK_FORMAT_R8G8B8A8_SNORM, .offset = 2 * 4 /*offsetof(VertexCompact, m_qtangent)*/},
+                    {.location = 2, .binding = 0, .format = VK_FORMAT_R16G16_SFLOAT, .offset = 2 * 4 + 1 * 4 /*offsetof(VertexCompact, m_uv)*/},
+                };
+                break;
+
+            case VertexInputLayout::PositionNormalTangentBinormalUv:
+            default:
+                vkVertexInputBindingDesc = {
+                    .binding = 0, // Stream
+                    .stride = (3 + 3 + 3 + 3 + 2) * 4, // sizeof(VertexPNTBUv)
+                    .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+                };
+
+                vkVertexInputAttributesDesc = {
+                    {.location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = 0},
+                    {.location = 1, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = (3) * 4 /*offsetof(VertexPNTBUv, m_normal)*/},
+                    {.location = 2, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = (3 + 3) * 4 /*offsetof(VertexPNTBUv, m_tangent)*/},
+                    {.location = 3, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = (3 + 3 + 3) * 4 /*offsetof(VertexPNTBUv, m_binormal)*/},
+                    {.location = 4, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = (3 + 3 + 3 + 3) * 4 /*offsetof(VertexPNTBUv, m_uv)*/},
+                };
+                break;
+            }
 
             VkPipelineVertexInputStateCreateInfo vkPipelineVertexInputStateCreateInfo = {};
             vkPipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -693,8 +767,8 @@ namespace Vulkan
         Utils::ScopedShaderModule vertexShaderModule(m_device);
         Utils::ScopedShaderModule framentShaderModule(m_device);
         {
-            const char* vertexShaderFilename = "Shaders/PostShader.vert.spv";
-            const char* fragmentShaderFilename = "Shaders/PostShader.frag.spv";
+            const char* vertexShaderFilename = GetVertexShaderFilename();
+            const char* fragmentShaderFilename = GetFragmentShaderFilename();
 
             // Read Shader ByteCode (SPIR-V)
             const auto vertexShaderByteCode = DX::ReadAssetBinaryFile(vertexShaderFilename);
@@ -705,7 +779,7 @@ namespace Vulkan
             }
 
             const auto fragmentShaderByteCode = DX::ReadAssetBinaryFile(fragmentShaderFilename);
-            if (!vertexShaderByteCode.has_value())
+            if (!fragmentShaderByteCode.has_value())
             {
                 DX_LOG(Error, "Renderer", "Failed to read fragment shader file %s.", fragmentShaderFilename);
                 return false;
@@ -5,6 +5,7 @@
 #include <Math/Rectangle.h>
 
 #include <vector>
+#include <string_view>
 
 typedef struct VkPipelineLayout_T* VkPipelineLayout;
 typedef struct VkPipeline_T* VkPipeline;
@@ -18,6 +19,13 @@ namespace Vulkan
 
     constexpr int PushConstantsMaxSize = 128; // Bytes
 
+    // Layout of the vertex buffer used by the scene pipeline (subpass 0).
+    enum class VertexInputLayout
+    {
+        PositionNormalTangentBinormalUv = 0, // 56 bytes: float3 position, normal, tangent, binormal and float2 uv
+        Compact,                             // 16 bytes: unorm16x4 position, snorm8x4 qtangent and half2 uv
+    };
+
     struct DescriptorSetLayout
     {
         VkDescriptorSetLayout m_vkDescriptorSetLayout = nullptr;
@@ -28,7 +36,8 @@ namespace Vulkan
     class Pipeline
     {
     public:
-        Pipeline(Device* device, RenderPass* renderPass, uint32_t subpassIndex, const Math::Rectangle& viewport);
+        Pipeline(Device* device, RenderPass* renderPass, uint32_t subpassIndex, const Math::Rectangle& viewport,
+            VertexInputLayout vertexInputLayout = VertexInputLayout::PositionNormalTangentBinormalUv);
         ~Pipeline();
 
         Pipeline(const Pipeline&) = delete;
@@ -39,6 +48,7 @@ namespace Vulkan
 
         RenderPass* GetRenderPass();
         uint32_t GetSubpassIndex() const;
+        VertexInputLayout GetVertexInputLayout() const;
 
         VkPipeline GetVkPipeline();
         VkPipelineLayout GetVkPipelineLayout();
@@ -54,11 +64,21 @@ namespace Vulkan
         // resources, other for per material resources and so on.
         std::shared_ptr<PipelineDescriptorSet> CreatePipelineDescriptorSet(uint32_t setLayoutIndex);
 
+        // Returns true if the pipeline uses the shader file. The filename is relative to the assets folder.
+        bool UsesShader(std::string_view shaderFilename) const;
+
+        // Creates the Vulkan pipeline again reading its shaders, keeping the pipeline layout,
+        // so descriptor sets created from this pipeline remain valid. The previous Vulkan pipeline
+        // is returned in retiredVkPipeline, the caller must destroy it once the frames in flight
+        // using it have finished. If it fails the pipeline is left unchanged.
+        bool ReloadShaders(VkPipeline& retiredVkPipeline);
+
     private:
         Device* m_device = nullptr;
         RenderPass* m_renderPass = nullptr;
         uint32_t m_subpassIndex = std::numeric_limits<uint32_t>::max();
         Math::Rectangle m_viewport;
+        VertexInputLayout m_vertexInputLayout = VertexInputLayout::PositionNormalTangentBinormalUv;
 
     private:
         // TODO: At the moment the pipelines are manually created since the user cannot specify
@@ -68,6 +88,9 @@ namespace Vulkan
         bool CreateVkPipelineLayoutSubpass1();
         bool CreateVkPipelineSubpass1();
 
+        const char* GetVertexShaderFilename() const;
+        const char* GetFragmentShaderFilename() const;
+
         std::vector<std::unique_ptr<DescriptorSetLayout>> m_descriptorSetLayouts;
         VkPipelineLayout m_vkPipelineLayout = nullptr;
 
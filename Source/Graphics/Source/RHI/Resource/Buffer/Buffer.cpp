@@ -1,6 +1,7 @@
 #include <RHI/Resource/Buffer/Buffer.h>
 
 #include <RHI/Device/Device.h>
+#include <RHI/Device/StagingRing.h>
 #include <RHI/CommandBuffer/CommandBuffer.h>
 #include <RHI/Vulkan/Utils.h>
 
@@ -10,6 +11,7 @@
 #include <vulkan/vulkan.h>
 
 #include <vector>
+#include <cstring>
 
 namespace Vulkan
 {
@@ -20,7 +22,7 @@ namespace Vulkan
             VkBufferUsageFlags vkBufferUsageFlags, 
             VkMemoryPropertyFlags vkMemoryPropertyFlags,
             VkBuffer* vkBufferOut,
-            VkDeviceMemory* vkBufferMemoryOut)
+            DeviceMemoryAllocation* allocationOut)
         {
             // Create Buffer object
             {
@@ -59,22 +61,17 @@ namespace Vulkan
                 VkMemoryRequirements vkMemoryRequirements = {};
                 vkGetBufferMemoryRequirements(device->GetVkDevice(), *vkBufferOut, &vkMemoryRequirements);
 
-                // Allocate memory for the buffer
-                VkMemoryAllocateInfo vkMemoryAllocateInfo = {};
-                vkMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-                vkMemoryAllocateInfo.pNext = nullptr;
-                vkMemoryAllocateInfo.allocationSize = vkMemoryRequirements.size;
-                vkMemoryAllocateInfo.memoryTypeIndex = FindCompatibleMemoryTypeIndex(
-                    device->GetVkPhysicalDevice(), vkMemoryRequirements.memoryTypeBits, vkMemoryPropertyFlags);
-
-                if (vkAllocateMemory(device->GetVkDevice(), &vkMemoryAllocateInfo, nullptr, vkBufferMemoryOut) != VK_SUCCESS)
+                // Sub-allocate memory for the buffer from a device memory block
+                if (!device->GetMemoryAllocator()->Allocate(vkMemoryRequirements, vkMemoryPropertyFlags,
+                    DeviceMemoryResourceType::Linear, *allocationOut))
                 {
                     DX_LOG(Error, "Vulkan Buffer", "Failed to allocate memory for Vulkan Buffer.");
                     return false;
                 }
 
-                // Link the buffer to the memory
-                if (vkBindBufferMemory(device->GetVkDevice(), *vkBufferOut, *vkBufferMemoryOut, 0) != VK_SUCCESS)
+                // Link the buffer to its range of the memory
+                if (vkBindBufferMemory(device->GetVkDevice(), *vkBufferOut,
+                    allocationOut->m_vkDeviceMemory, allocationOut->m_offset) != VK_SUCCESS)
                 {
                     DX_LOG(Error, "Vulkan Buffer", "Failed to bind Vulkan buffer to memory.");
                     return false;
@@ -84,92 +81,67 @@ namespace Vulkan
             return true;
         }
 
-        void DestroyVkBuffer(Device* device, VkBuffer& vkBuffer, VkDeviceMemory& vkBufferMemory)
+        void DestroyVkBuffer(Device* device, VkBuffer& vkBuffer, DeviceMemoryAllocation& allocation)
         {
             vkDestroyBuffer(device->GetVkDevice(), vkBuffer, nullptr);
             vkBuffer = nullptr;
 
-            vkFreeMemory(device->GetVkDevice(), vkBufferMemory, nullptr);
-            vkBufferMemory = nullptr;
+            device->GetMemoryAllocator()->Free(allocation);
         }
 
-        bool CopyBuffer(Device* device, Buffer* dstBuffer, Buffer* srcBuffer)
+        bool UploadBufferData(Device* device, Buffer* dstBuffer, const void* data, size_t dataSize)
         {
-            // Command buffer for transfer commands.
-            // By Vulkan standards, graphical queues also support transfer commands.
-            CommandBuffer transferCmdBuffer(device, 
-                device->GetVkCommandPool(QueueFamilyType_Graphics, ResourceTransferCommandPoolIndex));
-            if (transferCmdBuffer.Initialize())
+            StagingRing* stagingRing = device->GetStagingRing();
+
+            // Source of the copy: a region of the staging ring or, when the data
+            // doesn't fit in the ring, a staging buffer of its own.
+            std::unique_ptr<Buffer> ownedStageBuffer;
+            Buffer* stageBuffer = nullptr;
+            uint64_t stageOffset = 0;
+            if (auto stagingRegion = stagingRing->Allocate(dataSize, StagingRing::CopyAlignment))
             {
-                // Record transfer commands to the command buffer.
-                // Since it's a transfer operation, there is no need to bind render pass or pipelines.
-                // NOTE: To be more accurate, there is an implicit pipeline of only 1 stage which is to do the transfer.
-                if (transferCmdBuffer.Begin(CommandBufferUsage_OneTimeSubmit))
-                {
-                    transferCmdBuffer.CopyBuffer(dstBuffer, srcBuffer);
+                memcpy(stagingRegion->m_mappedData, data, dataSize);
 
-                    transferCmdBuffer.End();
-                }
-                else
-                {
-                    return false;
-                }
+                stageBuffer = stagingRing->GetBuffer();
+                stageOffset = stagingRegion->m_offset;
             }
             else
             {
-                return false;
-            }
-
-            // Execute the transfer command buffer
-            {
-                VkCommandBuffer vkTransfercCommandBuffer = transferCmdBuffer.GetVkCommandBuffer();
-
-                VkSubmitInfo vkSubmitInfo = {};
-                vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                vkSubmitInfo.pNext = nullptr;
-                vkSubmitInfo.pWaitDstStageMask = nullptr;
-                vkSubmitInfo.waitSemaphoreCount = 0;
-                vkSubmitInfo.pWaitSemaphores = nullptr;
-                vkSubmitInfo.commandBufferCount = 1;
-                vkSubmitInfo.pCommandBuffers = &vkTransfercCommandBuffer;
-                vkSubmitInfo.signalSemaphoreCount = 0;
-                vkSubmitInfo.pSignalSemaphores = nullptr;
-
-                // Submit command buffer to queue for execution by the GPU
-                if (vkQueueSubmit(device->GetVkQueue(Vulkan::QueueFamilyType_Graphics),
-                    1, &vkSubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+                BufferDesc stageBufferDesc = {};
+                stageBufferDesc.m_elementSizeInBytes = static_cast<uint32_t>(dataSize);
+                stageBufferDesc.m_elementCount = 1;
+                stageBufferDesc.m_usageFlags = BufferUsage_TransferSrc; // Source of the transfer
+                stageBufferDesc.m_memoryProperty = ResourceMemoryProperty::HostVisible;
+                stageBufferDesc.m_initialData = data;
+
+                ownedStageBuffer = std::make_unique<Buffer>(device, stageBufferDesc);
+                if (!ownedStageBuffer->Initialize())
                 {
-                    DX_LOG(Error, "Vulkan Buffer", "Failed to submit transfer work to the queue.");
+                    DX_LOG(Error, "Vulkan Buffer", "Failed to create Vulkan staging buffer.");
                     return false;
                 }
-
-                // Wait until the queue has finished executing all its commands.
-                // 
-                // NOTE: This is a sequential way to transfer buffers. More advance techniques
-                //       would not block and allow to continue adding transfer commands for other
-                //       buffers and synchronize at some point in the future.
-                vkQueueWaitIdle(device->GetVkQueue(Vulkan::QueueFamilyType_Graphics));
+                stageBuffer = ownedStageBuffer.get();
             }
 
-            return true;
-        }
-
-        bool CopyDataToVkBufferMemory(Device* device, VkDeviceMemory vkBufferMemory, const void* bufferData, size_t bufferSize)
-        {
-            void* dstData = nullptr;
-
-            if (vkMapMemory(device->GetVkDevice(), vkBufferMemory, 0, bufferSize, 0, &dstData) != VK_SUCCESS)
+            std::unique_ptr<CommandBuffer> transferCmdBuffer = stagingRing->BeginUpload();
+            if (!transferCmdBuffer)
             {
-                DX_LOG(Error, "Vulkan Buffer", "Failed to map Vulkan buffer memory.");
                 return false;
             }
 
-            memcpy(dstData, bufferData, bufferSize);
+            transferCmdBuffer->CopyBufferRegion(dstBuffer, 0, stageBuffer, stageOffset, dataSize);
 
-            vkUnmapMemory(device->GetVkDevice(), vkBufferMemory);
+            // Commands submitted afterwards to the queue wait for the copy before reading the buffer.
+            transferCmdBuffer->PipelineMemoryBarrier(
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT);
 
-            // NOTE: No need to flush and invalidate since the device memory has the flag VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-            return true;
+            // Copies from the staging ring are not waited for, the ring recycles the region
+            // once the GPU has executed them. A staging buffer of its own is destroyed after
+            // this function, so its copy has to finish first. It only waits for this copy,
+            // not for the whole queue.
+            const bool waitUntilFinished = (stageBuffer != stagingRing->GetBuffer());
+            return stagingRing->SubmitUpload(std::move(transferCmdBuffer), waitUntilFinished);
         }
     } // namespace Utils
 
@@ -206,7 +178,9 @@ namespace Vulkan
     {
         DX_LOG(Info, "Vulkan Buffer", "Terminating Vulkan Buffer...");
 
-        Utils::DestroyVkBuffer(m_device, m_vkBuffer, m_vkBufferMemory);
+        m_mappedData = nullptr;
+
+        Utils::DestroyVkBuffer(m_device, m_vkBuffer, m_allocation);
     }
 
     VkBuffer Buffer::GetVkBuffer()
@@ -228,11 +202,9 @@ namespace Vulkan
             return false;
         }
 
-        if (!Utils::CopyDataToVkBufferMemory(m_device, m_vkBufferMemory, data, dataSize))
-        {
-            DX_LOG(Error, "Vulkan Buffer", "Failed to copy data to Vulkan buffer memory.");
-            return false;
-        }
+        // Host visible memory is always mapped by the allocator.
+        // NOTE: No need to flush and invalidate since the device memory has the flag VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        memcpy(m_allocation.m_mappedData, data, dataSize);
 
         return true;
     }
@@ -263,80 +235,58 @@ namespace Vulkan
                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 
             if (!Utils::CreateVkBuffer(m_device, bufferSize,
-                vkBufferUsageFlags, vkMemoryProperties, &m_vkBuffer, &m_vkBufferMemory))
+                vkBufferUsageFlags, vkMemoryProperties, &m_vkBuffer, &m_allocation))
             {
                 return false;
             }
 
+            // The allocator keeps host visible memory mapped, the buffer only exposes it when asked.
+            if (m_desc.m_persistentlyMapped)
+            {
+                m_mappedData = m_allocation.m_mappedData;
+            }
+
             // Copy data to buffer
             if (m_desc.m_initialData)
             {
-                if (!Utils::CopyDataToVkBufferMemory(m_device, m_vkBufferMemory, m_desc.m_initialData, bufferSize))
-                {
-                    DX_LOG(Error, "Vulkan Buffer", "Failed to map Vulkan buffer memory.");
-                    return false;
-                }
+                memcpy(m_allocation.m_mappedData, m_desc.m_initialData, bufferSize);
             }
             break;
         }
 
         case ResourceMemoryProperty::DeviceLocal:
         {
-            // If there is initial data to copy, use a staging buffer to transfer the data to the GPU buffer
-            if (m_desc.m_initialData)
+            if (m_desc.m_persistentlyMapped)
             {
-                // Create staging source buffer to put data before transferring to GPU
-                std::unique_ptr<Buffer> stageBuffer;
-                {
-                    BufferDesc stageBufferDesc = {};
-                    stageBufferDesc.m_elementSizeInBytes = m_desc.m_elementSizeInBytes;
-                    stageBufferDesc.m_elementCount = m_desc.m_elementCount;
-                    stageBufferDesc.m_usageFlags = BufferUsage_TransferSrc; // Source of the transfer
-                    stageBufferDesc.m_memoryProperty = ResourceMemoryProperty::HostVisible;
-                    stageBufferDesc.m_initialData = m_desc.m_initialData;
-
-                    stageBuffer = std::make_unique<Buffer>(m_device, stageBufferDesc);
-                    if (!stageBuffer->Initialize())
-                    {
-                        DX_LOG(Error, "Vulkan Buffer", "Failed to create Vulkan staging buffer.");
-                        return false;
-                    }
-                }
-
-                // Create destination buffer in GPU
-                {
-                    // This buffer will be the target of a transfer require, so adding the
-                    // transfer destination flag on top of the actual usage.
-                    m_desc.m_usageFlags |= BufferUsage_TransferDst;
+                DX_LOG(Warning, "Vulkan Buffer", "Device local buffers cannot be mapped, persistent mapping ignored.");
+            }
 
-                    const VkBufferUsageFlags vkBufferUsageFlags = ToVkBufferUsageFlags(m_desc.m_usageFlags);
+            // If there is initial data to copy, this buffer will be the target of a
+            // transfer, so adding the transfer destination flag on top of the actual usage.
+            if (m_desc.m_initialData)
+            {
+                m_desc.m_usageFlags |= BufferUsage_TransferDst;
+            }
 
-                    // Memory properties we want:
-                    // - VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT: visible to the GPU only (optimal for GPU performance)
-                    const VkMemoryPropertyFlags vkMemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            // Create buffer in GPU
+            {
+                const VkBufferUsageFlags vkBufferUsageFlags = ToVkBufferUsageFlags(m_desc.m_usageFlags);
 
-                    if (!Utils::CreateVkBuffer(m_device, bufferSize,
-                        vkBufferUsageFlags, vkMemoryProperties, &m_vkBuffer, &m_vkBufferMemory))
-                    {
-                        return false;
-                    }
-                }
+                // Memory properties we want:
+                // - VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT: visible to the GPU only (optimal for GPU performance)
+                const VkMemoryPropertyFlags vkMemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-                // Execute commands to copy staging buffer to destination buffer on GPU
-                if (!Utils::CopyBuffer(m_device, this, stageBuffer.get()))
+                if (!Utils::CreateVkBuffer(m_device, bufferSize,
+                    vkBufferUsageFlags, vkMemoryProperties, &m_vkBuffer, &m_allocation))
                 {
                     return false;
                 }
             }
-            // It there is no initial data to copy, just create buffer in GPU
-            else
-            {
-                const VkBufferUsageFlags vkBufferUsageFlags = ToVkBufferUsageFlags(m_desc.m_usageFlags);
-
-                const VkMemoryPropertyFlags vkMemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-                if (!Utils::CreateVkBuffer(m_device, bufferSize,
-                    vkBufferUsageFlags, vkMemoryProperties, &m_vkBuffer, &m_vkBufferMemory))
+            // Transfer the initial data to the GPU buffer through staging memory
+            if (m_desc.m_initialData)
+            {
+                if (!Utils::UploadBufferData(m_device, this, m_desc.m_initialData, bufferSize))
                 {
                     return false;
                 }
@@ -1,9 +1,9 @@
 #pragma once
 
 #include <RHI/Resource/Buffer/BufferDesc.h>
+#include <RHI/Device/DeviceMemoryAllocator.h>
 
 typedef struct VkBuffer_T* VkBuffer;
-typedef struct VkDeviceMemory_T* VkDeviceMemory;
 
 namespace Vulkan
 {
@@ -28,6 +28,9 @@ namespace Vulkan
 
         bool UpdateBufferData(const void* data, size_t dataSize);
 
+        // Memory of a persistently mapped buffer, null otherwise.
+        void* GetMappedData() { return m_mappedData; }
+
     private:
         Device* m_device = nullptr;
         BufferDesc m_desc;
@@ -36,6 +39,8 @@ namespace Vulkan
         bool CreateVkBuffer();
 
         VkBuffer m_vkBuffer = nullptr;
-        VkDeviceMemory m_vkBufferMemory = nullptr;
+        DeviceMemoryAllocation m_allocation;
+
+        void* m_mappedData = nullptr;
     };
 } // namespace Vulkan
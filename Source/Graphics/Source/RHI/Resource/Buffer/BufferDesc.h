@@ -13,5 +13,9 @@ namespace Vulkan
         ResourceMemoryProperty m_memoryProperty;
 
         const void* m_initialData;
+
+        // Keeps the memory mapped for the whole life of the buffer, so the CPU
+        // can write into it directly with GetMappedData. Only for HostVisible memory.
+        bool m_persistentlyMapped;
     };
 } // namespace Vulkan
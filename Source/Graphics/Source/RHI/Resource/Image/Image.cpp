@@ -1,6 +1,7 @@
 #include <RHI/Resource/Image/Image.h>
 
 #include <RHI/Device/Device.h>
+#include <RHI/Device/StagingRing.h>
 #include <RHI/CommandBuffer/CommandBuffer.h>
 #include <RHI/Resource/Buffer/Buffer.h>
 #include <RHI/Vulkan/Utils.h>
@@ -10,6 +11,8 @@
 
 #include <vulkan/vulkan.h>
 
+#include <cstring>
+
 namespace Vulkan
 {
     namespace Utils
@@ -24,7 +27,7 @@ namespace Vulkan
             VkImageUsageFlags vkImageUsageFlags,
             VkMemoryPropertyFlags vkMemoryPropertyFlags,
             VkImage* vkImageOut,
-            VkDeviceMemory* vkImageMemoryOut)
+            DeviceMemoryAllocation* allocationOut)
         {
             // Create Image object
             {
@@ -72,22 +75,22 @@ namespace Vulkan
                 VkMemoryRequirements vkMemoryRequirements = {};
                 vkGetImageMemoryRequirements(device->GetVkDevice(), *vkImageOut, &vkMemoryRequirements);
 
-                // Allocate memory for the image
-                VkMemoryAllocateInfo vkMemoryAllocateInfo = {};
-                vkMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-                vkMemoryAllocateInfo.pNext = nullptr;
-                vkMemoryAllocateInfo.allocationSize = vkMemoryRequirements.size;
-                vkMemoryAllocateInfo.memoryTypeIndex = FindCompatibleMemoryTypeIndex(
-                    device->GetVkPhysicalDevice(), vkMemoryRequirements.memoryTypeBits, vkMemoryPropertyFlags);
+                // Sub-allocate memory for the image from a device memory block.
+                // Images with optimal tiling can't share pages with linear resources.
+                const DeviceMemoryResourceType resourceType = (vkImageTiling == VK_IMAGE_TILING_OPTIMAL)
+                    ? DeviceMemoryResourceType::Optimal
+                    : DeviceMemoryResourceType::Linear;
 
-                if (vkAllocateMemory(device->GetVkDevice(), &vkMemoryAllocateInfo, nullptr, vkImageMemoryOut) != VK_SUCCESS)
+                if (!device->GetMemoryAllocator()->Allocate(vkMemoryRequirements, vkMemoryPropertyFlags,
+                    resourceType, *allocationOut))
                 {
                     DX_LOG(Error, "Vulkan Image", "Failed to allocate memory for Vulkan Image.");
                     return false;
                 }
 
-                // Link the image to the memory
-                if (vkBindImageMemory(device->GetVkDevice(), *vkImageOut, *vkImageMemoryOut, 0) != VK_SUCCESS)
+                // Link the image to its range of the memory
+                if (vkBindImageMemory(device->GetVkDevice(), *vkImageOut,
+                    allocationOut->m_vkDeviceMemory, allocationOut->m_offset) != VK_SUCCESS)
                 {
                     DX_LOG(Error, "Vulkan Image", "Failed to bind Vulkan image to memory.");
                     return false;
@@ -97,13 +100,16 @@ namespace Vulkan
             return true;
         }
 
-        void DestroyVkImage(Device* device, VkImage& vkImage, VkDeviceMemory& vkImageMemory)
+        void DestroyVkImage(Device* device, VkImage& vkImage, VkDeviceMemory& vkImageMemory, DeviceMemoryAllocation& allocation)
         {
             vkDestroyImage(device->GetVkDevice(), vkImage, nullptr);
             vkImage = nullptr;
 
+            // Native resources own their memory, the rest was sub-allocated.
             vkFreeMemory(device->GetVkDevice(), vkImageMemory, nullptr);
             vkImageMemory = nullptr;
+
+            device->GetMemoryAllocator()->Free(allocation);
         }
 
         bool ExecuteCommandBufferAndWait(Device* device, CommandBuffer* commandBuffer)
@@ -139,42 +145,6 @@ namespace Vulkan
             return true;
         }
 
-        bool CopyBufferToImage(Device* device, Image* dstImage, Buffer* srcBuffer)
-        {
-            // Command buffer for transfer commands.
-            // By Vulkan standards, graphical queues also support transfer commands.
-            CommandBuffer transferCmdBuffer(device,
-                device->GetVkCommandPool(QueueFamilyType_Graphics, ResourceTransferCommandPoolIndex));
-            if (transferCmdBuffer.Initialize())
-            {
-                // Record transfer commands to the command buffer.
-                // Since it's a transfer operation, there is no need to bind render pass or pipelines.
-                // NOTE: To be more accurate, there is an implicit pipeline of only 1 stage which is to do the transfer.
-                if (transferCmdBuffer.Begin(CommandBufferUsage_OneTimeSubmit))
-                {
-                    transferCmdBuffer.CopyBufferToImage(dstImage, srcBuffer);
-
-                    transferCmdBuffer.End();
-                }
-                else
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                return false;
-            }
-
-            // Execute the transfer command buffer
-            if (!ExecuteCommandBufferAndWait(device, &transferCmdBuffer))
-            {
-                return false;
-            }
-
-            return true;
-        }
-
         bool TransitionImageLayout(Device* device, Image* image, 
             int& vkCurrImageLayoutOut, VkImageLayout vkNewImageLayout,
             VkPipelineStageFlags vkSrcPipelineStage, VkAccessFlags vkSrcAccessMask,
@@ -276,7 +246,7 @@ namespace Vulkan
         }
         else
         {
-            Utils::DestroyVkImage(m_device, m_vkImage, m_vkImageMemory);
+            Utils::DestroyVkImage(m_device, m_vkImage, m_vkImageMemory, m_allocation);
         }
     }
 
@@ -298,7 +268,7 @@ namespace Vulkan
             const uint32_t mipSizeX = std::max<uint32_t>(1, m_desc.m_dimensions.x >> mipLevel);
             const uint32_t mipSizeY = std::max<uint32_t>(1, m_desc.m_dimensions.y >> mipLevel);
             const uint32_t mipSizeZ = std::max<uint32_t>(1, m_desc.m_dimensions.z >> mipLevel);
-            const uint32_t mipBytes = ResourceFormatSize(m_desc.m_format, mipSizeX * mipSizeY * mipSizeZ);
+            const uint32_t mipBytes = ResourceFormatImageSize(m_desc.m_format, mipSizeX, mipSizeY, mipSizeZ);
 
             totalSize += mipBytes;
         }
@@ -334,7 +304,7 @@ namespace Vulkan
             // NOTE: Expected that the VkImage is already linked to the VkDeviceMemory.
 
             // When native resource are directly provided, the initial data will be ignored.
-            if (m_desc.m_initialData != nullptr)
+            if (m_desc.m_initialData != nullptr || m_desc.m_initialDataBuffer != nullptr)
             {
                 DX_LOG(Warning, "Vulkan Image", 
                     "Initial data provided will be ignored since the image native resources was directly provided.");
@@ -342,23 +312,17 @@ namespace Vulkan
             return true;
         }
 
-        // If there is initial data to copy, use a staging image to transfer the data to the GPU image
-        if (m_desc.m_initialData)
+        // If there is initial data to copy, use staging memory to transfer the data to the GPU image
+        if (m_desc.m_initialData || m_desc.m_initialDataBuffer)
         {
-            // Create staging source buffer to put data before transferring to GPU
-            std::unique_ptr<Buffer> stageBuffer;
+            const uint32_t imageMemorySize = CalculateImageMemorySize();
+
+            if (m_desc.m_initialDataBuffer)
             {
-                BufferDesc stageBufferDesc = {};
-                stageBufferDesc.m_elementSizeInBytes = CalculateImageMemorySize();
-                stageBufferDesc.m_elementCount = 1;
-                stageBufferDesc.m_usageFlags = BufferUsage_TransferSrc;
-                stageBufferDesc.m_memoryProperty = ResourceMemoryProperty::HostVisible;
-                stageBufferDesc.m_initialData = m_desc.m_initialData;
-
-                stageBuffer = std::make_unique<Buffer>(m_device, stageBufferDesc);
-                if (!stageBuffer->Initialize())
+                const BufferDesc& stageBufferDesc = m_desc.m_initialDataBuffer->GetBufferDesc();
+                if (static_cast<size_t>(stageBufferDesc.m_elementSizeInBytes) * stageBufferDesc.m_elementCount < imageMemorySize)
                 {
-                    DX_LOG(Error, "Vulkan Image", "Failed to create Vulkan staging buffer.");
+                    DX_LOG(Error, "Vulkan Image", "Staging buffer is smaller than the image data.");
                     return false;
                 }
             }
@@ -382,57 +346,90 @@ namespace Vulkan
                     vkImageUsageFlags,
                     vkMemoryProperties,
                     &m_vkImage,
-                    &m_vkImageMemory))
+                    &m_allocation))
                 {
                     return false;
                 }
             }
 
-            // Transition image layout to be TRANSFER_DST_OPTIMAL for copy operation
-            if (!Utils::TransitionImageLayout(m_device, this, 
-                m_vkImageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                // AFTER any point at the very start of the pipeline
-                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
-                // BEFORE it attempts to do a transfer write operation at the transfer stage of the pipeline
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT))
+            StagingRing* stagingRing = m_device->GetStagingRing();
+
+            // Source of the copy: the buffer provided with the data already written into it,
+            // a region of the staging ring or, when the data doesn't fit in the ring, a staging buffer of its own.
+            std::unique_ptr<Buffer> ownedStageBuffer;
+            Buffer* stageBuffer = m_desc.m_initialDataBuffer;
+            uint64_t stageOffset = 0;
+            if (!stageBuffer)
             {
-                return false;
+                if (auto stagingRegion = stagingRing->Allocate(imageMemorySize, StagingRing::CopyAlignment))
+                {
+                    memcpy(stagingRegion->m_mappedData, m_desc.m_initialData, imageMemorySize);
+
+                    stageBuffer = stagingRing->GetBuffer();
+                    stageOffset = stagingRegion->m_offset;
+                }
+                else
+                {
+                    BufferDesc stageBufferDesc = {};
+                    stageBufferDesc.m_elementSizeInBytes = imageMemorySize;
+                    stageBufferDesc.m_elementCount = 1;
+                    stageBufferDesc.m_usageFlags = BufferUsage_TransferSrc;
+                    stageBufferDesc.m_memoryProperty = ResourceMemoryProperty::HostVisible;
+                    stageBufferDesc.m_initialData = m_desc.m_initialData;
+
+                    ownedStageBuffer = std::make_unique<Buffer>(m_device, stageBufferDesc);
+                    if (!ownedStageBuffer->Initialize())
+                    {
+                        DX_LOG(Error, "Vulkan Image", "Failed to create Vulkan staging buffer.");
+                        return false;
+                    }
+                    stageBuffer = ownedStageBuffer.get();
+                }
             }
 
-            // Execute commands to copy staging buffer to destination image on GPU
-            if (!Utils::CopyBufferToImage(m_device, this, stageBuffer.get()))
+            // Layout transitions and copy are recorded in a single command buffer.
+            std::unique_ptr<CommandBuffer> transferCmdBuffer = stagingRing->BeginUpload();
+            if (!transferCmdBuffer)
             {
                 return false;
             }
 
+            // Transition image layout to be TRANSFER_DST_OPTIMAL for copy operation
+            transferCmdBuffer->PipelineImageMemoryBarrier(this,
+                m_vkImageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                // AFTER any point at the very start of the pipeline
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                // BEFORE it attempts to do a transfer write operation at the transfer stage of the pipeline
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+            m_vkImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+            // Copy staging memory to destination image on GPU
+            transferCmdBuffer->CopyBufferToImage(this, stageBuffer, stageOffset);
+
             // Handle transition to final layout depending on its usage
             if (m_desc.m_usageFlags & ImageUsage_Sampled)
             {
                 // Transition to be shader readable for shader usage
-                if (!Utils::TransitionImageLayout(m_device, this,
+                transferCmdBuffer->PipelineImageMemoryBarrier(this,
                     m_vkImageLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                     // AFTER it has finished to do writing operations in the transfer stage
                     // (basically when the copy buffer to image has finished)
                     VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
                     // BEFORE it attempts to do a shader read operation at the fragment shader stage of the pipeline
-                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT))
-                {
-                    return false;
-                }
+                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+                m_vkImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             }
             else if (m_desc.m_usageFlags & ImageUsage_Storage)
             {
                 // Transition to be general so it can be read/written in the shader
-                if (!Utils::TransitionImageLayout(m_device, this,
+                transferCmdBuffer->PipelineImageMemoryBarrier(this,
                     m_vkImageLayout, VK_IMAGE_LAYOUT_GENERAL,
                     // AFTER it has finished to do writing operations in the transfer stage
                     // (basically when the copy buffer to image has finished)
                     VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
                     // BEFORE it attempts to do a shader read/write operation at the fragment shader stage of the pipeline
-                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT))
-                {
-                    return false;
-                }
+                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+                m_vkImageLayout = VK_IMAGE_LAYOUT_GENERAL;
             }
             else if (m_desc.m_usageFlags & ImageUsage_ColorAttachment)
             {
@@ -446,6 +443,16 @@ namespace Vulkan
             {
                 DX_LOG(Error, "Vulkan Image", "Image usage is to as input attachment, but data was provided.");
             }
+
+            // Copies from the staging ring are not waited for, the ring recycles the region
+            // once the GPU has executed them, neither are copies from the buffer provided,
+            // which is kept alive by the caller. The staging buffer of its own is destroyed
+            // after this function, so its copy has to finish first.
+            const bool waitUntilFinished = (ownedStageBuffer != nullptr);
+            if (!stagingRing->SubmitUpload(std::move(transferCmdBuffer), waitUntilFinished))
+            {
+                return false;
+            }
         }
         // It there is no initial data to copy, just create image in GPU
         else
@@ -463,7 +470,7 @@ namespace Vulkan
                 vkImageUsageFlags,
                 vkMemoryProperties,
                 &m_vkImage,
-                &m_vkImageMemory))
+                &m_allocation))
             {
                 return false;
             }
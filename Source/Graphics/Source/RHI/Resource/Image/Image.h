@@ -1,6 +1,7 @@
 #pragma once
 
 #include <RHI/Resource/Image/ImageDesc.h>
+#include <RHI/Device/DeviceMemoryAllocator.h>
 
 typedef struct VkImage_T* VkImage;
 typedef struct VkDeviceMemory_T* VkDeviceMemory;
@@ -37,7 +38,8 @@ namespace Vulkan
         bool CreateVkImage();
 
         VkImage m_vkImage = nullptr;
-        VkDeviceMemory m_vkImageMemory = nullptr;
+        VkDeviceMemory m_vkImageMemory = nullptr; // Only for native resources
+        DeviceMemoryAllocation m_allocation;
 
         int m_vkImageLayout = 0;
     };
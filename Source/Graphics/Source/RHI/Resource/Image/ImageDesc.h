@@ -9,6 +9,8 @@
 
 namespace Vulkan
 {
+    class Buffer;
+
     struct ImageDesc
     {
         ImageType m_imageType;
@@ -20,6 +22,13 @@ namespace Vulkan
 
         const void* m_initialData;
 
+        // Staging buffer that already contains the initial data, it avoids copying the
+        // data into a new one. It's used instead of m_initialData when provided.
+        // It must be a transfer source in host visible memory with all mips tightly packed.
+        // The copy from it is not waited for, the caller must keep it alive until the upload
+        // has finished (see StagingRing::GetLastUpload and StagingRing::IsUploadFinished).
+        Buffer* m_initialDataBuffer;
+
         // When native resources are passed it will directly use them 
         // and not create them.
         struct NativeResource
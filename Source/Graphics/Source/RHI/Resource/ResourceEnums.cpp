@@ -153,9 +153,61 @@ namespace Vulkan
         case ResourceFormat::D24_UNORM_S8_UINT:           return elementCount * 4;
         case ResourceFormat::D32_SFLOAT_S8_UINT:          return elementCount * 5;
 
+        case ResourceFormat::BC1_RGB_UNORM_BLOCK:         return elementCount * 8;
+        case ResourceFormat::BC1_RGB_SRGB_BLOCK:          return elementCount * 8;
+        case ResourceFormat::BC1_RGBA_UNORM_BLOCK:        return elementCount * 8;
+        case ResourceFormat::BC1_RGBA_SRGB_BLOCK:         return elementCount * 8;
+        case ResourceFormat::BC2_UNORM_BLOCK:             return elementCount * 16;
+        case ResourceFormat::BC2_SRGB_BLOCK:              return elementCount * 16;
+        case ResourceFormat::BC3_UNORM_BLOCK:             return elementCount * 16;
+        case ResourceFormat::BC3_SRGB_BLOCK:              return elementCount * 16;
+        case ResourceFormat::BC4_UNORM_BLOCK:             return elementCount * 8;
+        case ResourceFormat::BC4_SNORM_BLOCK:             return elementCount * 8;
+        case ResourceFormat::BC5_UNORM_BLOCK:             return elementCount * 16;
+        case ResourceFormat::BC5_SNORM_BLOCK:             return elementCount * 16;
+        case ResourceFormat::BC6H_UFLOAT_BLOCK:           return elementCount * 16;
+        case ResourceFormat::BC6H_SFLOAT_BLOCK:           return elementCount * 16;
+        case ResourceFormat::BC7_UNORM_BLOCK:             return elementCount * 16;
+        case ResourceFormat::BC7_SRGB_BLOCK:              return elementCount * 16;
+
         default:
             DX_LOG(Fatal, "ResourceFormat", "Unknown size for resource format %d", format);
             return 0;
         }
     }
+
+    int ResourceFormatBlockDimension(ResourceFormat format)
+    {
+        switch (format)
+        {
+        case ResourceFormat::BC1_RGB_UNORM_BLOCK:
+        case ResourceFormat::BC1_RGB_SRGB_BLOCK:
+        case ResourceFormat::BC1_RGBA_UNORM_BLOCK:
+        case ResourceFormat::BC1_RGBA_SRGB_BLOCK:
+        case ResourceFormat::BC2_UNORM_BLOCK:
+        case ResourceFormat::BC2_SRGB_BLOCK:
+        case ResourceFormat::BC3_UNORM_BLOCK:
+        case ResourceFormat::BC3_SRGB_BLOCK:
+        case ResourceFormat::BC4_UNORM_BLOCK:
+        case ResourceFormat::BC4_SNORM_BLOCK:
+        case ResourceFormat::BC5_UNORM_BLOCK:
+        case ResourceFormat::BC5_SNORM_BLOCK:
+        case ResourceFormat::BC6H_UFLOAT_BLOCK:
+        case ResourceFormat::BC6H_SFLOAT_BLOCK:
+        case ResourceFormat::BC7_UNORM_BLOCK:
+        case ResourceFormat::BC7_SRGB_BLOCK:
+            return 4;
+
+        default:
+            return 1;
+        }
+    }
+
+    int ResourceFormatImageSize(ResourceFormat format, int width, int height, int depth)
+    {
+        const int blockDimension = ResourceFormatBlockDimension(format);
+        const int blocksX = (width + blockDimension - 1) / blockDimension;
+        const int blocksY = (height + blockDimension - 1) / blockDimension;
+        return ResourceFormatSize(format, blocksX * blocksY * depth);
+    }
 } // namespace Vulkan
@@ -225,6 +225,15 @@ namespace Vulkan
         Count
     };
 
+    // Size in bytes of a number of elements of the format.
+    // For block compressed formats elements are blocks instead of texels.
     int ResourceFormatSize(ResourceFormat format, int elementCount);
 
+    // Dimension in texels of the square blocks of a format. It's 1 for uncompressed formats.
+    int ResourceFormatBlockDimension(ResourceFormat format);
+
+    // Size in bytes of an image of the format, taking into account that
+    // block compressed formats store partial blocks as full blocks.
+    int ResourceFormatImageSize(ResourceFormat format, int width, int height, int depth);
+
 } // namespace Vulkan
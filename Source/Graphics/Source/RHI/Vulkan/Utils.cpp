@@ -7,13 +7,10 @@
 namespace Vulkan
 {
     // Finds the index of the memory type which is in the allowed list and has all the properties passed by argument.
+    // Properties of the physical device memory are queried once by DeviceMemoryAllocator.
     uint32_t FindCompatibleMemoryTypeIndex(
-        VkPhysicalDevice vkPhysicalDevice, uint32_t allowedMemoryTypes, VkMemoryPropertyFlags properties)
+        const VkPhysicalDeviceMemoryProperties& vkPhysicalDeviceMemoryProperties, uint32_t allowedMemoryTypes, VkMemoryPropertyFlags properties)
     {
-        // Get properties of the physical device memory
-        VkPhysicalDeviceMemoryProperties vkPhysicalDeviceMemoryProperties = {};
-        vkGetPhysicalDeviceMemoryProperties(vkPhysicalDevice, &vkPhysicalDeviceMemoryProperties);
-
         // For each memory type
         for (uint32_t i = 0; i < vkPhysicalDeviceMemoryProperties.memoryTypeCount; ++i)
         {
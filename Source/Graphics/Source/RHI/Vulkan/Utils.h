@@ -15,7 +15,7 @@
 namespace Vulkan
 {
     uint32_t FindCompatibleMemoryTypeIndex(
-        VkPhysicalDevice vkPhysicalDevice, uint32_t allowedMemoryTypes, VkMemoryPropertyFlags properties);
+        const VkPhysicalDeviceMemoryProperties& vkPhysicalDeviceMemoryProperties, uint32_t allowedMemoryTypes, VkMemoryPropertyFlags properties);
 
     VkFormat ToVkFormat(ResourceFormat format);
 
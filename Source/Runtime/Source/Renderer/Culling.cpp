@@ -0,0 +1,92 @@
+#include <Renderer/Culling.h>
+#include <Assets/Meshlet.h>
+
+#include <cmath>
+
+namespace DX
+{
+    namespace Internal
+    {
+        Plane CreateNormalizedPlane(const Math::Vector4& coefficients)
+        {
+            const Math::Vector3 normal = coefficients.xyz();
+            const float length = normal.Length();
+            return (length > 0.0f)
+                ? Plane{ normal / length, coefficients.w / length }
+                : Plane{ normal, coefficients.w };
+        }
+    } // namespace Internal
+
+    Frustum Frustum::CreateFromMatrix(const Math::Matrix4x4& matrix)
+    {
+        // Gribb-Hartmann plane extraction from the rows of the matrix.
+        auto row = [&matrix](int index)
+        {
+            return Math::Vector4(matrix(index, 0), matrix(index, 1), matrix(index, 2), matrix(index, 3));
+        };
+
+        const Math::Vector4 row0 = row(0);
+        const Math::Vector4 row1 = row(1);
+        const Math::Vector4 row2 = row(2);
+        const Math::Vector4 row3 = row(3);
+
+        // Near plane uses clip depth -w, which contains the [0,w] range too,
+        // so culling stays conservative regardless of the depth convention.
+        Frustum frustum;
+        frustum.m_planes[0] = Internal::CreateNormalizedPlane(row3 + row0); // Left
+        frustum.m_planes[1] = Internal::CreateNormalizedPlane(row3 - row0); // Right
+        frustum.m_planes[2] = Internal::CreateNormalizedPlane(row3 + row1); // Bottom
+        frustum.m_planes[3] = Internal::CreateNormalizedPlane(row3 - row1); // Top
+        frustum.m_planes[4] = Internal::CreateNormalizedPlane(row3 + row2); // Near
+        frustum.m_planes[5] = Internal::CreateNormalizedPlane(row3 - row2); // Far
+        return frustum;
+    }
+
+    bool Frustum::IsSphereVisible(const Math::Vector3& center, float radius) const
+    {
+        for (const Plane& plane : m_planes)
+        {
+            if (plane.DistanceTo(center) < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsMeshletBackFacing(const Meshlet& meshlet, const Math::Vector3& viewPosition)
+    {
+        const Math::Vector3 viewDirection = Math::Vector3(meshlet.m_coneApex) - viewPosition;
+        const float distance = viewDirection.Length();
+        if (distance <= 0.0f)
+        {
+            return false;
+        }
+
+        return Math::Vector3::DotProduct(viewDirection / distance, Math::Vector3(meshlet.m_coneAxis)) > meshlet.m_coneCutoff;
+    }
+
+    void CullMeshlets(std::span<const Meshlet> meshlets,
+        const Math::Matrix4x4& worldMatrix,
+        const Math::Matrix4x4& viewProjMatrix,
+        const Math::Vector3& viewPosition,
+        std::vector<uint32_t>& visibleMeshlets)
+    {
+        // Culling is done in object space, so meshlet data doesn't need to be transformed.
+        const Frustum frustum = Frustum::CreateFromMatrix(viewProjMatrix * worldMatrix);
+        const Math::Vector3 objectViewPosition = worldMatrix.Inverse() * viewPosition;
+
+        for (uint32_t meshletIndex = 0; meshletIndex < meshlets.size(); ++meshletIndex)
+        {
+            const Meshlet& meshlet = meshlets[meshletIndex];
+
+            if (!frustum.IsSphereVisible(Math::Vector3(meshlet.m_center), meshlet.m_radius) ||
+                IsMeshletBackFacing(meshlet, objectViewPosition))
+            {
+                continue;
+            }
+
+            visibleMeshlets.push_back(meshletIndex);
+        }
+    }
+} // namespace DX
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Math/Vector3.h>
+#include <Math/Vector4.h>
+#include <Math/Matrix4x4.h>
+
+#include <array>
+#include <vector>
+#include <span>
+
+namespace DX
+{
+    struct Meshlet;
+
+    // Plane with equation dot(m_normal, point) + m_distance = 0.
+    // The positive side of the plane is the inside.
+    struct Plane
+    {
+        Math::Vector3 m_normal;
+        float m_distance = 0.0f;
+
+        float DistanceTo(const Math::Vector3& point) const
+        {
+            return Math::Vector3::DotProduct(m_normal, point) + m_distance;
+        }
+    };
+
+    // View frustum defined by 6 planes pointing inwards.
+    class Frustum
+    {
+    public:
+        // Extracts the planes from a projection matrix (combined with view and world matrices).
+        // The planes are in the space the matrix transforms from, for example, extracting them
+        // from Projection * View * World gives the planes in object space.
+        static Frustum CreateFromMatrix(const Math::Matrix4x4& matrix);
+
+        // Returns false only if the sphere is completely outside the frustum.
+        bool IsSphereVisible(const Math::Vector3& center, float radius) const;
+
+        const std::array<Plane, 6>& GetPlanes() const { return m_planes; }
+
+    private:
+        std::array<Plane, 6> m_planes; // Left, Right, Bottom, Top, Near, Far
+    };
+
+    // Returns true if all the triangles of the meshlet face away from the view position.
+    // The view position must be in the same space as the meshlet (object space).
+    bool IsMeshletBackFacing(const Meshlet& meshlet, const Math::Vector3& viewPosition);
+
+    // CPU reference of per meshlet culling. Tests the meshlets against the frustum
+    // and their normal cones against the view position. Indices of the meshlets
+    // that are visible are added to visibleMeshlets.
+    void CullMeshlets(std::span<const Meshlet> meshlets,
+        const Math::Matrix4x4& worldMatrix,
+        const Math::Matrix4x4& viewProjMatrix,
+        const Math::Vector3& viewPosition,
+        std::vector<uint32_t>& visibleMeshlets);
+} // namespace DX
@@ -1,7 +1,11 @@
 #include <Renderer/Object.h>
 #include <Renderer/RendererManager.h>
+#include <Renderer/Renderer.h>
+#include <Renderer/TextureStreamer.h>
 #include <Assets/TextureAsset.h>
 #include <Assets/MeshAsset.h>
+#include <Assets/GltfLoader.h>
+#include <Assets/AssetManager.h>
 
 #include <RHI/Device/Device.h>
 #include <RHI/Resource/Buffer/Buffer.h>
@@ -14,26 +18,42 @@
 #include <mathfu/constants.h>
 
 #include <algorithm>
+#include <filesystem>
 
 namespace DX
 {
+    namespace Internal
+    {
+        TextureImportSettings NormalMapImportSettings()
+        {
+            TextureImportSettings normalMapSettings;
+            normalMapSettings.m_normalMap = true;
+            return normalMapSettings;
+        }
+    } // namespace Internal
+
     Object::Object() = default;
 
     Object::~Object() = default;
 
     std::shared_ptr<Vulkan::ImageView> Object::GetDiffuseImageView() const
     {
-        return m_diffuseImageView;
+        return m_diffuseTexture->GetImageView();
     }
 
     std::shared_ptr<Vulkan::ImageView> Object::GetEmissiveImageView() const
     {
-        return m_emissiveImageView;
+        return m_emissiveTexture ? m_emissiveTexture->GetImageView() : m_emissiveImageView;
     }
 
     std::shared_ptr<Vulkan::ImageView> Object::GetNormalImageView() const
     {
-        return m_normalImageView;
+        return m_normalTexture->GetImageView();
+    }
+
+    std::array<StreamedTexture*, 3> Object::GetStreamedTextures() const
+    {
+        return { m_diffuseTexture.get(), m_emissiveTexture.get(), m_normalTexture.get() };
     }
 
     std::shared_ptr<Vulkan::Sampler> Object::GetSampler() const
@@ -41,6 +61,29 @@ namespace DX
         return m_imageSampler;
     }
 
+    Math::Matrix4x4 Object::GetVertexPositionDecodeMatrix() const
+    {
+        if (m_vertexFormat != VertexFormat::Compact)
+        {
+            return Math::Matrix4x4::Identity();
+        }
+
+        // Normalized position [0,1] -> Bounds Min + Position * Bounds Extent
+        const Math::Vector3 min(m_bounds.m_min);
+        const Math::Vector3 extent = Math::Vector3(m_bounds.m_max) - min;
+        return Math::Transform(min, Math::Quaternion::identity, extent).ToMatrix();
+    }
+
+    Math::Vector3 Object::GetBoundingSphereCenter() const
+    {
+        return 0.5f * (Math::Vector3(m_bounds.m_min) + Math::Vector3(m_bounds.m_max));
+    }
+
+    float Object::GetBoundingSphereRadius() const
+    {
+        return 0.5f * (Math::Vector3(m_bounds.m_max) - Math::Vector3(m_bounds.m_min)).Length();
+    }
+
     std::shared_ptr<Vulkan::Buffer> Object::GetVertexBuffer() const
     {
         return m_vertexBuffer;
@@ -51,19 +94,140 @@ namespace DX
         return m_indexBuffer;
     }
 
-    void Object::CreateBuffers()
+    bool Object::BeginAssetReload(const std::string& fileName)
+    {
+        bool usesFile = false;
+
+        const auto reloadTexture = [this, &fileName, &usesFile](const std::string& textureFilename,
+            const std::shared_ptr<StreamedTexture>& texture, const TextureImportSettings& settings)
+        {
+            if (texture && textureFilename == fileName)
+            {
+                m_pendingTextureReloads.push_back({ texture, TextureAsset::ReloadTextureAssetAsync(fileName, settings) });
+                usesFile = true;
+            }
+        };
+
+        reloadTexture(m_diffuseFilename, m_diffuseTexture, {});
+        reloadTexture(m_emissiveFilename, m_emissiveTexture, {});
+        reloadTexture(m_normalFilename, m_normalTexture, Internal::NormalMapImportSettings());
+
+        return usesFile;
+    }
+
+    void Object::EndAssetReloads()
+    {
+        auto* renderer = RendererManager::Get().GetRenderer();
+        DX_ASSERT(renderer, "Object", "Default renderer not found");
+
+        std::erase_if(m_pendingTextureReloads, [renderer](const PendingTextureReload& pendingReload)
+            {
+                if (!pendingReload.m_textureAsset.IsReady())
+                {
+                    return false;
+                }
+
+                if (auto textureAsset = pendingReload.m_textureAsset.Get();
+                    !textureAsset)
+                {
+                    DX_LOG(Warning, "Object", "Failed to reload texture %s, keeping the previous one.",
+                        pendingReload.m_texture->GetTextureAsset()->GetAssetId().c_str());
+                }
+                else if (!renderer->GetTextureStreamer()->ReloadTexture(*pendingReload.m_texture, std::move(textureAsset)))
+                {
+                    DX_LOG(Error, "Object", "Failed to create reloaded texture %s, keeping the previous one.",
+                        pendingReload.m_texture->GetTextureAsset()->GetAssetId().c_str());
+                }
+                return true;
+            });
+    }
+
+    void Object::CreateBuffers(std::span<const VertexPNTBUv> vertexData, std::span<const Index> indexData,
+        std::span<const MeshLod> lods, std::span<const MeshSubmesh> submeshes, std::span<const MeshLod> submeshLods)
+    {
+        m_vertexFormat = VertexFormat::PNTBUv;
+        m_bounds = CalculateMeshBounds(vertexData);
+
+        CreateBuffers(vertexData.data(), static_cast<uint32_t>(vertexData.size()), indexData, lods, submeshes, submeshLods);
+    }
+
+    void Object::CreateBuffers(std::span<const VertexCompact> vertexData, std::span<const Index> indexData, const MeshBounds& bounds,
+        std::span<const MeshLod> lods, std::span<const MeshSubmesh> submeshes, std::span<const MeshLod> submeshLods)
+    {
+        m_vertexFormat = VertexFormat::Compact;
+        m_bounds = bounds;
+
+        CreateBuffers(vertexData.data(), static_cast<uint32_t>(vertexData.size()), indexData, lods, submeshes, submeshLods);
+    }
+
+    void Object::CreateBuffers(const void* vertexData, uint32_t vertexCount, std::span<const Index> indexData, std::span<const MeshLod> lods,
+        std::span<const MeshSubmesh> submeshes, std::span<const MeshLod> submeshLods)
     {
         auto* renderer = RendererManager::Get().GetRenderer();
         DX_ASSERT(renderer, "Object", "Default renderer not found");
 
+        m_indexCount = static_cast<uint32_t>(indexData.size());
+
+        if (lods.empty())
+        {
+            m_lods = { MeshLod{ 0, m_indexCount, 0.0f } };
+        }
+        else
+        {
+            m_lods.assign(lods.begin(), lods.end());
+        }
+
+        if (submeshes.empty())
+        {
+            MeshSubmesh submesh;
+            submesh.m_firstIndex = m_lods[0].m_firstIndex;
+            submesh.m_indexCount = m_lods[0].m_indexCount;
+            submesh.m_vertexCount = vertexCount;
+            submesh.m_bounds = m_bounds;
+            submesh.m_sphereCenter = GetBoundingSphereCenter();
+            submesh.m_sphereRadius = GetBoundingSphereRadius();
+            m_submeshes = { submesh };
+            m_submeshLods = m_lods;
+        }
+        else
+        {
+            m_submeshes.assign(submeshes.begin(), submeshes.end());
+            if (submeshLods.empty())
+            {
+                // Without levels of detail, the only level is the submeshes' indices.
+                m_submeshLods.clear();
+                for (const MeshSubmesh& submesh : m_submeshes)
+                {
+                    m_submeshLods.push_back(MeshLod{ submesh.m_firstIndex, submesh.m_indexCount, 0.0f });
+                }
+            }
+            else
+            {
+                m_submeshLods.assign(submeshLods.begin(), submeshLods.end());
+            }
+        }
+
+        DX_ASSERT(m_submeshLods.size() == m_lods.size() * m_submeshes.size(), "Object",
+            "Expected %zu submesh levels of detail, but got %zu", m_lods.size() * m_submeshes.size(), m_submeshLods.size());
+
         // Vertex Buffer
+        // Frames in flight could still be using the buffers being replaced.
+        if (m_vertexBuffer)
+        {
+            renderer->RetireResource(std::move(m_vertexBuffer));
+        }
+        if (m_indexBuffer)
+        {
+            renderer->RetireResource(std::move(m_indexBuffer));
+        }
+
         {
             Vulkan::BufferDesc vertexBufferDesc = {};
             vertexBufferDesc.m_elementSizeInBytes = GetVertexSize();
-            vertexBufferDesc.m_elementCount = static_cast<uint32_t>(m_vertexData.size());
+            vertexBufferDesc.m_elementCount = vertexCount;
             vertexBufferDesc.m_usageFlags = Vulkan::BufferUsage_VertexBuffer;
             vertexBufferDesc.m_memoryProperty = Vulkan::ResourceMemoryProperty::DeviceLocal;
-            vertexBufferDesc.m_initialData = m_vertexData.data();
+            vertexBufferDesc.m_initialData = vertexData;
 
             m_vertexBuffer = std::make_shared<Vulkan::Buffer>(renderer->GetDevice(), vertexBufferDesc);
             if (!m_vertexBuffer->Initialize())
@@ -74,13 +238,24 @@ namespace DX
         }
 
         // Index Buffer
+        // Objects with less than 65536 vertices use 16 bit indices, halving the index buffer.
         {
+            m_indexSize = CalculateIndexSize(vertexCount);
+
+            std::vector<Index16> indexData16;
+            if (m_indexSize == sizeof(Index16))
+            {
+                indexData16.assign(indexData.begin(), indexData.end());
+            }
+
             Vulkan::BufferDesc indexBufferDesc = {};
             indexBufferDesc.m_elementSizeInBytes = GetIndexSize();
-            indexBufferDesc.m_elementCount = static_cast<uint32_t>(m_indexData.size());
+            indexBufferDesc.m_elementCount = static_cast<uint32_t>(indexData.size());
             indexBufferDesc.m_usageFlags = Vulkan::BufferUsage_IndexBuffer;
             indexBufferDesc.m_memoryProperty = Vulkan::ResourceMemoryProperty::DeviceLocal;
-            indexBufferDesc.m_initialData = m_indexData.data();
+            indexBufferDesc.m_initialData = indexData16.empty()
+                ? static_cast<const void*>(indexData.data())
+                : static_cast<const void*>(indexData16.data());
 
             m_indexBuffer = std::make_shared<Vulkan::Buffer>(renderer->GetDevice(), indexBufferDesc);
             if (!m_indexBuffer->Initialize())
@@ -90,38 +265,30 @@ namespace DX
             }
         }
 
+        if (!m_diffuseTexture)
+        {
+            CreateTextures();
+        }
+    }
+
+    void Object::CreateTextures()
+    {
+        auto* renderer = RendererManager::Get().GetRenderer();
+        DX_ASSERT(renderer, "Object", "Default renderer not found");
+
+        // Textures start with only their smallest mips resident,
+        // the renderer streams in the rest when they are needed.
+        TextureStreamer* textureStreamer = renderer->GetTextureStreamer();
+
         // Diffuse Texture
         {
             auto textureAsset = TextureAsset::LoadTextureAsset(m_diffuseFilename);
             DX_ASSERT(textureAsset.get(), "Object", "Failed to load texture");
 
-            Vulkan::ImageDesc imageDesc = {};
-            imageDesc.m_imageType = Vulkan::ImageType::Image2D;
-            imageDesc.m_dimensions = Math::Vector3Int(textureAsset->GetData()->m_size, 1);
-            imageDesc.m_mipCount = 1;
-            imageDesc.m_format = Vulkan::ResourceFormat::R8G8B8A8_UNORM;
-            imageDesc.m_tiling = Vulkan::ImageTiling::Optimal;
-            imageDesc.m_usageFlags = Vulkan::ImageUsage_Sampled;
-            imageDesc.m_initialData = textureAsset->GetData()->m_data;
-
-            m_diffuseImage = std::make_shared<Vulkan::Image>(renderer->GetDevice(), imageDesc);
-            if (!m_diffuseImage->Initialize())
+            m_diffuseTexture = textureStreamer->CreateTexture(std::move(textureAsset));
+            if (!m_diffuseTexture)
             {
-                DX_LOG(Fatal, "Object", "Failed to create diffuse image.");
-                return;
-            }
-
-            Vulkan::ImageViewDesc imageViewDesc = {};
-            imageViewDesc.m_image = m_diffuseImage;
-            imageViewDesc.m_viewFormat = m_diffuseImage->GetImageDesc().m_format;
-            imageViewDesc.m_aspectFlags = Vulkan::ImageViewAspect_Color;
-            imageViewDesc.m_firstMip = 0;
-            imageViewDesc.m_mipCount = 0;
-
-            m_diffuseImageView = std::make_shared<Vulkan::ImageView>(renderer->GetDevice(), imageViewDesc);
-            if (!m_diffuseImageView->Initialize())
-            {
-                DX_LOG(Fatal, "Object", "Failed to create diffuse image view.");
+                DX_LOG(Fatal, "Object", "Failed to create diffuse texture.");
                 return;
             }
         }
@@ -147,76 +314,44 @@ namespace DX
                     DX_LOG(Fatal, "Object", "Failed to create mock emissive image.");
                     return;
                 }
+
+                Vulkan::ImageViewDesc imageViewDesc = {};
+                imageViewDesc.m_image = m_emissiveImage;
+                imageViewDesc.m_viewFormat = m_emissiveImage->GetImageDesc().m_format;
+                imageViewDesc.m_aspectFlags = Vulkan::ImageViewAspect_Color;
+                imageViewDesc.m_firstMip = 0;
+                imageViewDesc.m_mipCount = 0;
+
+                m_emissiveImageView = std::make_shared<Vulkan::ImageView>(renderer->GetDevice(), imageViewDesc);
+                if (!m_emissiveImageView->Initialize())
+                {
+                    DX_LOG(Fatal, "Object", "Failed to create mock emissive image view.");
+                    return;
+                }
             }
             else
             {
                 auto textureAsset = TextureAsset::LoadTextureAsset(m_emissiveFilename);
                 DX_ASSERT(textureAsset.get(), "Object", "Failed to load texture");
 
-                Vulkan::ImageDesc imageDesc = {};
-                imageDesc.m_imageType = Vulkan::ImageType::Image2D;
-                imageDesc.m_dimensions = Math::Vector3Int(textureAsset->GetData()->m_size, 1);
-                imageDesc.m_mipCount = 1;
-                imageDesc.m_format = Vulkan::ResourceFormat::R8G8B8A8_UNORM;
-                imageDesc.m_tiling = Vulkan::ImageTiling::Optimal;
-                imageDesc.m_usageFlags = Vulkan::ImageUsage_Sampled;
-                imageDesc.m_initialData = textureAsset->GetData()->m_data;
-
-                m_emissiveImage = std::make_shared<Vulkan::Image>(renderer->GetDevice(), imageDesc);
-                if (!m_emissiveImage->Initialize())
+                m_emissiveTexture = textureStreamer->CreateTexture(std::move(textureAsset));
+                if (!m_emissiveTexture)
                 {
-                    DX_LOG(Fatal, "Object", "Failed to create emissive image.");
+                    DX_LOG(Fatal, "Object", "Failed to create emissive texture.");
                     return;
                 }
             }
-
-            Vulkan::ImageViewDesc imageViewDesc = {};
-            imageViewDesc.m_image = m_emissiveImage;
-            imageViewDesc.m_viewFormat = m_emissiveImage->GetImageDesc().m_format;
-            imageViewDesc.m_aspectFlags = Vulkan::ImageViewAspect_Color;
-            imageViewDesc.m_firstMip = 0;
-            imageViewDesc.m_mipCount = 0;
-
-            m_emissiveImageView = std::make_shared<Vulkan::ImageView>(renderer->GetDevice(), imageViewDesc);
-            if (!m_emissiveImageView->Initialize())
-            {
-                DX_LOG(Fatal, "Object", "Failed to create emissive image view.");
-                return;
-            }
         }
 
         // Normal Texture
         {
-            auto textureAsset = TextureAsset::LoadTextureAsset(m_normalFilename);
+            auto textureAsset = TextureAsset::LoadTextureAsset(m_normalFilename, Internal::NormalMapImportSettings());
             DX_ASSERT(textureAsset.get(), "Object", "Failed to load texture");
 
-            Vulkan::ImageDesc imageDesc = {};
-            imageDesc.m_imageType = Vulkan::ImageType::Image2D;
-            imageDesc.m_dimensions = Math::Vector3Int(textureAsset->GetData()->m_size, 1);
-            imageDesc.m_mipCount = 1;
-            imageDesc.m_format = Vulkan::ResourceFormat::R8G8B8A8_UNORM;
-            imageDesc.m_tiling = Vulkan::ImageTiling::Optimal;
-            imageDesc.m_usageFlags = Vulkan::ImageUsage_Sampled;
-            imageDesc.m_initialData = textureAsset->GetData()->m_data;
-
-            m_normalImage = std::make_shared<Vulkan::Image>(renderer->GetDevice(), imageDesc);
-            if (!m_normalImage->Initialize())
-            {
-                DX_LOG(Fatal, "Object", "Failed to create normal image.");
-                return;
-            }
-
-            Vulkan::ImageViewDesc imageViewDesc = {};
-            imageViewDesc.m_image = m_normalImage;
-            imageViewDesc.m_viewFormat = m_normalImage->GetImageDesc().m_format;
-            imageViewDesc.m_aspectFlags = Vulkan::ImageViewAspect_Color;
-            imageViewDesc.m_firstMip = 0;
-            imageViewDesc.m_mipCount = 0;
-
-            m_normalImageView = std::make_shared<Vulkan::ImageView>(renderer->GetDevice(), imageViewDesc);
-            if (!m_normalImageView->Initialize())
+            m_normalTexture = textureStreamer->CreateTexture(std::move(textureAsset));
+            if (!m_normalTexture)
             {
-                DX_LOG(Fatal, "Object", "Failed to create normal image view.");
+                DX_LOG(Fatal, "Object", "Failed to create normal texture.");
                 return;
             }
         }
@@ -296,7 +431,7 @@ namespace DX
         };
         */
 
-        m_vertexData =
+        std::vector<VertexPNTBUv> vertexData =
         {
             // Front face
             { Math::Vector3Packed({-half.x, -half.y, -half.z}), Math::Vector3Packed(-mathfu::kAxisZ3f), Math::Vector3Packed(mathfu::kAxisX3f), Math::Vector3Packed(-mathfu::kAxisY3f), Math::Vector2Packed({0.0f, 0.0f}) },
@@ -336,13 +471,13 @@ namespace DX
         };
 
         // Flip UVs and calculate binormals
-        for (auto& vertex : m_vertexData)
+        for (auto& vertex : vertexData)
         {
             vertex.m_uv.y = -vertex.m_uv.y;
             vertex.m_binormal = Math::Vector3::CrossProduct(Math::Vector3(vertex.m_tangent), Math::Vector3(vertex.m_normal));
         }
 
-        m_indexData =
+        const std::vector<Index> indexData =
         {
             // Front face
             0, 1, 2,
@@ -369,44 +504,117 @@ namespace DX
             22, 21, 20
         };
 
-        CreateBuffers();
+        CreateBuffers(vertexData, indexData);
     }
 
     Mesh::Mesh(const Math::Transform& transform,
         const std::string& meshFilename,
         const std::string& diffuseFilename,
         const std::string& normalFilename,
-        const std::string& emissiveFilename)
+        const std::string& emissiveFilename,
+        const MeshImportSettings& importSettings,
+        bool keepMeshData)
     {
         m_transform = transform;
         m_diffuseFilename = diffuseFilename;
         m_normalFilename = normalFilename;
         m_emissiveFilename = emissiveFilename;
 
-        auto meshAsset = MeshAsset::LoadMeshAsset(meshFilename);
+        m_meshFilename = meshFilename;
+        m_importSettings = importSettings;
+        m_keepMeshData = keepMeshData;
+
+        auto meshAsset = MeshAsset::LoadMeshAsset(meshFilename, importSettings);
         if (!meshAsset)
         {
             DX_LOG(Fatal, "Mesh", "Failed to load mesh asset %s", meshFilename.c_str());
             return;
         }
 
+        UploadMeshAsset(std::move(meshAsset));
+    }
+
+    void Mesh::UploadMeshAsset(std::shared_ptr<MeshAsset> meshAsset)
+    {
+        // Mesh data is already interleaved, upload it directly from the asset.
         const MeshData* meshData = meshAsset->GetData();
 
-        m_vertexData.resize(meshData->m_positions.size());
-        for (uint32_t i = 0; i < meshData->m_positions.size(); ++i)
+        if (meshData->m_vertexFormat == VertexFormat::Compact)
         {
-            m_vertexData[i] = VertexPNTBUv
-            {
-                .m_position = meshData->m_positions[i],
-                .m_normal = meshData->m_normals[i],
-                .m_tangent = meshData->m_tangents[i],
-                .m_binormal = meshData->m_binormals[i],
-                .m_uv = meshData->m_textCoords[i]
-            };
+            CreateBuffers(meshData->m_compactVertices, meshData->m_indices, meshData->m_bounds, meshData->m_lods,
+                meshData->m_submeshes, meshData->m_submeshLods);
+        }
+        else
+        {
+            CreateBuffers(meshData->m_vertices, meshData->m_indices, meshData->m_lods,
+                meshData->m_submeshes, meshData->m_submeshLods);
+        }
+
+        [[maybe_unused]] const size_t meshDataSize = meshData->GetSizeInBytes();
+
+        if (m_keepMeshData)
+        {
+            m_meshAsset = std::move(meshAsset);
+        }
+        else
+        {
+            // Drop the reference to the mesh asset. The asset manager releases the
+            // CPU copy of the mesh data or caches it depending on its residency policy.
+            AssetManager::Get().NotifyAssetUploaded(m_meshFilename);
+            meshAsset.reset();
+        }
+
+        DX_LOG(Verbose, "Mesh", "Mesh %s uploaded %.1f KB of geometry to GPU, CPU copy %s. Mesh data resident in CPU: %.1f KB.",
+            m_meshFilename.c_str(),
+            meshDataSize / 1024.0f,
+            m_keepMeshData ? "kept" : "handed to asset manager",
+            MeshAsset::GetResidentDataSize() / 1024.0f);
+    }
+
+    const MeshData* Mesh::GetMeshData() const
+    {
+        return m_meshAsset ? m_meshAsset->GetData() : nullptr;
+    }
+
+    bool Mesh::BeginAssetReload(const std::string& fileName)
+    {
+        bool usesFile = Object::BeginAssetReload(fileName);
+
+        // The geometry of glTF files can live in external binary buffers with any name,
+        // the ones referenced by the file are read from it in case they changed too.
+        const std::filesystem::path meshPath(m_meshFilename);
+        const bool isMeshBuffer = fileName != m_meshFilename && IsGltfFile(meshPath) &&
+            std::ranges::any_of(GetGltfBufferPaths(meshPath), [&fileName](const std::filesystem::path& bufferPath)
+                {
+                    return bufferPath.lexically_normal().generic_string() == fileName;
+                });
+
+        if (fileName == m_meshFilename || isMeshBuffer)
+        {
+            m_pendingMeshReload = MeshAsset::ReloadMeshAssetAsync(m_meshFilename, m_importSettings);
+            usesFile = true;
         }
 
-        m_indexData = meshData->m_indices;
+        return usesFile;
+    }
+
+    void Mesh::EndAssetReloads()
+    {
+        Object::EndAssetReloads();
+
+        if (!m_pendingMeshReload.IsReady())
+        {
+            return;
+        }
+
+        auto meshAsset = m_pendingMeshReload.Get();
+        m_pendingMeshReload = {};
+        if (!meshAsset)
+        {
+            DX_LOG(Warning, "Mesh", "Failed to reload mesh %s, keeping the previous one.", m_meshFilename.c_str());
+            return;
+        }
 
-        CreateBuffers();
+        UploadMeshAsset(std::move(meshAsset));
     }
 } // namespace DX
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <Math/Transform.h>
-#include <Renderer/Vertices.h>
+#include <Assets/Vertices.h>
+#include <Assets/MeshAsset.h>
+#include <Assets/TextureAsset.h>
 
 #include <vector>
 #include <memory>
 #include <string>
+#include <span>
+#include <array>
 
 namespace Vulkan
 {
@@ -17,13 +21,39 @@ namespace Vulkan
 
 namespace DX
 {
+    class StreamedTexture;
+
     class Object
     {
     public:
         Object();
         virtual ~Object() = 0;
 
-        uint32_t GetIndexCount() const { return static_cast<uint32_t>(m_indexData.size()); }
+        uint32_t GetIndexCount() const { return m_indexCount; }
+
+        // Levels of detail of the index buffer, there is always at least one.
+        uint32_t GetLodCount() const { return static_cast<uint32_t>(m_lods.size()); }
+        const MeshLod& GetLod(uint32_t lodIndex) const { return m_lods[lodIndex]; }
+
+        // Parts of the object that can be culled and drawn independently, there is always at least one.
+        uint32_t GetSubmeshCount() const { return static_cast<uint32_t>(m_submeshes.size()); }
+        const MeshSubmesh& GetSubmesh(uint32_t submeshIndex) const { return m_submeshes[submeshIndex]; }
+
+        // Indices of a submesh in a level of detail.
+        const MeshLod& GetSubmeshLod(uint32_t lodIndex, uint32_t submeshIndex) const
+        {
+            return m_submeshLods[lodIndex * m_submeshes.size() + submeshIndex];
+        }
+
+        // Bounding sphere in object space.
+        Math::Vector3 GetBoundingSphereCenter() const;
+        float GetBoundingSphereRadius() const;
+
+        VertexFormat GetVertexFormat() const { return m_vertexFormat; }
+
+        // Transforms vertex positions from the vertex buffer to object space.
+        // It's identity unless the vertices are compact, whose positions are normalized to the mesh bounds.
+        Math::Matrix4x4 GetVertexPositionDecodeMatrix() const;
 
         Math::Transform& GetTransform() { return m_transform; }
         const Math::Transform& GetTransform() const { return m_transform; }
@@ -34,20 +64,36 @@ namespace DX
         std::shared_ptr<Vulkan::ImageView> GetNormalImageView() const;
         std::shared_ptr<Vulkan::Sampler> GetSampler() const;
 
+        // Textures whose mips are streamed depending on the object's size on screen.
+        // Elements are null for the textures the object doesn't have.
+        std::array<StreamedTexture*, 3> GetStreamedTextures() const;
+
         std::shared_ptr<Vulkan::Buffer> GetVertexBuffer() const;
         std::shared_ptr<Vulkan::Buffer> GetIndexBuffer() const;
 
-    protected:
-        void CreateBuffers();
+        // Starts importing again the assets of the object that come from a file that has been modified.
+        // The filename is relative to the assets folder. Returns true if the object uses the file.
+        virtual bool BeginAssetReload(const std::string& fileName);
 
-        uint32_t GetVertexSize() const { return sizeof(VertexPNTBUv); }
-        uint32_t GetIndexSize() const { return sizeof(Index); }
+        // Replaces the GPU resources of the assets that have finished importing again.
+        // To be called by the renderer at a frame boundary, before the resources are used for the frame.
+        virtual void EndAssetReloads();
 
-        Math::Transform m_transform = Math::Transform::CreateIdentity();
+    protected:
+        // Uploads the vertices and indices to GPU buffers and creates the textures.
+        // The geometry data is not kept by the object, subclasses decide its lifetime.
+        // When no levels of detail are passed, the whole index buffer is the only level.
+        // When no submeshes are passed, the whole object is the only submesh.
+        // Submesh levels of detail are laid out as in MeshData.
+        void CreateBuffers(std::span<const VertexPNTBUv> vertexData, std::span<const Index> indexData,
+            std::span<const MeshLod> lods = {}, std::span<const MeshSubmesh> submeshes = {}, std::span<const MeshLod> submeshLods = {});
+        void CreateBuffers(std::span<const VertexCompact> vertexData, std::span<const Index> indexData, const MeshBounds& bounds,
+            std::span<const MeshLod> lods = {}, std::span<const MeshSubmesh> submeshes = {}, std::span<const MeshLod> submeshLods = {});
+
+        uint32_t GetVertexSize() const { return (m_vertexFormat == VertexFormat::Compact) ? sizeof(VertexCompact) : sizeof(VertexPNTBUv); }
+        uint32_t GetIndexSize() const { return m_indexSize; }
 
-        // Filled by subclass
-        std::vector<VertexPNTBUv> m_vertexData;
-        std::vector<Index> m_indexData;
+        Math::Transform m_transform = Math::Transform::CreateIdentity();
 
         // Filled by subclass
         std::string m_diffuseFilename;
@@ -55,16 +101,38 @@ namespace DX
         std::string m_normalFilename;
 
     private:
+        // Creating the buffers again replaces the geometry, the previous buffers are retired
+        // to the renderer. Textures are only created the first time.
+        void CreateBuffers(const void* vertexData, uint32_t vertexCount, std::span<const Index> indexData, std::span<const MeshLod> lods,
+            std::span<const MeshSubmesh> submeshes, std::span<const MeshLod> submeshLods);
+        void CreateTextures();
+
+        uint32_t m_indexCount = 0;
+        uint32_t m_indexSize = sizeof(Index);
+        VertexFormat m_vertexFormat = VertexFormat::PNTBUv;
+        MeshBounds m_bounds = {};
+        std::vector<MeshLod> m_lods;
+        std::vector<MeshSubmesh> m_submeshes;
+        std::vector<MeshLod> m_submeshLods;
+
         std::shared_ptr<Vulkan::Buffer> m_vertexBuffer;
         std::shared_ptr<Vulkan::Buffer> m_indexBuffer;
 
-        std::shared_ptr<Vulkan::Image> m_diffuseImage;
+        std::shared_ptr<StreamedTexture> m_diffuseTexture;
+        std::shared_ptr<StreamedTexture> m_emissiveTexture;
+        std::shared_ptr<StreamedTexture> m_normalTexture;
+
+        // Used when there is no emissive texture.
         std::shared_ptr<Vulkan::Image> m_emissiveImage;
-        std::shared_ptr<Vulkan::Image> m_normalImage;
-        std::shared_ptr<Vulkan::ImageView> m_diffuseImageView;
         std::shared_ptr<Vulkan::ImageView> m_emissiveImageView;
-        std::shared_ptr<Vulkan::ImageView> m_normalImageView;
         std::shared_ptr<Vulkan::Sampler> m_imageSampler;
+
+        struct PendingTextureReload
+        {
+            std::shared_ptr<StreamedTexture> m_texture;
+            AssetLoadHandle<TextureAsset> m_textureAsset;
+        };
+        std::vector<PendingTextureReload> m_pendingTextureReloads;
     };
 
     class Cube : public Object
@@ -77,10 +145,32 @@ namespace DX
     class Mesh : public Object
     {
     public:
+        // By default the CPU copy of the mesh data is released after it's uploaded to GPU.
+        // Use keepMeshData to keep it alive and accessible through GetMeshData.
+        // Import settings are only used if the mesh asset is not loaded yet.
         Mesh(const Math::Transform& transform,
             const std::string& meshFilename,
             const std::string& diffuseFilename,
             const std::string& normalFilename,
-            const std::string& emissiveFilename = "");
+            const std::string& emissiveFilename = "",
+            const MeshImportSettings& importSettings = {},
+            bool keepMeshData = false);
+
+        // Returns null if the mesh was not created keeping its mesh data.
+        const MeshData* GetMeshData() const;
+
+        bool BeginAssetReload(const std::string& fileName) override;
+        void EndAssetReloads() override;
+
+    private:
+        // Uploads the mesh data to GPU buffers, replacing the current geometry if any.
+        void UploadMeshAsset(std::shared_ptr<MeshAsset> meshAsset);
+
+        std::string m_meshFilename;
+        MeshImportSettings m_importSettings;
+        bool m_keepMeshData = false;
+
+        std::shared_ptr<MeshAsset> m_meshAsset;
+        AssetLoadHandle<MeshAsset> m_pendingMeshReload;
     };
 } // namespace DX
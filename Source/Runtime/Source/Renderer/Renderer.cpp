@@ -1,6 +1,8 @@
 #include <Renderer/Renderer.h>
 
 #include <Renderer/Object.h>
+#include <Renderer/TextureStreamer.h>
+#include <Renderer/Culling.h>
 #include <RHI/Device/Instance.h>
 #include <RHI/Device/Device.h>
 #include <RHI/SwapChain/SwapChain.h>
@@ -14,6 +16,8 @@
 #include <RHI/FrameBuffer/FrameBuffer.h>
 
 #include <Camera/Camera.h>
+#include <File/FileUtils.h>
+#include <File/FileWatcher.h>
 
 #include <Log/Log.h>
 #include <Debug/Debug.h>
@@ -21,8 +25,51 @@
 // TODO: To be removed. Required for VkSemaphore, VkFence, VkCommandPool and VkFormatFeatureFlagBits used.
 #include <vulkan/vulkan.h>
 
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <filesystem>
+
 namespace DX
 {
+    namespace Internal
+    {
+        // Screen size (bounding sphere diameter relative to the screen height) below which
+        // the first simplified level of detail is used. Each following level halves it.
+        static constexpr float LodFirstScreenSize = 0.5f;
+        static constexpr float LodScreenSizeFactor = 0.5f;
+
+        // Fraction the screen size has to cross a threshold by before switching level,
+        // it avoids objects flickering between levels around a threshold.
+        static constexpr float LodHysteresis = 0.1f;
+
+        uint32_t SelectLodFromScreenSize(float screenSize, uint32_t lodCount, float thresholdScale)
+        {
+            uint32_t lod = 0;
+            float lodScreenSize = LodFirstScreenSize * thresholdScale;
+            while (lod + 1 < lodCount && screenSize < lodScreenSize)
+            {
+                ++lod;
+                lodScreenSize *= LodScreenSizeFactor;
+            }
+            return lod;
+        }
+
+        // Diameter of the object's bounding sphere projected on screen relative to the screen height.
+        float CalculateObjectScreenSize(const Object* object, const Math::Vector3& cameraPosition, float projectionScaleY)
+        {
+            const Math::Transform& transform = object->GetTransform();
+            const Math::Vector3 sphereCenter = transform.ToMatrix() * object->GetBoundingSphereCenter();
+            const float maxScale = std::max({ std::abs(transform.m_scale.x), std::abs(transform.m_scale.y), std::abs(transform.m_scale.z) });
+            const float sphereRadius = object->GetBoundingSphereRadius() * maxScale;
+
+            const float distance = (sphereCenter - cameraPosition).Length();
+            return (distance > sphereRadius)
+                ? sphereRadius * projectionScaleY / distance
+                : std::numeric_limits<float>::max();
+        }
+    } // namespace Internal
+
     Renderer::Renderer(RendererId rendererId, Window* window)
         : m_rendererId(rendererId)
         , m_window(window)
@@ -93,6 +140,19 @@ namespace DX
             return false;
         }
 
+        m_textureStreamer = std::make_unique<TextureStreamer>(m_device.get());
+
+        // Assets inside a mounted pack cannot be modified, so there is nothing to watch.
+        if (!GetMountedAssetPack())
+        {
+            m_assetWatcher = std::make_unique<FileWatcher>();
+            if (!m_assetWatcher->Start(GetAssetPath()))
+            {
+                DX_LOG(Warning, "Renderer", "Failed to watch assets folder, hot reload disabled.");
+                m_assetWatcher.reset();
+            }
+        }
+
         return true;
     }
 
@@ -103,6 +163,11 @@ namespace DX
 
         DX_LOG(Info, "Renderer", "Terminating Renderer...");
 
+        m_textureStreamer.reset();
+
+        m_assetWatcher.reset();
+        ReleaseRetiredResources(true);
+
         m_inputAttachmentsDescritorSets.clear();
         m_perObjectDescritorSets.clear();
         m_perSceneDescritorSets.clear();
@@ -128,6 +193,7 @@ namespace DX
         m_vkRenderFinishedSemaphores.clear();
         m_vkRenderFences.clear();
 
+        m_compactVertexPipeline.reset();
         m_pipelines.clear();
         m_frameBuffers.clear();
         m_renderPass.reset();
@@ -146,6 +212,11 @@ namespace DX
         return m_device.get();
     }
 
+    TextureStreamer* Renderer::GetTextureStreamer()
+    {
+        return m_textureStreamer.get();
+    }
+
     void Renderer::Render()
     {
         // TODO: Move this code into classes (SwapChain and CommandBuffer).
@@ -173,6 +244,11 @@ namespace DX
         // Reset (close) the fence, it means it's in use, then "vkQueueSubmit" later will mark it as open when finished.
         vkResetFences(m_device->GetVkDevice(), 1, &m_vkRenderFences[m_currentFrame]);
 
+        // At this frame boundary release the resources replaced that are no longer in use
+        // and swap the ones of the assets that have finished reloading.
+        ReleaseRetiredResources();
+        UpdateAssetReloads();
+
         // 1) Get next available image to draw to and pass a semaphore so the GPU will signal
         //    when the image is available.
         //
@@ -188,6 +264,7 @@ namespace DX
         }
 
         // 2) Update data and record the commands for the current frame
+        UpdateTextureStreaming();
         UpdateFrameData(m_frameBuffers[swapChainImageIndex].get());
         RecordCommands(m_frameBuffers[swapChainImageIndex].get());
 
@@ -245,6 +322,7 @@ namespace DX
 
         // Next frame
         m_currentFrame = (m_currentFrame + 1) % Vulkan::MaxFrameDraws;
+        ++m_frameCount;
     }
 
     void Renderer::WaitUntilIdle()
@@ -268,6 +346,139 @@ namespace DX
     void Renderer::RemoveObject(Object* object)
     {
         m_objects.erase(object);
+        m_objectLods.erase(object);
+    }
+
+    void Renderer::RetireResource(std::shared_ptr<void> resource)
+    {
+        m_retiredResources.push_back({ std::move(resource), m_frameCount });
+    }
+
+    void Renderer::UpdateAssetReloads()
+    {
+        if (m_assetWatcher)
+        {
+            for (const std::string& fileName : m_assetWatcher->PollChanges())
+            {
+                if (std::filesystem::path(fileName).extension() == ".spv")
+                {
+                    ReloadPipelines(fileName);
+                    continue;
+                }
+
+                bool usedByObjects = false;
+                for (auto* object : m_objects)
+                {
+                    usedByObjects |= object->BeginAssetReload(fileName);
+                }
+
+                if (usedByObjects)
+                {
+                    DX_LOG(Info, "Renderer", "Asset %s modified, reloading it.", fileName.c_str());
+                }
+            }
+        }
+
+        for (auto* object : m_objects)
+        {
+            object->EndAssetReloads();
+        }
+    }
+
+    void Renderer::ReloadPipelines(const std::string& shaderFilename)
+    {
+        for (Vulkan::Pipeline* pipeline : { m_pipelines[0].get(), m_pipelines[1].get(), m_compactVertexPipeline.get() })
+        {
+            if (!pipeline || !pipeline->UsesShader(shaderFilename))
+            {
+                continue;
+            }
+
+            if (VkPipeline retiredVkPipeline = nullptr;
+                pipeline->ReloadShaders(retiredVkPipeline))
+            {
+                m_retiredVkPipelines.push_back({ retiredVkPipeline, m_frameCount });
+
+                DX_LOG(Info, "Renderer", "Shader %s modified, pipeline for subpass %u reloaded.",
+                    shaderFilename.c_str(), pipeline->GetSubpassIndex());
+            }
+            else
+            {
+                DX_LOG(Error, "Renderer", "Failed to reload pipeline for subpass %u with shader %s, keeping the previous one.",
+                    pipeline->GetSubpassIndex(), shaderFilename.c_str());
+            }
+        }
+    }
+
+    void Renderer::ReleaseRetiredResources(bool deviceIdle)
+    {
+        const auto isUnused = [this, deviceIdle](uint64_t retiredFrame)
+        {
+            return deviceIdle || retiredFrame + Vulkan::MaxFrameDraws <= m_frameCount;
+        };
+
+        std::erase_if(m_retiredResources, [&isUnused](const RetiredResource& retiredResource)
+            {
+                return isUnused(retiredResource.m_frame);
+            });
+
+        std::erase_if(m_retiredVkPipelines, [this, &isUnused](const RetiredVkPipeline& retiredVkPipeline)
+            {
+                if (!isUnused(retiredVkPipeline.m_frame))
+                {
+                    return false;
+                }
+                vkDestroyPipeline(m_device->GetVkDevice(), retiredVkPipeline.m_vkPipeline, nullptr);
+                return true;
+            });
+    }
+
+    uint32_t Renderer::SelectObjectLod(const Object* object, const Math::Vector3& cameraPosition, float projectionScaleY)
+    {
+        const uint32_t lodCount = object->GetLodCount();
+        if (lodCount <= 1)
+        {
+            return 0;
+        }
+
+        const float screenSize = Internal::CalculateObjectScreenSize(object, cameraPosition, projectionScaleY);
+
+        // Only switch level when the screen size has gone beyond the threshold plus the hysteresis margin.
+        uint32_t& lod = m_objectLods[object];
+        const uint32_t coarserLod = Internal::SelectLodFromScreenSize(screenSize, lodCount, 1.0f - Internal::LodHysteresis);
+        const uint32_t finerLod = Internal::SelectLodFromScreenSize(screenSize, lodCount, 1.0f + Internal::LodHysteresis);
+        if (lod < coarserLod)
+        {
+            lod = coarserLod;
+        }
+        else if (lod > finerLod)
+        {
+            lod = finerLod;
+        }
+
+        return lod;
+    }
+
+    void Renderer::UpdateTextureStreaming()
+    {
+        const Math::Vector3 cameraPosition = m_camera->GetTransform().m_position;
+        const float projectionScaleY = std::abs(m_camera->GetProjectionMatrix()(1, 1));
+        const float screenHeight = static_cast<float>(m_swapChain->GetImageSize().y);
+
+        for (const auto* object : m_objects)
+        {
+            const float screenPixels = Internal::CalculateObjectScreenSize(object, cameraPosition, projectionScaleY) * screenHeight;
+
+            for (StreamedTexture* texture : object->GetStreamedTextures())
+            {
+                if (texture)
+                {
+                    m_textureStreamer->RequestScreenCoverage(texture, screenPixels);
+                }
+            }
+        }
+
+        m_textureStreamer->Update();
     }
 
     void Renderer::UpdateFrameData(Vulkan::FrameBuffer* frameBuffer)
@@ -329,7 +540,15 @@ namespace DX
 
             // Subpass 0
             {
-                commandBuffer->BindPipeline(m_pipelines[0].get());
+                const Math::Vector3 cameraPosition = m_camera->GetTransform().m_position;
+                const float projectionScaleY = std::abs(m_camera->GetProjectionMatrix()(1, 1));
+                const Math::Matrix4x4 viewProjMatrix = m_camera->GetProjectionMatrix() * m_camera->GetViewMatrix();
+
+                // Index ranges of the visible submeshes of an object, contiguous ranges are merged.
+                std::vector<MeshLod> visibleRanges;
+
+                Vulkan::Pipeline* boundPipeline = m_pipelines[0].get();
+                commandBuffer->BindPipeline(boundPipeline);
 
                 // Bind per scene pipeline descriptor set, which includes the ViewProj uniform buffer.
                 commandBuffer->BindPipelineDescriptorSet(m_perSceneDescritorSets[m_currentFrame].get());
@@ -337,23 +556,77 @@ namespace DX
                 for (uint32_t objectIndex = 0;
                     auto* object : m_objects)
                 {
+                    // Objects with compact vertices need the pipeline that decodes them.
+                    // Both pipelines have compatible layouts, so descriptor sets stay bound when switching.
+                    Vulkan::Pipeline* objectPipeline = (object->GetVertexFormat() == VertexFormat::Compact)
+                        ? m_compactVertexPipeline.get()
+                        : m_pipelines[0].get();
+                    if (!objectPipeline)
+                    {
+                        ++objectIndex;
+                        continue;
+                    }
+
+                    // Cull the submeshes in object space, so their bounds don't need to be transformed.
+                    // The level of detail appropriate for the object's size on screen is used for all of them.
+                    const Math::Matrix4x4 worldMatrix = object->GetTransform().ToMatrix();
+                    const Frustum frustum = Frustum::CreateFromMatrix(viewProjMatrix * worldMatrix);
+                    const uint32_t lodIndex = SelectObjectLod(object, cameraPosition, projectionScaleY);
+
+                    visibleRanges.clear();
+                    for (uint32_t submeshIndex = 0; submeshIndex < object->GetSubmeshCount(); ++submeshIndex)
+                    {
+                        const MeshSubmesh& submesh = object->GetSubmesh(submeshIndex);
+                        if (!frustum.IsSphereVisible(Math::Vector3(submesh.m_sphereCenter), submesh.m_sphereRadius))
+                        {
+                            continue;
+                        }
+
+                        const MeshLod& submeshLod = object->GetSubmeshLod(lodIndex, submeshIndex);
+                        if (!visibleRanges.empty() &&
+                            visibleRanges.back().m_firstIndex + visibleRanges.back().m_indexCount == submeshLod.m_firstIndex)
+                        {
+                            visibleRanges.back().m_indexCount += submeshLod.m_indexCount;
+                        }
+                        else
+                        {
+                            visibleRanges.push_back(submeshLod);
+                        }
+                    }
+
+                    if (visibleRanges.empty())
+                    {
+                        ++objectIndex;
+                        continue;
+                    }
+
+                    if (objectPipeline != boundPipeline)
+                    {
+                        boundPipeline = objectPipeline;
+                        commandBuffer->BindPipeline(boundPipeline);
+                    }
+
                     // Bind per object pipeline descriptor set, which includes the images and sampler.
                     commandBuffer->BindPipelineDescriptorSet(m_perObjectDescritorSets[m_currentFrame][objectIndex].get());
 
                     // Push per object World data to the pipeline.
+                    // The decoding of the vertex positions is folded into the world matrix, but
+                    // not into its inverse transpose since it doesn't apply to the normals.
                     const WorldBuffer worldBuffer = {
-                        .m_worldMatrix = object->GetTransform().ToMatrix(),
-                        .m_inverseTransposeWorldMatrix = object->GetTransform().ToMatrix().Inverse().Transpose()
+                        .m_worldMatrix = worldMatrix * object->GetVertexPositionDecodeMatrix(),
+                        .m_inverseTransposeWorldMatrix = worldMatrix.Inverse().Transpose()
                     };
                     commandBuffer->PushConstantsToPipeline(
-                        m_pipelines[0].get(), Vulkan::ShaderType_Vertex | Vulkan::ShaderType_Fragment, &worldBuffer, sizeof(worldBuffer));
+                        boundPipeline, Vulkan::ShaderType_Vertex | Vulkan::ShaderType_Fragment, &worldBuffer, sizeof(worldBuffer));
 
                     // Bind Vertex and Index Buffers
                     commandBuffer->BindVertexBuffers({ object->GetVertexBuffer().get() });
                     commandBuffer->BindIndexBuffer(object->GetIndexBuffer().get());
 
-                    // Draw
-                    commandBuffer->DrawIndexed(object->GetIndexCount());
+                    for (const MeshLod& visibleRange : visibleRanges)
+                    {
+                        commandBuffer->DrawIndexed(visibleRange.m_indexCount, visibleRange.m_firstIndex);
+                    }
 
                     ++objectIndex;
                 }
@@ -571,6 +844,16 @@ namespace DX
             return false;
         }
 
+        // Subpass 0 with compact vertices. It's not critical, objects
+        // with compact vertices will be skipped if it's not available.
+        m_compactVertexPipeline = std::make_unique<Vulkan::Pipeline>(m_device.get(), m_renderPass.get(), 0, viewport,
+            Vulkan::VertexInputLayout::Compact);
+        if (!m_compactVertexPipeline->Initialize())
+        {
+            DX_LOG(Warning, "Renderer", "Failed to create pipeline for compact vertices, objects using them won't be rendered.");
+            m_compactVertexPipeline.reset();
+        }
+
         return true;
     }
 
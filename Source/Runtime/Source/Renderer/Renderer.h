@@ -3,14 +3,18 @@
 #include <Window/Window.h>
 #include <GenericId/GenericId.h>
 
+#include <Math/Vector3.h>
 #include <Math/Matrix4x4.h>
 
 #include <vector>
+#include <string>
 #include <memory>
 #include <unordered_set>
+#include <unordered_map>
 
 typedef struct VkSemaphore_T* VkSemaphore;
 typedef struct VkFence_T* VkFence;
+typedef struct VkPipeline_T* VkPipeline;
 
 namespace Vulkan
 {
@@ -30,6 +34,8 @@ namespace DX
 {
     class Camera;
     class Object;
+    class TextureStreamer;
+    class FileWatcher;
 
     using RendererId = GenericId<struct RendererIdTag>;
 
@@ -50,6 +56,7 @@ namespace DX
 
         Window* GetWindow();
         Vulkan::Device* GetDevice();
+        TextureStreamer* GetTextureStreamer();
 
         void Render();
 
@@ -61,6 +68,10 @@ namespace DX
         void AddObject(Object* object);
         void RemoveObject(Object* object);
 
+        // Keeps a GPU resource alive until the frames in flight that could be using it have finished.
+        // To be used when a resource is replaced while rendering, instead of waiting for the device.
+        void RetireResource(std::shared_ptr<void> resource);
+
     private:
         void UpdateFrameData(Vulkan::FrameBuffer* frameBuffer);
         void RecordCommands(Vulkan::FrameBuffer* frameBuffer);
@@ -74,6 +85,19 @@ namespace DX
         // Scene objects
         std::unordered_set<Object*> m_objects;
 
+        // Level of detail used by each object in the last frame.
+        std::unordered_map<const Object*, uint32_t> m_objectLods;
+
+        // Selects the level of detail of the object from the size of its bounding sphere projected on screen.
+        // projectionScaleY is the element (1,1) of the projection matrix, cotangent of half the vertical field of view.
+        uint32_t SelectObjectLod(const Object* object, const Math::Vector3& cameraPosition, float projectionScaleY);
+
+        // Requests the texture mips needed by each object from its size on screen
+        // and updates the streaming, before the image views are used for the frame.
+        void UpdateTextureStreaming();
+
+        std::unique_ptr<TextureStreamer> m_textureStreamer;
+
         // Per Scene Resources
         struct ViewProjBuffer
         {
@@ -127,6 +151,43 @@ namespace DX
         Vulkan::ResourceFormat m_frameBufferDepthStencilFormat;
         std::vector<std::unique_ptr<Vulkan::FrameBuffer>> m_frameBuffers; // One per SwapChain image
         std::vector<std::unique_ptr<Vulkan::Pipeline>> m_pipelines; // 2 pipelines, one for each subpass
+        std::unique_ptr<Vulkan::Pipeline> m_compactVertexPipeline; // Subpass 0 pipeline for objects with compact vertices
+
+    private:
+        // ---------------------------
+        // Hot reload
+        //
+        // Assets modified while running are imported again in worker threads and their
+        // GPU resources are swapped at a frame boundary. The resources replaced are
+        // retired until the frames in flight using them have finished.
+
+        // Reimports the assets modified and swaps the ones finished. To be called at a frame boundary.
+        void UpdateAssetReloads();
+
+        // Recreates the pipelines that use the shader.
+        void ReloadPipelines(const std::string& shaderFilename);
+
+        // Releases the retired resources no longer used by frames in flight.
+        // When the device is idle all of them are released.
+        void ReleaseRetiredResources(bool deviceIdle = false);
+
+        std::unique_ptr<FileWatcher> m_assetWatcher;
+
+        uint64_t m_frameCount = 0;
+
+        struct RetiredResource
+        {
+            std::shared_ptr<void> m_resource;
+            uint64_t m_frame = 0;
+        };
+        std::vector<RetiredResource> m_retiredResources;
+
+        struct RetiredVkPipeline
+        {
+            VkPipeline m_vkPipeline = nullptr;
+            uint64_t m_frame = 0;
+        };
+        std::vector<RetiredVkPipeline> m_retiredVkPipelines;
 
     private:
         // ---------------------------
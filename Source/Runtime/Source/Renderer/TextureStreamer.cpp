@@ -0,0 +1,582 @@
+#include <Renderer/TextureStreamer.h>
+
+#include <Assets/TextureAsset.h>
+#include <Assets/TextureCompression.h>
+#include <Assets/TextureMipGenerator.h>
+#include <Assets/AssetManager.h>
+
+#include <RHI/Device/Device.h>
+#include <RHI/Device/StagingRing.h>
+#include <RHI/Resource/Buffer/Buffer.h>
+#include <RHI/Resource/Image/Image.h>
+#include <RHI/Resource/ImageView/ImageView.h>
+
+#include <Thread/ThreadPool.h>
+#include <Log/Log.h>
+#include <Debug/Debug.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <utility>
+
+namespace DX
+{
+    namespace Internal
+    {
+        // Mips with both dimensions up to this size are always resident.
+        static constexpr int MinResidentMipSize = 64;
+
+        // Limits to spread the work of streaming over several frames.
+        static constexpr uint32_t MaxPendingStreamingJobs = 4;
+        static constexpr uint32_t MaxStreamingUploadsPerFrame = 2;
+
+        // Level data from this size is written into the staging memory by several workers.
+        static constexpr size_t ParallelWriteMinBytes = 1024 * 1024;
+        static constexpr size_t ParallelCopyChunkBytes = 256 * 1024;
+
+        // Mips being read from the texture asset in a worker thread.
+        struct TextureStreamingJob
+        {
+            uint32_t m_firstMip = 0;
+            std::unique_ptr<Vulkan::Buffer> m_stagingBuffer; // Written by the worker before m_done
+            std::chrono::steady_clock::time_point m_startTime;
+            std::atomic<bool> m_done = false;
+        };
+
+        // Coarsest mip level of the texture, the first one fitting in MinResidentMipSize.
+        uint32_t CalculateMinResidentMip(const TextureData& textureData)
+        {
+            uint32_t minResidentMip = 0;
+            while (minResidentMip + 1 < textureData.m_mipCount)
+            {
+                const Math::Vector2Int mipSize = CalculateMipSize(textureData.m_size, minResidentMip);
+                if (std::max(mipSize.x, mipSize.y) <= MinResidentMipSize)
+                {
+                    break;
+                }
+                ++minResidentMip;
+            }
+            return minResidentMip;
+        }
+
+        Vulkan::ResourceFormat ToResourceFormat(TextureFormat format)
+        {
+            // UNORM formats because the shaders convert colors from gamma to linear space.
+            switch (format)
+            {
+            case TextureFormat::BC1: return Vulkan::ResourceFormat::BC1_RGB_UNORM_BLOCK;
+            case TextureFormat::BC3: return Vulkan::ResourceFormat::BC3_UNORM_BLOCK;
+            case TextureFormat::BC5: return Vulkan::ResourceFormat::BC5_UNORM_BLOCK;
+            case TextureFormat::BC7: return Vulkan::ResourceFormat::BC7_UNORM_BLOCK;
+            case TextureFormat::RGBA8:
+            default:
+                return Vulkan::ResourceFormat::R8G8B8A8_UNORM;
+            }
+        }
+    } // namespace Internal
+
+    StreamedTexture::StreamedTexture(std::shared_ptr<TextureAsset> textureAsset)
+        : m_textureAsset(std::move(textureAsset))
+    {
+    }
+
+    StreamedTexture::~StreamedTexture() = default;
+
+    uint32_t StreamedTexture::GetMipCount() const
+    {
+        return m_textureAsset->GetData()->m_mipCount;
+    }
+
+    TextureStreamer::TextureStreamer(Vulkan::Device* device, size_t budgetBytes)
+        : m_device(device)
+        , m_decompressBlockCompressed(!device->IsTextureCompressionBCSupported())
+        , m_budgetBytes(budgetBytes)
+    {
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        // Workers could still be writing into the staging buffers.
+        for (const auto& job : m_runningJobs)
+        {
+            while (!job->m_done.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The GPU could still be copying from the staging buffers.
+        if (!m_uploadingStagingBuffers.empty())
+        {
+            m_device->GetStagingRing()->WaitUntilIdle();
+        }
+    }
+
+    std::shared_ptr<StreamedTexture> TextureStreamer::CreateTexture(std::shared_ptr<TextureAsset> textureAsset)
+    {
+        DX_ASSERT(textureAsset && textureAsset->GetData(), "TextureStreamer", "Invalid texture asset");
+
+        for (const auto& weakTexture : m_textures)
+        {
+            if (auto texture = weakTexture.lock();
+                texture && texture->m_textureAsset == textureAsset)
+            {
+                return texture;
+            }
+        }
+
+        if (m_decompressBlockCompressed && IsBlockCompressed(textureAsset->GetData()->m_format))
+        {
+            DX_LOG(Warning, "TextureStreamer", "Device doesn't support block compressed textures, texture %s will be decompressed.",
+                textureAsset->GetAssetId().c_str());
+        }
+
+        auto texture = std::make_shared<StreamedTexture>(std::move(textureAsset));
+
+        // Start with the smallest mips only, the rest will be streamed in when needed.
+        const uint32_t minResidentMip = Internal::CalculateMinResidentMip(*texture->m_textureAsset->GetData());
+        texture->m_minResidentMip = minResidentMip;
+        texture->m_requestedMip = minResidentMip;
+
+        if (!CreateResidentImage(*texture, minResidentMip))
+        {
+            return nullptr;
+        }
+
+        m_residentBytes += texture->m_residentBytes;
+        m_textures.push_back(texture);
+
+        return texture;
+    }
+
+    bool TextureStreamer::ReloadTexture(StreamedTexture& texture, std::shared_ptr<TextureAsset> textureAsset)
+    {
+        DX_ASSERT(textureAsset && textureAsset->GetData(), "TextureStreamer", "Invalid texture asset");
+
+        // Textures are shared, other objects using it could have reloaded it already.
+        if (texture.m_textureAsset == textureAsset)
+        {
+            return true;
+        }
+
+        const uint32_t minResidentMip = Internal::CalculateMinResidentMip(*textureAsset->GetData());
+
+        auto previousTextureAsset = std::exchange(texture.m_textureAsset, std::move(textureAsset));
+        if (!CreateResidentImage(texture, minResidentMip))
+        {
+            texture.m_textureAsset = std::move(previousTextureAsset);
+            return false;
+        }
+
+        // The job keeps the previous asset alive until it finishes, its result is ignored.
+        // Its staging buffer is released once the worker is done with it.
+        texture.m_pendingJob.reset();
+        texture.m_minResidentMip = minResidentMip;
+        texture.m_requestedMip = minResidentMip;
+
+        return true;
+    }
+
+    void TextureStreamer::RequestScreenCoverage(StreamedTexture* texture, float screenPixels)
+    {
+        const uint32_t mip = std::min(
+            SelectMipFromScreenCoverage(texture->m_textureAsset->GetData()->m_size, screenPixels),
+            texture->m_minResidentMip);
+
+        if (texture->m_lastRequestedFrame != m_frame)
+        {
+            texture->m_lastRequestedFrame = m_frame;
+            texture->m_requestedMip = mip;
+        }
+        else
+        {
+            texture->m_requestedMip = std::min(texture->m_requestedMip, mip);
+        }
+    }
+
+    void TextureStreamer::Update()
+    {
+        // Release replaced images once no frame in flight can be using them.
+        std::erase_if(m_retiredImages, [this](const RetiredImage& retiredImage)
+            {
+                return retiredImage.m_frame + Vulkan::MaxFrameDraws <= m_frame;
+            });
+
+        // Release the staging buffers the GPU has finished copying from.
+        std::erase_if(m_uploadingStagingBuffers, [this](const UploadingStagingBuffer& uploadingStagingBuffer)
+            {
+                return m_device->GetStagingRing()->IsUploadFinished(uploadingStagingBuffer.m_upload);
+            });
+
+        // Release the jobs of the workers that have finished. The ones whose result is still
+        // needed are also referenced by their textures.
+        std::erase_if(m_runningJobs, [](const std::shared_ptr<Internal::TextureStreamingJob>& job)
+            {
+                return job->m_done.load(std::memory_order_acquire);
+            });
+
+        std::erase_if(m_textures, [](const std::weak_ptr<StreamedTexture>& weakTexture)
+            {
+                return weakTexture.expired();
+            });
+
+        std::vector<std::shared_ptr<StreamedTexture>> liveTextures;
+        std::vector<StreamedTexture*> textures;
+        liveTextures.reserve(m_textures.size());
+        textures.reserve(m_textures.size());
+        for (const auto& weakTexture : m_textures)
+        {
+            liveTextures.push_back(weakTexture.lock());
+            textures.push_back(liveTextures.back().get());
+        }
+
+        // Upload the mips the workers have finished reading.
+        uint32_t uploadCount = 0;
+        for (StreamedTexture* texture : textures)
+        {
+            if (uploadCount >= Internal::MaxStreamingUploadsPerFrame)
+            {
+                break;
+            }
+
+            if (texture->m_pendingJob &&
+                texture->m_pendingJob->m_done.load(std::memory_order_acquire))
+            {
+                const auto job = std::move(texture->m_pendingJob);
+                CreateResidentImage(*texture, job->m_firstMip, std::move(job->m_stagingBuffer), job->m_startTime);
+                ++uploadCount;
+            }
+        }
+
+        // Bytes that will be resident once pending jobs are uploaded,
+        // more than now for the jobs streaming mips in and less for the ones evicting them.
+        size_t committedBytes = 0;
+        uint32_t pendingJobCount = 0;
+        for (const StreamedTexture* texture : textures)
+        {
+            if (texture->m_pendingJob)
+            {
+                committedBytes += CalculateResidentBytes(*texture, texture->m_pendingJob->m_firstMip);
+                ++pendingJobCount;
+            }
+            else
+            {
+                committedBytes += texture->m_residentBytes;
+            }
+        }
+
+        // The budget could have been reduced.
+        EvictToFitBudget(textures, committedBytes, 0);
+
+        // Stream the mips requested this frame, starting by the textures missing more mips.
+        std::vector<StreamedTexture*> requests;
+        std::ranges::copy_if(textures, std::back_inserter(requests), [this](const StreamedTexture* texture)
+            {
+                return texture->m_lastRequestedFrame == m_frame &&
+                    texture->m_requestedMip < texture->m_residentMip &&
+                    !texture->m_pendingJob;
+            });
+        std::ranges::sort(requests, [](const StreamedTexture* lhs, const StreamedTexture* rhs)
+            {
+                return (lhs->m_residentMip - lhs->m_requestedMip) > (rhs->m_residentMip - rhs->m_requestedMip);
+            });
+
+        for (StreamedTexture* texture : requests)
+        {
+            if (pendingJobCount >= Internal::MaxPendingStreamingJobs)
+            {
+                break;
+            }
+
+            uint32_t firstMip = texture->m_requestedMip;
+
+            const size_t extraBytes = CalculateResidentBytes(*texture, firstMip) - texture->m_residentBytes;
+            if (committedBytes + extraBytes > m_budgetBytes)
+            {
+                EvictToFitBudget(textures, committedBytes, extraBytes);
+            }
+
+            // Stream only the mips that fit in the budget.
+            while (firstMip < texture->m_residentMip &&
+                committedBytes + CalculateResidentBytes(*texture, firstMip) - texture->m_residentBytes > m_budgetBytes)
+            {
+                ++firstMip;
+            }
+            if (firstMip == texture->m_residentMip)
+            {
+                continue;
+            }
+
+            if (!StartStreamingJob(*texture, firstMip))
+            {
+                continue;
+            }
+
+            committedBytes += CalculateResidentBytes(*texture, firstMip) - texture->m_residentBytes;
+            ++pendingJobCount;
+        }
+
+        m_residentBytes = 0;
+        for (const StreamedTexture* texture : textures)
+        {
+            m_residentBytes += texture->m_residentBytes;
+        }
+
+        ++m_frame;
+    }
+
+    bool TextureStreamer::CreateResidentImage(StreamedTexture& texture, uint32_t firstMip)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        auto stagingBuffer = CreateStagingBuffer(CalculateResidentBytes(texture, firstMip));
+        if (!stagingBuffer)
+        {
+            return false;
+        }
+
+        const std::span<uint8_t> stagingData(static_cast<uint8_t*>(stagingBuffer->GetMappedData()),
+            stagingBuffer->GetBufferDesc().m_elementSizeInBytes);
+
+        WriteLevelData(*texture.m_textureAsset, firstMip, m_decompressBlockCompressed, stagingData,
+            &AssetManager::Get().GetThreadPool());
+
+        return CreateResidentImage(texture, firstMip, std::move(stagingBuffer), startTime);
+    }
+
+    bool TextureStreamer::CreateResidentImage(StreamedTexture& texture, uint32_t firstMip, std::unique_ptr<Vulkan::Buffer> stagingBuffer,
+        std::chrono::steady_clock::time_point startTime)
+    {
+        const TextureData& textureData = *texture.m_textureAsset->GetData();
+        const bool decompress = m_decompressBlockCompressed && IsBlockCompressed(textureData.m_format);
+
+        Vulkan::ImageDesc imageDesc = {};
+        imageDesc.m_imageType = Vulkan::ImageType::Image2D;
+        imageDesc.m_dimensions = Math::Vector3Int(CalculateMipSize(textureData.m_size, firstMip), 1);
+        imageDesc.m_mipCount = textureData.m_mipCount - firstMip;
+        imageDesc.m_format = decompress ? Vulkan::ResourceFormat::R8G8B8A8_UNORM : Internal::ToResourceFormat(textureData.m_format);
+        imageDesc.m_tiling = Vulkan::ImageTiling::Optimal;
+        imageDesc.m_usageFlags = Vulkan::ImageUsage_Sampled;
+        imageDesc.m_initialDataBuffer = stagingBuffer.get();
+
+        // CPU memory used by the upload. The level data is decoded straight into
+        // the staging buffer, so there is no other intermediate memory.
+        [[maybe_unused]] const size_t stagingBytes = stagingBuffer->GetBufferDesc().m_elementSizeInBytes;
+        [[maybe_unused]] const size_t levelDataBytes = textureData.m_levelData.size() - textureData.m_mips[firstMip].m_offset;
+
+        auto image = std::make_shared<Vulkan::Image>(m_device, imageDesc);
+        const bool imageInitialized = image->Initialize();
+
+        // The upload is not waited for, the staging buffer is released once the GPU has copied from it.
+        m_uploadingStagingBuffers.push_back({ std::move(stagingBuffer), m_device->GetStagingRing()->GetLastUpload() });
+
+        if (!imageInitialized)
+        {
+            DX_LOG(Error, "TextureStreamer", "Failed to create image for texture %s.", texture.m_textureAsset->GetAssetId().c_str());
+            return false;
+        }
+
+        Vulkan::ImageViewDesc imageViewDesc = {};
+        imageViewDesc.m_image = image;
+        imageViewDesc.m_viewFormat = imageDesc.m_format;
+        imageViewDesc.m_aspectFlags = Vulkan::ImageViewAspect_Color;
+        imageViewDesc.m_firstMip = 0;
+        imageViewDesc.m_mipCount = 0;
+
+        auto imageView = std::make_shared<Vulkan::ImageView>(m_device, imageViewDesc);
+        if (!imageView->Initialize())
+        {
+            DX_LOG(Error, "TextureStreamer", "Failed to create image view for texture %s.", texture.m_textureAsset->GetAssetId().c_str());
+            // The GPU could still be copying into the image.
+            m_retiredImages.push_back({ nullptr, std::move(image), m_frame });
+            return false;
+        }
+
+        if (texture.m_imageView)
+        {
+            m_retiredImages.push_back({ std::move(texture.m_imageView), std::move(texture.m_image), m_frame });
+        }
+
+        [[maybe_unused]] const float uploadTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        DX_LOG(Verbose, "TextureStreamer", "Texture %s resident from mip %u to %u (%dx%d) in %.2f ms, staging %.2f MB, level data read %.2f MB.",
+            texture.m_textureAsset->GetAssetId().c_str(), firstMip, textureData.m_mipCount - 1,
+            imageDesc.m_dimensions.x, imageDesc.m_dimensions.y, uploadTimeMs,
+            stagingBytes / (1024.0f * 1024.0f), levelDataBytes / (1024.0f * 1024.0f));
+
+        texture.m_image = std::move(image);
+        texture.m_imageView = std::move(imageView);
+        texture.m_residentMip = firstMip;
+        texture.m_residentBytes = CalculateResidentBytes(texture, firstMip);
+
+        return true;
+    }
+
+    bool TextureStreamer::StartStreamingJob(StreamedTexture& texture, uint32_t firstMip)
+    {
+        // The staging buffer is reserved here, as buffers are created on the render
+        // thread, and the worker writes the level data directly into its mapped memory.
+        auto job = std::make_shared<Internal::TextureStreamingJob>();
+        job->m_firstMip = firstMip;
+        job->m_startTime = std::chrono::steady_clock::now();
+        job->m_stagingBuffer = CreateStagingBuffer(CalculateResidentBytes(texture, firstMip));
+        if (!job->m_stagingBuffer)
+        {
+            return false;
+        }
+
+        texture.m_pendingJob = job;
+        m_runningJobs.push_back(job);
+
+        // The worker keeps the texture asset alive, so it's safe if the texture is destroyed meanwhile.
+        // It only references the job, which is owned by m_runningJobs until it's done, so
+        // the job and its staging buffer are always destroyed on the render thread.
+        ThreadPool* threadPool = &AssetManager::Get().GetThreadPool();
+        threadPool->Submit(
+            [job = job.get(), textureAsset = texture.m_textureAsset, decompress = m_decompressBlockCompressed, threadPool]()
+            {
+                Vulkan::Buffer* stagingBuffer = job->m_stagingBuffer.get();
+                const std::span<uint8_t> stagingData(static_cast<uint8_t*>(stagingBuffer->GetMappedData()),
+                    stagingBuffer->GetBufferDesc().m_elementSizeInBytes);
+
+                WriteLevelData(*textureAsset, job->m_firstMip, decompress, stagingData, threadPool);
+                job->m_done.store(true, std::memory_order_release);
+            });
+
+        return true;
+    }
+
+    std::unique_ptr<Vulkan::Buffer> TextureStreamer::CreateStagingBuffer(size_t sizeInBytes)
+    {
+        Vulkan::BufferDesc stagingBufferDesc = {};
+        stagingBufferDesc.m_elementSizeInBytes = static_cast<uint32_t>(sizeInBytes);
+        stagingBufferDesc.m_elementCount = 1;
+        stagingBufferDesc.m_usageFlags = Vulkan::BufferUsage_TransferSrc;
+        stagingBufferDesc.m_memoryProperty = Vulkan::ResourceMemoryProperty::HostVisible;
+        stagingBufferDesc.m_persistentlyMapped = true;
+
+        auto stagingBuffer = std::make_unique<Vulkan::Buffer>(m_device, stagingBufferDesc);
+        if (!stagingBuffer->Initialize())
+        {
+            DX_LOG(Error, "TextureStreamer", "Failed to create staging buffer of %zu bytes.", sizeInBytes);
+            return nullptr;
+        }
+
+        return stagingBuffer;
+    }
+
+    void TextureStreamer::WriteLevelData(const TextureAsset& textureAsset, uint32_t firstMip, bool decompress,
+        std::span<uint8_t> stagingData, ThreadPool* threadPool)
+    {
+        const TextureData& textureData = *textureAsset.GetData();
+
+        // Mips are tightly packed, so the ones from firstMip to the last are
+        // a mip chain of their own. When the level data is mapped from the cooked
+        // texture this is where it's actually read from disk.
+        const std::span<const uint8_t> levelData = textureData.m_levelData.subspan(textureData.m_mips[firstMip].m_offset);
+
+        if (stagingData.size() < Internal::ParallelWriteMinBytes)
+        {
+            threadPool = nullptr;
+        }
+
+        if (decompress && IsBlockCompressed(textureData.m_format))
+        {
+            DecompressTexture(levelData, CalculateMipSize(textureData.m_size, firstMip),
+                textureData.m_mipCount - firstMip, textureData.m_format, stagingData, threadPool);
+            return;
+        }
+
+        DX_ASSERT(stagingData.size() >= levelData.size(), "TextureStreamer",
+            "Staging memory (%zu bytes) is too small for the level data (%zu bytes)", stagingData.size(), levelData.size());
+
+        if (!threadPool)
+        {
+            std::memcpy(stagingData.data(), levelData.data(), levelData.size());
+            return;
+        }
+
+        // Copying in chunks from several workers also pages in the mapped level data in parallel.
+        const uint32_t chunkCount = static_cast<uint32_t>(
+            (levelData.size() + Internal::ParallelCopyChunkBytes - 1) / Internal::ParallelCopyChunkBytes);
+        threadPool->ParallelFor(chunkCount, [&](uint32_t chunkIndex)
+            {
+                const size_t offset = static_cast<size_t>(chunkIndex) * Internal::ParallelCopyChunkBytes;
+                const size_t size = std::min(Internal::ParallelCopyChunkBytes, levelData.size() - offset);
+                std::memcpy(stagingData.data() + offset, levelData.data() + offset, size);
+            });
+    }
+
+    size_t TextureStreamer::CalculateResidentBytes(const StreamedTexture& texture, uint32_t firstMip) const
+    {
+        const TextureData& textureData = *texture.m_textureAsset->GetData();
+        const TextureFormat format = (m_decompressBlockCompressed && IsBlockCompressed(textureData.m_format))
+            ? TextureFormat::RGBA8
+            : textureData.m_format;
+
+        return CalculateTextureMipChainSize(format, CalculateMipSize(textureData.m_size, firstMip), textureData.m_mipCount - firstMip);
+    }
+
+    uint32_t TextureStreamer::SelectMipFromScreenCoverage(const Math::Vector2Int& textureSize, float screenPixels)
+    {
+        // Assumes the texture is mapped once across the object, each mip
+        // level is needed when the object covers half the pixels of the previous one.
+        const float texels = static_cast<float>(std::max(textureSize.x, textureSize.y));
+        if (screenPixels >= texels)
+        {
+            return 0;
+        }
+        if (screenPixels <= 1.0f)
+        {
+            return std::numeric_limits<uint32_t>::max();
+        }
+        return static_cast<uint32_t>(std::log2(texels / screenPixels));
+    }
+
+    void TextureStreamer::EvictToFitBudget(const std::vector<StreamedTexture*>& textures, size_t& committedBytes, size_t extraBytes)
+    {
+        if (committedBytes + extraBytes <= m_budgetBytes)
+        {
+            return;
+        }
+
+        // Textures with mips resident finer than needed, least recently used first.
+        // Textures not used this frame only need their smallest mips.
+        const auto neededMip = [this](const StreamedTexture* texture)
+        {
+            return (texture->m_lastRequestedFrame == m_frame) ? texture->m_requestedMip : texture->m_minResidentMip;
+        };
+
+        std::vector<StreamedTexture*> candidates;
+        std::ranges::copy_if(textures, std::back_inserter(candidates), [&neededMip](const StreamedTexture* texture)
+            {
+                return !texture->m_pendingJob && texture->m_residentMip < neededMip(texture);
+            });
+        std::ranges::sort(candidates, [](const StreamedTexture* lhs, const StreamedTexture* rhs)
+            {
+                return lhs->m_lastRequestedFrame < rhs->m_lastRequestedFrame;
+            });
+
+        for (StreamedTexture* texture : candidates)
+        {
+            if (committedBytes + extraBytes <= m_budgetBytes)
+            {
+                break;
+            }
+
+            // The evicted mips stop counting against the budget now,
+            // their memory is released once the remaining mips are uploaded.
+            const uint32_t firstMip = neededMip(texture);
+            if (StartStreamingJob(*texture, firstMip))
+            {
+                committedBytes -= texture->m_residentBytes - CalculateResidentBytes(*texture, firstMip);
+            }
+        }
+    }
+} // namespace DX
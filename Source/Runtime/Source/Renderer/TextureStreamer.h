@@ -0,0 +1,192 @@
+#pragma once
+
+#include <Math/Vector2.h>
+
+#include <vector>
+#include <memory>
+#include <span>
+#include <chrono>
+
+namespace Vulkan
+{
+    class Device;
+    class Buffer;
+    class Image;
+    class ImageView;
+}
+
+namespace DX
+{
+    class TextureAsset;
+    class ThreadPool;
+
+    namespace Internal
+    {
+        struct TextureStreamingJob;
+    }
+
+    // Texture whose mip levels are streamed in and out of GPU memory
+    // depending on how big the objects using it are on screen.
+    //
+    // The GPU image only contains the resident mips, from the resident mip
+    // down to the last one. Every time the residency changes a new image
+    // and view replace the current ones, the view must be queried every frame.
+    class StreamedTexture
+    {
+    public:
+        explicit StreamedTexture(std::shared_ptr<TextureAsset> textureAsset);
+        ~StreamedTexture();
+
+        StreamedTexture(const StreamedTexture&) = delete;
+        StreamedTexture& operator=(const StreamedTexture&) = delete;
+
+        const std::shared_ptr<Vulkan::ImageView>& GetImageView() const { return m_imageView; }
+
+        const std::shared_ptr<TextureAsset>& GetTextureAsset() const { return m_textureAsset; }
+
+        uint32_t GetMipCount() const;
+
+        // Finest mip level that is resident in GPU memory.
+        uint32_t GetResidentMip() const { return m_residentMip; }
+
+        // GPU memory used by the resident mips.
+        size_t GetResidentBytes() const { return m_residentBytes; }
+
+    private:
+        friend class TextureStreamer;
+
+        std::shared_ptr<TextureAsset> m_textureAsset;
+
+        std::shared_ptr<Vulkan::Image> m_image;
+        std::shared_ptr<Vulkan::ImageView> m_imageView;
+        uint32_t m_residentMip = 0;
+        size_t m_residentBytes = 0;
+
+        // Coarsest mip level, it's always resident.
+        uint32_t m_minResidentMip = 0;
+
+        // Finest mip level requested by the objects using the texture in the last frame it was used.
+        uint32_t m_requestedMip = 0;
+        uint64_t m_lastRequestedFrame = 0;
+
+        // Mips being prepared in a worker thread.
+        std::shared_ptr<Internal::TextureStreamingJob> m_pendingJob;
+    };
+
+    // Streams texture mips based on screen coverage within a GPU memory budget.
+    //
+    // Textures start with only their smallest mips resident. Every frame the renderer
+    // requests the mips needed by each object from its size on screen, the data of the
+    // missing mips is read from the texture asset in the asset manager's worker threads
+    // and uploaded to a new image on the render thread when ready.
+    //
+    // Workers write the mips straight into a persistently mapped staging buffer reserved
+    // for the upload, so there are no intermediate copies in CPU memory. Large mip chains
+    // are copied or decompressed by several workers in parallel.
+    //
+    // When there is not enough budget for the requested mips, the mips not needed by the
+    // textures least recently used are evicted first. Unneeded mips of textures still
+    // used are only evicted when there is no other option.
+    class TextureStreamer
+    {
+    public:
+        static constexpr size_t DefaultBudgetBytes = 256 * 1024 * 1024;
+
+        TextureStreamer(Vulkan::Device* device, size_t budgetBytes = DefaultBudgetBytes);
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // Returns the streamed texture for the asset, with only its smallest mips resident
+        // if it's new. Textures are shared by everyone using the same asset.
+        // Returns null if its image couldn't be created.
+        std::shared_ptr<StreamedTexture> CreateTexture(std::shared_ptr<TextureAsset> textureAsset);
+
+        // Replaces the texture's asset with a reloaded one. Mips being streamed from the previous
+        // asset are discarded and the texture starts again with only its smallest mips resident.
+        // Returns false if the image couldn't be created, in which case the texture is left unchanged.
+        bool ReloadTexture(StreamedTexture& texture, std::shared_ptr<TextureAsset> textureAsset);
+
+        // Requests the mips needed to display the texture covering screenPixels pixels on screen.
+        // To be called every frame for each object using the texture, the finest request is used.
+        void RequestScreenCoverage(StreamedTexture* texture, float screenPixels);
+
+        // Uploads the mips streamed in by the workers, evicts mips to stay within budget and
+        // starts streaming the mips requested this frame. To be called once per frame, after
+        // all the requests and before the textures' image views are used for the frame.
+        void Update();
+
+        void SetBudget(size_t budgetBytes) { m_budgetBytes = budgetBytes; }
+        size_t GetBudget() const { return m_budgetBytes; }
+
+        // GPU memory used by the resident mips of all textures in the last update.
+        size_t GetResidentBytes() const { return m_residentBytes; }
+
+    private:
+        // Replaces the texture's image with a new one with the mips from firstMip to the last.
+        // The staging buffer must contain the level data from firstMip in the format uploaded to the GPU,
+        // it's kept until the GPU has finished copying from it, the upload is not waited for.
+        // The start time is when the level data started to be written, used to report the upload time.
+        bool CreateResidentImage(StreamedTexture& texture, uint32_t firstMip, std::unique_ptr<Vulkan::Buffer> stagingBuffer,
+            std::chrono::steady_clock::time_point startTime);
+
+        // Same as above but writes the level data into a new staging buffer right away.
+        bool CreateResidentImage(StreamedTexture& texture, uint32_t firstMip);
+
+        // Reserves a staging buffer for the mips from firstMip to the last and starts writing their
+        // level data in a worker thread. They are uploaded in the first update after it finishes.
+        bool StartStreamingJob(StreamedTexture& texture, uint32_t firstMip);
+
+        // Persistently mapped buffer for the level data of an upload. Returns null if it fails.
+        std::unique_ptr<Vulkan::Buffer> CreateStagingBuffer(size_t sizeInBytes);
+
+        // Writes the level data from firstMip in the format uploaded to the GPU into the staging memory.
+        // Block compressed textures are decompressed when the device doesn't support them.
+        // When a thread pool is provided large mip chains are written in parallel.
+        static void WriteLevelData(const TextureAsset& textureAsset, uint32_t firstMip, bool decompress,
+            std::span<uint8_t> stagingData, ThreadPool* threadPool);
+
+        // GPU memory needed by the texture with the mips from firstMip to the last.
+        size_t CalculateResidentBytes(const StreamedTexture& texture, uint32_t firstMip) const;
+
+        // Mip level needed to display a texture covering screenPixels pixels on screen.
+        static uint32_t SelectMipFromScreenCoverage(const Math::Vector2Int& textureSize, float screenPixels);
+
+        // Evicts unneeded mips in least recently used order until the
+        // resident bytes plus the extra bytes fit in the budget.
+        // The remaining mips are streamed like any other, so the memory is released once they are uploaded.
+        void EvictToFitBudget(const std::vector<StreamedTexture*>& textures, size_t& committedBytes, size_t extraBytes);
+
+        Vulkan::Device* m_device = nullptr;
+        bool m_decompressBlockCompressed = false;
+
+        size_t m_budgetBytes = 0;
+        size_t m_residentBytes = 0;
+
+        uint64_t m_frame = 1;
+
+        std::vector<std::weak_ptr<StreamedTexture>> m_textures;
+
+        // Jobs whose workers haven't finished yet. Workers don't own their jobs, they are kept alive
+        // here while the workers write into their staging buffers, which must be destroyed on the render thread.
+        std::vector<std::shared_ptr<Internal::TextureStreamingJob>> m_runningJobs;
+
+        // Images replaced while they could still be in use by frames in flight.
+        struct RetiredImage
+        {
+            std::shared_ptr<Vulkan::ImageView> m_imageView;
+            std::shared_ptr<Vulkan::Image> m_image;
+            uint64_t m_frame = 0;
+        };
+        std::vector<RetiredImage> m_retiredImages;
+
+        // Staging buffers of the uploads the GPU could still be copying from.
+        struct UploadingStagingBuffer
+        {
+            std::unique_ptr<Vulkan::Buffer> m_stagingBuffer;
+            uint64_t m_upload = 0;
+        };
+        std::vector<UploadingStagingBuffer> m_uploadingStagingBuffers;
+    };
+} // namespace DX